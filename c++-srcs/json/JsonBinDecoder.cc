@@ -0,0 +1,168 @@
+
+/// @file JsonBinDecoder.cc
+/// @brief JsonBinDecoder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "JsonBinDecoder.h"
+#include "JsonBinEncoder.h"
+#include "JsonObj.h"
+#include "JsonDocument.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+// 要素数から先に確保する領域の上限
+//
+// 壊れた入力で巨大な領域を確保しないようにする．
+const SizeType MAX_RESERVE = 1024 * 1024;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonBinDecoder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+JsonBinDecoder::JsonBinDecoder(
+  BinDec& s
+) : mS{s}
+{
+}
+
+// @brief デストラクタ
+JsonBinDecoder::~JsonBinDecoder()
+{
+  if ( mDoc != nullptr ) {
+    mDoc->dec_ref();
+  }
+}
+
+// @brief シグネチャと値を読み込む．
+JsonValue
+JsonBinDecoder::read()
+{
+  if ( !mS.read_signature(JSON_BIN_SIGNATURE) ) {
+    error("signature mismatch");
+  }
+  // ノードはすべて mDoc のアリーナ上に確保する．
+  mDoc = new JsonDocument;
+  mDoc->inc_ref();
+  auto value = read_value();
+  auto ans = JsonDocument::own(value);
+  mDoc->dec_ref();
+  mDoc = nullptr;
+  mKeyList.clear();
+  return ans;
+}
+
+// @brief 値を読み込む．
+JsonValue
+JsonBinDecoder::read_value()
+{
+  auto tag = static_cast<JsonBinTag>(mS.read_8());
+  switch ( tag ) {
+  case JsonBinTag::Null:
+    return JsonValue::null();
+
+  case JsonBinTag::False:
+    return JsonValue{false};
+
+  case JsonBinTag::True:
+    return JsonValue{true};
+
+  case JsonBinTag::Int:
+    {
+      std::uint64_t u = mS.read_vint();
+      auto v = static_cast<std::int64_t>(u >> 1) ^
+	-static_cast<std::int64_t>(u & 1);
+      return JsonValue{v};
+    }
+
+  case JsonBinTag::Float:
+    return JsonValue{mS.read_double()};
+
+  case JsonBinTag::String:
+    read_raw_string();
+    return mDoc->new_value<JsonString>(mBuff, mDoc->resource());
+
+  case JsonBinTag::Array:
+    {
+      auto n = mS.read_vint();
+      JsonArray::ArrayType array{mDoc->resource()};
+      array.reserve(std::min(n, MAX_RESERVE));
+      for ( SizeType i = 0; i < n; ++ i ) {
+	array.push_back(read_value());
+      }
+      return mDoc->new_value<JsonArray>(std::move(array));
+    }
+
+  case JsonBinTag::Object:
+    {
+      auto n = mS.read_vint();
+      JsonDict::ItemListType item_list{mDoc->resource()};
+      item_list.reserve(std::min(n, MAX_RESERVE));
+      for ( SizeType i = 0; i < n; ++ i ) {
+	auto key = read_key();
+	auto value = read_value();
+	item_list.emplace_back(key, std::move(value));
+      }
+      // キーはすべて intern() で登録されている．
+      return mDoc->new_value<JsonDict>(std::move(item_list), true);
+    }
+  }
+  std::ostringstream buf;
+  buf << static_cast<int>(tag) << ": unknown tag";
+  error(buf.str());
+}
+
+// @brief オブジェクトのキーを読み込む．
+std::string_view
+JsonBinDecoder::read_key()
+{
+  auto id = mS.read_vint();
+  if ( id == 0 ) {
+    read_raw_string();
+    auto key = mDoc->intern(mBuff);
+    mKeyList.push_back(key);
+    return key;
+  }
+  if ( id > mKeyList.size() ) {
+    std::ostringstream buf;
+    buf << id << ": undefined key id";
+    error(buf.str());
+  }
+  return mKeyList[id - 1];
+}
+
+// @brief 長さと本体を mBuff に読み込む．
+void
+JsonBinDecoder::read_raw_string()
+{
+  auto n = mS.read_vint();
+  // 壊れた入力で巨大な領域を確保しないように少しずつ読み込む．
+  mBuff.clear();
+  while ( mBuff.size() < n ) {
+    auto pos = mBuff.size();
+    auto size = std::min(n - pos, MAX_RESERVE);
+    mBuff.resize(pos + size);
+    mS.read_block(reinterpret_cast<std::uint8_t*>(mBuff.data() + pos), size);
+  }
+}
+
+// @brief エラーを出力する．
+void
+JsonBinDecoder::error(
+  const std::string& msg
+)
+{
+  std::ostringstream buf;
+  buf << "invalid JSON binary data: " << msg;
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NAMESPACE_YM_JSON
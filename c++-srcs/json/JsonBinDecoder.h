@@ -0,0 +1,100 @@
+#ifndef JSONBINDECODER_H
+#define JSONBINDECODER_H
+
+/// @file JsonBinDecoder.h
+/// @brief JsonBinDecoder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include "ym/BinDec.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+class JsonDocument;
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonBinDecoder JsonBinDecoder.h "JsonBinDecoder.h"
+/// @brief JsonBinEncoder で出力した内容を読み込むクラス
+///
+/// ノードは JsonParser と同様に一つの JsonDocument 上に作る．
+/// オブジェクトのキーは JsonDocument::intern() で登録する．
+//////////////////////////////////////////////////////////////////////
+class JsonBinDecoder
+{
+public:
+
+  /// @brief コンストラクタ
+  JsonBinDecoder(
+    BinDec& s ///< [in] 入力元
+  );
+
+  /// @brief デストラクタ
+  ~JsonBinDecoder();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief シグネチャと値を読み込む．
+  ///
+  /// 形式が正しくない場合は std::invalid_argument 例外を送出する．
+  JsonValue
+  read();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値を読み込む．
+  JsonValue
+  read_value();
+
+  /// @brief オブジェクトのキーを読み込む．
+  std::string_view
+  read_key();
+
+  /// @brief 長さと本体を mBuff に読み込む．
+  void
+  read_raw_string();
+
+  /// @brief エラーを出力する．
+  [[noreturn]]
+  void
+  error(
+    const std::string& msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力元
+  BinDec& mS;
+
+  // 読み込み中のドキュメント
+  //
+  // 読み込み中はこのオブジェクトが参照回数を一つ持つ．
+  JsonDocument* mDoc{nullptr};
+
+  // 読み込んだキーのリスト
+  std::vector<std::string_view> mKeyList;
+
+  // 文字列の読み込み用のバッファ
+  std::string mBuff;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONBINDECODER_H
@@ -0,0 +1,87 @@
+
+/// @file JsonBinEncoder.cc
+/// @brief JsonBinEncoder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "JsonBinEncoder.h"
+#include "JsonObj.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+// @brief バイナリ形式の先頭のシグネチャ
+const char* JSON_BIN_SIGNATURE = "ym_json_bin1";
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonBinEncoder
+//////////////////////////////////////////////////////////////////////
+
+// @brief シグネチャと値を出力する．
+void
+JsonBinEncoder::write(
+  const JsonValue& value
+)
+{
+  mS.write_signature(JSON_BIN_SIGNATURE);
+  write_value(value);
+}
+
+// @brief 値を出力する．
+void
+JsonBinEncoder::write_value(
+  const JsonValue& value
+)
+{
+  switch ( value.mType ) {
+  case JsonValue::Type::Null:
+    write_tag(JsonBinTag::Null);
+    break;
+
+  case JsonValue::Type::Bool:
+    write_tag(value.mBody.mBool ? JsonBinTag::True : JsonBinTag::False);
+    break;
+
+  case JsonValue::Type::Int:
+    {
+      // 絶対値の小さい負数も短くなるように zigzag 符号化する．
+      auto v = value.mBody.mInt;
+      auto u = (static_cast<std::uint64_t>(v) << 1) ^
+	static_cast<std::uint64_t>(v >> 63);
+      write_tag(JsonBinTag::Int);
+      mS.write_vint(u);
+    }
+    break;
+
+  case JsonValue::Type::Float:
+    write_tag(JsonBinTag::Float);
+    mS.write_double(value.mBody.mFloat);
+    break;
+
+  default:
+    value.mBody.mObj->dump(*this);
+    break;
+  }
+}
+
+// @brief オブジェクトのキーを出力する．
+void
+JsonBinEncoder::write_key(
+  std::string_view key
+)
+{
+  auto p = mKeyDict.find(key);
+  if ( p != mKeyDict.end() ) {
+    mS.write_vint(p->second);
+    return;
+  }
+  auto id = mKeyDict.size() + 1;
+  mKeyDict.emplace(key, id);
+  mS.write_vint(0);
+  write_raw_string(key);
+}
+
+END_NAMESPACE_YM_JSON
@@ -0,0 +1,163 @@
+#ifndef JSONBINENCODER_H
+#define JSONBINENCODER_H
+
+/// @file JsonBinEncoder.h
+/// @brief JsonBinEncoder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include "ym/BinEnc.h"
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+/// @brief バイナリ形式の先頭のシグネチャ
+extern
+const char* JSON_BIN_SIGNATURE;
+
+/// @brief バイナリ形式の値の種類を表すタグ
+enum class JsonBinTag : std::uint8_t {
+  Null,   ///< null
+  False,  ///< false
+  True,   ///< true
+  Int,    ///< 整数: zigzag 符号化した可変長整数が続く
+  Float,  ///< 浮動小数点数: 8バイトの double が続く
+  String, ///< 文字列: 可変長整数の長さと本体が続く
+  Array,  ///< 配列: 可変長整数の要素数と要素が続く
+  Object  ///< オブジェクト: 可変長整数の要素数とキーと値の対が続く
+};
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonBinEncoder JsonBinEncoder.h "JsonBinEncoder.h"
+/// @brief JsonValue をバイナリ形式で出力するクラス
+///
+/// 形式は JSON_BIN_SIGNATURE の後に値が一つ続く．
+/// 値は JsonBinTag の後に種類ごとの内容が続く．
+///
+/// オブジェクトのキーは全体で一つの辞書を共有する．
+/// キーは可変長整数の番号で表し，0 の時は新しいキーとして
+/// 長さと本体が続き，出現順に 1 から番号が振られる．
+/// それ以外の時は既出のキーの番号を表す．
+//////////////////////////////////////////////////////////////////////
+class JsonBinEncoder
+{
+public:
+
+  /// @brief コンストラクタ
+  JsonBinEncoder(
+    BinEnc& s ///< [in] 出力先
+  ) : mS{s}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~JsonBinEncoder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief シグネチャと値を出力する．
+  void
+  write(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief 値を出力する．
+  void
+  write_value(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief 文字列を出力する．
+  void
+  write_string(
+    std::string_view str ///< [in] 文字列
+  )
+  {
+    write_tag(JsonBinTag::String);
+    write_raw_string(str);
+  }
+
+  /// @brief 配列の開始を出力する．
+  ///
+  /// この後に n 個の要素を write_value() で出力する．
+  void
+  array_begin(
+    SizeType n ///< [in] 要素数
+  )
+  {
+    write_tag(JsonBinTag::Array);
+    mS.write_vint(n);
+  }
+
+  /// @brief オブジェクトの開始を出力する．
+  ///
+  /// この後に n 個の要素を write_key() と write_value() で出力する．
+  void
+  object_begin(
+    SizeType n ///< [in] 要素数
+  )
+  {
+    write_tag(JsonBinTag::Object);
+    mS.write_vint(n);
+  }
+
+  /// @brief オブジェクトのキーを出力する．
+  ///
+  /// key の内容は出力が終わるまで有効でなければならない．
+  void
+  write_key(
+    std::string_view key ///< [in] キー
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief タグを出力する．
+  void
+  write_tag(
+    JsonBinTag tag ///< [in] タグ
+  )
+  {
+    mS.write_8(static_cast<std::uint8_t>(tag));
+  }
+
+  /// @brief 長さと本体を出力する．
+  void
+  write_raw_string(
+    std::string_view str ///< [in] 文字列
+  )
+  {
+    mS.write_vint(str.size());
+    mS.write_block(reinterpret_cast<const std::uint8_t*>(str.data()),
+		   str.size());
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先
+  BinEnc& mS;
+
+  // 出力済みのキーの番号の辞書
+  std::unordered_map<std::string_view, SizeType> mKeyDict;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONBINENCODER_H
@@ -0,0 +1,159 @@
+
+/// @file JsonDedup.cc
+/// @brief JsonDedup の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonDedup.h"
+#include "JsonObj.h"
+#include "JsonDocument.h"
+#include <algorithm>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonDedup
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+JsonDedup::JsonDedup(
+) : mDoc{new JsonDocument}
+{
+  mDoc->inc_ref();
+}
+
+// @brief デストラクタ
+JsonDedup::~JsonDedup()
+{
+  mDoc->dec_ref();
+}
+
+// @brief 値を登録する．
+JsonValue
+JsonDedup::add(
+  const JsonValue& value
+)
+{
+  return JsonDocument::own(copy(value));
+}
+
+// @brief 値をアリーナ上にコピーする．
+JsonValue
+JsonDedup::copy(
+  const JsonValue& value
+)
+{
+  if ( !value._is_obj() ) {
+    return value;
+  }
+  auto obj = value.mBody.mObj->resolve();
+  if ( obj->doc() == mDoc ) {
+    // 既にこのオブジェクトで作られたもの
+    return JsonDocument::borrow(const_cast<JsonObj*>(obj));
+  }
+
+  // 子供を先にコピーしてから同じ内容のノードを探す．
+  // 見つからなかった場合のみアリーナ上に新しいノードを作る．
+  if ( obj->is_string() ) {
+    auto str = reinterpret_cast<const JsonString*>(obj)->str();
+    auto h = JsonString::calc_hash(str);
+    auto range = mTable.equal_range(h);
+    for ( auto p = range.first; p != range.second; ++ p ) {
+      auto cand = p->second;
+      if ( cand->is_string() &&
+	   reinterpret_cast<const JsonString*>(cand)->str() == str ) {
+	return JsonDocument::borrow(cand);
+      }
+    }
+    auto new_obj = mDoc->new_obj<JsonString>(str, mDoc->resource());
+    mTable.emplace(h, new_obj);
+    return JsonDocument::borrow(new_obj);
+  }
+
+  if ( obj->is_array() ) {
+    auto& src = reinterpret_cast<const JsonArray*>(obj)->elements();
+    std::vector<JsonValue> array;
+    array.reserve(src.size());
+    for ( auto& elem: src ) {
+      array.push_back(copy(elem));
+    }
+    auto h = JsonArray::calc_hash(array.data(), array.size());
+    auto range = mTable.equal_range(h);
+    for ( auto p = range.first; p != range.second; ++ p ) {
+      auto cand = p->second;
+      if ( !cand->is_array() ) {
+	continue;
+      }
+      auto& cand_array = reinterpret_cast<const JsonArray*>(cand)->elements();
+      if ( std::equal(array.begin(), array.end(),
+		      cand_array.begin(), cand_array.end(), is_same) ) {
+	return JsonDocument::borrow(cand);
+      }
+    }
+    JsonArray::ArrayType body{array.begin(), array.end(), mDoc->resource()};
+    auto new_obj = mDoc->new_obj<JsonArray>(std::move(body));
+    mTable.emplace(h, new_obj);
+    return JsonDocument::borrow(new_obj);
+  }
+
+  ASSERT_COND( obj->is_object() );
+  auto& src = reinterpret_cast<const JsonDict*>(obj)->items();
+  std::vector<JsonDict::ItemType> item_list;
+  item_list.reserve(src.size());
+  for ( auto& p: src ) {
+    auto key = mDoc->intern(p.first);
+    item_list.emplace_back(key, copy(p.second));
+  }
+  auto h = JsonDict::calc_hash(item_list.data(), item_list.size());
+  auto range = mTable.equal_range(h);
+  // キーは intern() で登録されているのでポインタで比較できる．
+  auto same_item = [](const JsonDict::ItemType& left,
+		      const JsonDict::ItemType& right) {
+    return left.first.data() == right.first.data() &&
+      is_same(left.second, right.second);
+  };
+  for ( auto p = range.first; p != range.second; ++ p ) {
+    auto cand = p->second;
+    if ( !cand->is_object() ) {
+      continue;
+    }
+    auto& cand_list = reinterpret_cast<const JsonDict*>(cand)->items();
+    if ( std::equal(item_list.begin(), item_list.end(),
+		    cand_list.begin(), cand_list.end(), same_item) ) {
+      return JsonDocument::borrow(cand);
+    }
+  }
+  JsonDict::ItemListType body{item_list.begin(), item_list.end(),
+			      mDoc->resource()};
+  auto new_obj = mDoc->new_obj<JsonDict>(std::move(body), true);
+  mTable.emplace(h, new_obj);
+  return JsonDocument::borrow(new_obj);
+}
+
+// @brief 二つの子供が同一かどうか調べる．
+bool
+JsonDedup::is_same(
+  const JsonValue& left,
+  const JsonValue& right
+)
+{
+  if ( left.mType != right.mType ) {
+    return false;
+  }
+  if ( left._is_obj() ) {
+    return left.mBody.mObj == right.mBody.mObj;
+  }
+  if ( left.is_float() ) {
+    // 0.0 と -0.0 は出力が異なるので区別する．
+    auto v1 = left.mBody.mFloat;
+    auto v2 = right.mBody.mFloat;
+    return v1 == v2 && std::signbit(v1) == std::signbit(v2);
+  }
+  return left == right;
+}
+
+END_NAMESPACE_YM_JSON
@@ -0,0 +1,286 @@
+#ifndef JSONDOCUMENT_H
+#define JSONDOCUMENT_H
+
+/// @file JsonDocument.h
+/// @brief JsonDocument のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include "JsonObj.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_set>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonDocument JsonDocument.h "JsonDocument.h"
+/// @brief パーサーが生成する JsonObj の木をまとめて保持するクラス
+///
+/// ノードと内部のコンテナ領域はすべて単一のアリーナ
+/// (std::pmr::monotonic_buffer_resource)から確保する．
+/// ノードのデストラクタは起動せず，JsonDocument の破棄時に
+/// アリーナごと解放する．
+///
+/// アリーナ内のノードが保持する子供の JsonValue は所有権を持たない
+/// (参照カウントを操作しない)．
+/// アリーナ内のノードを指す JsonValue の参照回数は
+/// すべて JsonDocument の参照回数として数えるので，
+/// どれか一つでも残っている限りアリーナは解放されない．
+/// 参照回数が 0 になった時点で自身を削除する．
+///
+/// 複数のスレッドで読み込んだ場合は部分木ごとの JsonDocument を
+/// add_sub() で保持する．
+///
+/// intern() で登録したオブジェクトのキーは同じ内容のものが
+/// 一つの領域を共有するので，ポインタの比較で等価判定ができる．
+/// キーの表は構築中にのみ変更されるので排他制御は行わない．
+///
+/// 遅延モード(JsonLazy を用いる場合)では入力の内容も保持する．
+/// 遅延ノードの展開はアリーナの確保を伴うので mutex() で排他制御を行う．
+//////////////////////////////////////////////////////////////////////
+class JsonDocument
+{
+public:
+
+  /// @brief コンストラクタ
+  JsonDocument() = default;
+
+  /// @brief デストラクタ
+  ~JsonDocument()
+  {
+    for ( auto sub: mSubList ) {
+      sub->dec_ref();
+    }
+  }
+
+  JsonDocument(const JsonDocument&) = delete;
+  JsonDocument& operator=(const JsonDocument&) = delete;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力としてファイルを設定する．
+  void
+  set_source(
+    std::unique_ptr<MappedFile>&& file ///< [in] マップしたファイル
+  )
+  {
+    mFile = std::move(file);
+    mSource = mFile->view();
+  }
+
+  /// @brief 入力として文字列を設定する．
+  ///
+  /// 内容はコピーされる．
+  void
+  set_source(
+    std::string_view buff ///< [in] 入力バッファ
+  )
+  {
+    mBuff = buff;
+    mSource = mBuff;
+  }
+
+  /// @brief 入力の内容を返す．
+  std::string_view
+  source() const
+  {
+    return mSource;
+  }
+
+  /// @brief アリーナの排他制御用の mutex を返す．
+  std::mutex&
+  mutex()
+  {
+    return mMutex;
+  }
+
+  /// @brief メモリリソースを返す．
+  std::pmr::memory_resource*
+  resource()
+  {
+    return &mArena;
+  }
+
+  /// @brief アリーナ上にノードを生成する．
+  template<class T, class... Args>
+  T*
+  new_obj(
+    Args&&... args ///< [in] T のコンストラクタの引数
+  )
+  {
+    auto p = mArena.allocate(sizeof(T), alignof(T));
+    auto obj = new (p) T{std::forward<Args>(args)...};
+    obj->mDoc = this;
+    return obj;
+  }
+
+  /// @brief アリーナ上にノードを生成する．
+  /// @return 生成したノードを指す所有権を持たない JsonValue を返す．
+  template<class T, class... Args>
+  JsonValue
+  new_value(
+    Args&&... args ///< [in] T のコンストラクタの引数
+  )
+  {
+    return borrow(new_obj<T>(std::forward<Args>(args)...));
+  }
+
+  /// @brief アリーナ上のノードを指す所有権を持たない JsonValue を作る．
+  static
+  JsonValue
+  borrow(
+    JsonObj* obj ///< [in] ノード
+  )
+  {
+    return JsonValue::_from_obj(obj, true);
+  }
+
+  /// @brief 文字列をアリーナ上にコピーする．
+  std::string_view
+  copy_string(
+    std::string_view str ///< [in] 文字列
+  )
+  {
+    auto size = std::max<SizeType>(str.size(), 1);
+    auto p = static_cast<char*>(mArena.allocate(size, 1));
+    std::copy(str.begin(), str.end(), p);
+    return std::string_view{p, str.size()};
+  }
+
+  /// @brief オブジェクトのキーを登録する．
+  /// @return 登録されたキーを返す．
+  ///
+  /// 同じ内容のキーが既に登録されていればそれを返す．
+  std::string_view
+  intern(
+    std::string_view key ///< [in] キー
+  )
+  {
+    auto p = mKeyTable.find(key);
+    if ( p != mKeyTable.end() ) {
+      return *p;
+    }
+    auto str = copy_string(key);
+    mKeyTable.insert(str);
+    return str;
+  }
+
+  /// @brief 登録されたキーを探す．
+  /// @return 登録されたキーの先頭を返す．
+  ///
+  /// 登録されていない場合は nullptr を返す．
+  const char*
+  find_key(
+    std::string_view key ///< [in] キー
+  ) const
+  {
+    auto p = mKeyTable.find(key);
+    if ( p == mKeyTable.end() ) {
+      return nullptr;
+    }
+    return p->data();
+  }
+
+  /// @brief 排他制御を行ってアリーナから領域を確保する．
+  ///
+  /// 構築後に遅延して確保される領域(JsonDict の索引など)に用いる．
+  /// 構築後は複数のスレッドから参照される可能性がある．
+  void*
+  allocate_sync(
+    SizeType size, ///< [in] サイズ
+    SizeType align ///< [in] アラインメント
+  )
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    return mArena.allocate(size, align);
+  }
+
+  /// @brief 部分ドキュメントを追加する．
+  ///
+  /// 並列に読み込んだ部分木は別の JsonDocument 上に作られる．
+  /// sub は自身が破棄されるまで解放されない．
+  void
+  add_sub(
+    JsonDocument* sub ///< [in] 部分ドキュメント
+  )
+  {
+    sub->inc_ref();
+    mSubList.push_back(sub);
+  }
+
+  /// @brief 所有権を持つ形にして返す．
+  static
+  JsonValue
+  own(
+    const JsonValue& value ///< [in] 値
+  )
+  {
+    return value._own();
+  }
+
+  /// @brief 参照回数を増やす．
+  void
+  inc_ref()
+  {
+    mRefCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief 参照回数を減らす．
+  ///
+  /// 0 になったら自身を削除する．
+  void
+  dec_ref()
+  {
+    if ( mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1 ) {
+      delete this;
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 参照回数
+  std::atomic<SizeType> mRefCount{0};
+
+  // アリーナ
+  std::pmr::monotonic_buffer_resource mArena;
+
+  // intern() で登録されたキーの表
+  std::pmr::unordered_set<std::string_view> mKeyTable{&mArena};
+
+  // 部分ドキュメントのリスト
+  std::vector<JsonDocument*> mSubList;
+
+  // allocate_sync() と遅延ノードの展開用の排他制御
+  std::mutex mMutex;
+
+  // 遅延モードの入力ファイル
+  std::unique_ptr<MappedFile> mFile;
+
+  // 遅延モードの入力バッファ
+  std::string mBuff;
+
+  // 遅延モードの入力
+  std::string_view mSource;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONDOCUMENT_H
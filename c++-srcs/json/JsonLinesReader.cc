@@ -0,0 +1,320 @@
+
+/// @file JsonLinesReader.cc
+/// @brief JsonLinesReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonLinesReader.h"
+#include "JsonParser.h"
+#include "JsonDocument.h"
+#include "JsonSimd.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include <condition_variable>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+// ブロックの大きさの目安
+const SizeType CHUNK_SIZE = 1024 * 1024;
+
+// 入力順に渡す場合にスレッドあたり先に読み込むブロック数
+const SizeType LOOKAHEAD = 4;
+
+// 入力のブロック
+struct Chunk
+{
+  // コンストラクタ
+  Chunk(
+    SizeType begin,
+    SizeType end
+  ) : mBegin{begin},
+      mEnd{end}
+  {
+  }
+
+  // 先頭のオフセット
+  SizeType mBegin;
+
+  // 末尾のオフセット
+  // 最後のブロック以外は改行文字の直後となる．
+  SizeType mEnd;
+
+  // 先頭の行番号
+  SizeType mLine{1};
+
+  // 読み込んだ値の行番号のリスト
+  std::vector<SizeType> mLineList;
+
+  // 読み込んだ値のリスト
+  std::vector<JsonValue> mValueList;
+
+  // 読み込み中に起きた例外
+  std::exception_ptr mError;
+
+  // 読み込みが終わった時 true
+  bool mDone{false};
+
+};
+
+// 入力を改行の位置でブロックに分割する．
+std::vector<Chunk>
+split(
+  std::string_view buff
+)
+{
+  std::vector<Chunk> chunk_list;
+  SizeType begin = 0;
+  while ( begin < buff.size() ) {
+    auto end = buff.size();
+    if ( begin + CHUNK_SIZE < buff.size() ) {
+      auto pos = buff.find('\n', begin + CHUNK_SIZE - 1);
+      if ( pos != std::string_view::npos ) {
+	end = pos + 1;
+      }
+    }
+    chunk_list.emplace_back(begin, end);
+    begin = end;
+  }
+  return chunk_list;
+}
+
+// ブロック内の各行を読み込んで func(行番号, 値) を呼び出す．
+//
+// 例外は chunk.mError に記録して読み込みを終える．
+template<class Func>
+void
+parse_chunk(
+  std::string_view buff,
+  Chunk& chunk,
+  Func func
+)
+{
+  // ブロック内の値はすべて一つのアリーナ上に置く．
+  auto doc = new JsonDocument;
+  doc->inc_ref();
+  auto line = chunk.mLine;
+  auto pos = chunk.mBegin;
+  try {
+    while ( pos < chunk.mEnd ) {
+      auto nl = buff.find('\n', pos);
+      if ( nl == std::string_view::npos || nl > chunk.mEnd ) {
+	nl = chunk.mEnd;
+      }
+      auto end = nl;
+      if ( end > pos && buff[end - 1] == '\r' ) {
+	-- end;
+      }
+      auto p = buff.data() + pos;
+      auto e = buff.data() + end;
+      if ( JsonSimd::skip_blank(p, e) != e ) {
+	// エラーの位置は入力全体でのものとする．
+	JsonParser parser{buff.substr(0, end),
+			  JsonPos{pos, static_cast<int>(line), pos},
+			  doc};
+	func(line, parser.read());
+      }
+      pos = nl + 1;
+      ++ line;
+    }
+  }
+  catch ( ... ) {
+    chunk.mError = std::current_exception();
+  }
+  doc->dec_ref();
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonLinesReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力バッファを指定したコンストラクタ
+JsonLinesReader::JsonLinesReader(
+  std::string_view buff,
+  SizeType thread_num
+) : mBuff{buff},
+    mThreadNum{resolve_thread_num(thread_num)}
+{
+}
+
+// @brief ファイルを指定したコンストラクタ
+JsonLinesReader::JsonLinesReader(
+  std::unique_ptr<MappedFile>&& file,
+  SizeType thread_num
+) : JsonLinesReader{file->view(), thread_num}
+{
+  mFile = std::move(file);
+}
+
+// @brief ムーブコンストラクタ
+JsonLinesReader::JsonLinesReader(
+  JsonLinesReader&& src
+) = default;
+
+// @brief デストラクタ
+JsonLinesReader::~JsonLinesReader()
+{
+}
+
+// @brief ファイルを読み込むオブジェクトを作る．
+JsonLinesReader
+JsonLinesReader::open(
+  const std::string& filename,
+  SizeType thread_num
+)
+{
+  auto file = std::make_unique<MappedFile>(filename);
+  return JsonLinesReader{std::move(file), thread_num};
+}
+
+// @brief 全ての値を入力順に読み込む．
+std::vector<JsonValue>
+JsonLinesReader::read_all()
+{
+  std::vector<JsonValue> value_list;
+  read([&](SizeType, const JsonValue& value) {
+    value_list.push_back(value);
+  });
+  return value_list;
+}
+
+// @brief 値を読み込むごとに callback を呼び出す．
+void
+JsonLinesReader::read(
+  const Callback& callback,
+  bool ordered
+)
+{
+  auto chunk_list = split(mBuff);
+  auto n = chunk_list.size();
+
+  // 各ブロックの先頭の行番号を求める．
+  std::vector<SizeType> nl_num(n);
+  parallel_for(mThreadNum, n, [&](SizeType i) {
+    auto& chunk = chunk_list[i];
+    nl_num[i] = std::count(mBuff.begin() + chunk.mBegin,
+			   mBuff.begin() + chunk.mEnd, '\n');
+  });
+  for ( SizeType i = 1; i < n; ++ i ) {
+    chunk_list[i].mLine = chunk_list[i - 1].mLine + nl_num[i - 1];
+  }
+
+  if ( !ordered ) {
+    // 各スレッドから直接 callback を呼ぶ．
+    parallel_for(mThreadNum, n, [&](SizeType i) {
+      parse_chunk(mBuff, chunk_list[i],
+		  [&](SizeType line, const JsonValue& value) {
+		    callback(line, value);
+		  });
+    });
+    for ( auto& chunk: chunk_list ) {
+      if ( chunk.mError ) {
+	std::rethrow_exception(chunk.mError);
+      }
+    }
+    return;
+  }
+
+  // ブロックごとに読み込んだ値をためておき，
+  // 呼び出し元のスレッドで入力順に callback を呼ぶ．
+  auto store = [](Chunk& chunk) {
+    return [&chunk](SizeType line, JsonValue&& value) {
+      chunk.mLineList.push_back(line);
+      chunk.mValueList.push_back(std::move(value));
+    };
+  };
+  auto deliver = [&](Chunk& chunk) {
+    for ( SizeType i = 0; i < chunk.mValueList.size(); ++ i ) {
+      callback(chunk.mLineList[i], chunk.mValueList[i]);
+    }
+    if ( chunk.mError ) {
+      std::rethrow_exception(chunk.mError);
+    }
+    chunk.mLineList = {};
+    chunk.mValueList = {};
+  };
+
+  if ( mThreadNum == 1 || n <= 1 ) {
+    for ( auto& chunk: chunk_list ) {
+      parse_chunk(mBuff, chunk, store(chunk));
+      deliver(chunk);
+    }
+    return;
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  // callback に渡し終えたブロック数
+  SizeType delivered = 0;
+  // 読み込みを中断する時 true
+  bool abort = false;
+  // 先に読み込むブロック数の上限
+  auto window = mThreadNum * LOOKAHEAD;
+  std::atomic<SizeType> next{0};
+  auto worker = [&]() {
+    for ( ; ; ) {
+      auto i = next ++;
+      if ( i >= n ) {
+	break;
+      }
+      {
+	std::unique_lock<std::mutex> lock{mtx};
+	cv.wait(lock, [&]() { return abort || i < delivered + window; });
+	if ( abort ) {
+	  break;
+	}
+      }
+      auto& chunk = chunk_list[i];
+      parse_chunk(mBuff, chunk, store(chunk));
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	chunk.mDone = true;
+      }
+      cv.notify_all();
+    }
+  };
+  std::vector<std::thread> thread_list;
+  for ( SizeType i = 0; i < std::min(mThreadNum, n); ++ i ) {
+    thread_list.emplace_back(worker);
+  }
+
+  std::exception_ptr error;
+  try {
+    for ( auto& chunk: chunk_list ) {
+      {
+	std::unique_lock<std::mutex> lock{mtx};
+	cv.wait(lock, [&]() { return chunk.mDone; });
+      }
+      deliver(chunk);
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	++ delivered;
+      }
+      cv.notify_all();
+    }
+  }
+  catch ( ... ) {
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock{mtx};
+    abort = true;
+  }
+  cv.notify_all();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+}
+
+END_NAMESPACE_YM_JSON
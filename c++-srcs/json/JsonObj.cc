@@ -7,63 +7,31 @@
 /// All rights reserved.
 
 #include "JsonObj.h"
+#include "JsonDocument.h"
+#include "JsonParser.h"
+#include "JsonBinEncoder.h"
 #include "ym/JsonValue.h"
+#include <unordered_set>
 
 
 BEGIN_NAMESPACE_YM_JSON
 
 BEGIN_NONAMESPACE
 
-std::string
-escaped_string(
-  const std::string& src_string
-)
-{
-  bool has_dq = false;
-  bool has_sq = false;
-  for ( auto c: src_string ) {
-    if ( c == '"' ) {
-      has_dq = true;
-    }
-    if ( c == '\'' ) {
-      has_sq = true;
-    }
-  }
-  std::string ans;
-  if ( !has_dq ) {
-    ans += '"';
-    ans += src_string;
-    ans += '"';
-  }
-  else if ( !has_sq ) {
-    ans += "'";
-    ans += src_string;
-    ans += "'";
-  }
-  else {
-    // 文字列中の " をエスケープする．
-    ans += '"';
-    for ( auto c: src_string ) {
-      if ( c == '"' ) {
-	ans += '\\';
-      }
-      ans += c;
-    }
-    ans += '"';
-  }
-  return ans;
-}
-
-std::string
-tab(
+// 索引のサイズを求める．
+//
+// 要素数の 2 倍以上の 2 のべき乗
+inline
+SizeType
+index_size(
   SizeType n
 )
 {
-  std::string ans;
-  for ( SizeType i = 0; i < n; ++ i ) {
-    ans += "    ";
+  SizeType size = 1;
+  while ( size < n * 2 ) {
+    size <<= 1;
   }
-  return ans;
+  return size;
 }
 
 END_NONAMESPACE
@@ -72,48 +40,6 @@ END_NONAMESPACE
 // クラス JsonObj
 //////////////////////////////////////////////////////////////////////
 
-// @brief 文字列型の時 true を返す．
-bool
-JsonObj::is_string() const
-{
-  return false;
-}
-
-// @brief 整数型の時 true を返す．
-bool
-JsonObj::is_int() const
-{
-  return false;
-}
-
-// @brief 浮動小数点型の時 true を返す．
-bool
-JsonObj::is_float() const
-{
-  return false;
-}
-
-// @brief ブール型の時 true を返す．
-bool
-JsonObj::is_bool() const
-{
-  return false;
-}
-
-// @brief オブジェクト型の時 true を返す．
-bool
-JsonObj::is_object() const
-{
-  return false;
-}
-
-// @brief 配列型の時 true を返す．
-bool
-JsonObj::is_array() const
-{
-  return false;
-}
-
 // @brief 配列の要素数を得る．
 SizeType
 JsonObj::size() const
@@ -176,37 +102,120 @@ JsonObj::get_string() const
   return std::string{};
 }
 
-// @brief 整数値を得る．
-int
-JsonObj::get_int() const
+// @brief 複製を作る．
+JsonObj*
+JsonObj::clone() const
+{
+  ASSERT_NOT_REACHED;
+  return nullptr;
+}
+
+// @brief オブジェクトの要素を設定する．
+void
+JsonObj::set_value(
+  const std::string& key,
+  const JsonValue& value
+)
 {
   ASSERT_NOT_REACHED;
-  return 0;
 }
 
-// @brief 浮動小数点値を得る．
-double
-JsonObj::get_float() const
+// @brief 配列の要素を設定する．
+void
+JsonObj::set_value(
+  SizeType pos,
+  const JsonValue& value
+)
+{
+  ASSERT_NOT_REACHED;
+}
+
+// @brief 配列の末尾に要素を追加する．
+void
+JsonObj::push_back(
+  const JsonValue& value
+)
 {
   ASSERT_NOT_REACHED;
-  return 0.0;
 }
 
-// @brief ブール値を得る．
+// @brief オブジェクトの要素を削除する．
 bool
-JsonObj::get_bool() const
+JsonObj::erase(
+  const std::string& key
+)
 {
   ASSERT_NOT_REACHED;
   return false;
 }
 
+// @brief 配列の要素を削除する．
+void
+JsonObj::erase(
+  SizeType pos
+)
+{
+  ASSERT_NOT_REACHED;
+}
+
+// @brief 実体を返す．
+const JsonObj*
+JsonObj::resolve() const
+{
+  return this;
+}
+
+// @brief 構造に基づくハッシュ値を返す．
+SizeType
+JsonObj::hash() const
+{
+  // 複数のスレッドで同時に計算しても結果は同じになる．
+  auto h = mHash.load(std::memory_order_relaxed);
+  if ( h == 0 ) {
+    h = compute_hash();
+    if ( h == 0 ) {
+      // 0 は未計算を表すので避ける．
+      h = 1;
+    }
+    mHash.store(h, std::memory_order_relaxed);
+  }
+  return h;
+}
+
+// @brief 参照回数を増やす．
+void
+JsonObj::inc_ref()
+{
+  if ( mDoc != nullptr ) {
+    mDoc->inc_ref();
+  }
+  else {
+    mRefCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// @brief 参照回数を減らす．
+void
+JsonObj::dec_ref()
+{
+  if ( mDoc != nullptr ) {
+    mDoc->dec_ref();
+  }
+  else if ( mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1 ) {
+    delete this;
+  }
+}
+
 // @brief JsonValue の内容を取り出す．
 JsonObj*
 JsonObj::obj_ptr(
   const JsonValue& value
 )
 {
-  return value.mPtr.get();
+  if ( value._is_obj() ) {
+    return value.mBody.mObj;
+  }
+  return nullptr;
 }
 
 
@@ -216,28 +225,94 @@ JsonObj::obj_ptr(
 
 // @brief コンストラクタ
 JsonDict::JsonDict(
-  const std::unordered_map<std::string, JsonValue>& dict
-) : mDict{dict}
+  const std::unordered_map<std::string, JsonValue>& dict,
+  std::pmr::memory_resource* mr
+) : mItemList{mr}
+{
+  mItemList.reserve(dict.size());
+  for ( auto& p: dict ) {
+    mItemList.emplace_back(p.first, p.second);
+  }
+  copy_keys(0);
+  sort_items();
+}
+
+// @brief ムーブコンストラクタ
+JsonDict::JsonDict(
+  std::unordered_map<std::string, JsonValue>&& dict,
+  std::pmr::memory_resource* mr
+) : mItemList{mr}
+{
+  mItemList.reserve(dict.size());
+  for ( auto& p: dict ) {
+    mItemList.emplace_back(p.first, std::move(p.second));
+  }
+  copy_keys(0);
+  sort_items();
+}
+
+// @brief キーと値の対のリストを受け取るコンストラクタ
+JsonDict::JsonDict(
+  const std::vector<std::pair<std::string, JsonValue>>& item_list,
+  std::pmr::memory_resource* mr
+) : mItemList{mr}
+{
+  mItemList.reserve(item_list.size());
+  for ( auto& p: item_list ) {
+    mItemList.emplace_back(p.first, p.second);
+  }
+  copy_keys(0);
+  remove_dup();
+}
+
+// @brief キーと値の対のリストを受け取るコンストラクタ(ムーブ版)
+JsonDict::JsonDict(
+  std::vector<std::pair<std::string, JsonValue>>&& item_list,
+  std::pmr::memory_resource* mr
+) : mItemList{mr}
+{
+  mItemList.reserve(item_list.size());
+  for ( auto& p: item_list ) {
+    mItemList.emplace_back(p.first, std::move(p.second));
+  }
+  copy_keys(0);
+  remove_dup();
+}
+
+// @brief キーと値の対のリストを受け取るコンストラクタ
+JsonDict::JsonDict(
+  ItemListType&& item_list,
+  bool interned
+) : mItemList{std::move(item_list)},
+    mInterned{interned}
 {
+  remove_dup();
 }
 
 // @brief デストラクタ
 JsonDict::~JsonDict()
 {
+  // アリーナ上のオブジェクトのデストラクタは起動されないので
+  // ここに来るのはヒープ上の場合のみ
+  delete [] mIndex.load();
+  if ( mKeyBuff != nullptr ) {
+    auto mr = mItemList.get_allocator().resource();
+    mr->deallocate(mKeyBuff, mKeyBuffSize, 1);
+  }
 }
 
-// @brief オブジェクト型の時 true を返す．
-bool
-JsonDict::is_object() const
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonDict::type() const
 {
-  return true;
+  return Type::Object;
 }
 
 // @brief 要素数を得る．
 SizeType
 JsonDict::size() const
 {
-  return mDict.size();
+  return mItemList.size();
 }
 
 // @brief オブジェクトがキーを持つか調べる．
@@ -246,7 +321,7 @@ JsonDict::has_key(
   const std::string& key
 ) const
 {
-  return mDict.count(key) > 0;
+  return find(key) != nullptr;
 }
 
 // @brief キーのリストを返す．
@@ -254,11 +329,10 @@ std::vector<std::string>
 JsonDict::key_list() const
 {
   std::vector<std::string> ans_list;
-  for ( auto& p: mDict ) {
-    ans_list.push_back(p.first);
+  ans_list.reserve(mItemList.size());
+  for ( auto& p: mItemList ) {
+    ans_list.push_back(std::string{p.first});
   }
-  // キーでソートしておく
-  sort(ans_list.begin(), ans_list.end());
   return ans_list;
 }
 
@@ -267,15 +341,10 @@ std::vector<std::pair<std::string, JsonValue>>
 JsonDict::item_list() const
 {
   std::vector<std::pair<std::string, JsonValue>> ans_list;
-  for ( auto& p: mDict ) {
-    ans_list.push_back(p);
-  }
-  // キーでソートしておく
-  sort(ans_list.begin(), ans_list.end(),
-       [](const std::pair<std::string, JsonValue>& a,
-	  const std::pair<std::string, JsonValue>& b){
-	 return a.first < b.first;
-       });
+  ans_list.reserve(mItemList.size());
+  for ( auto& p: mItemList ) {
+    ans_list.push_back({std::string{p.first}, p.second});
+  }
   return ans_list;
 }
 
@@ -285,421 +354,1234 @@ JsonDict::get_value(
   const std::string& key
 ) const
 {
-  if ( mDict.count(key) == 0 ) {
+  auto value_p = find(key);
+  if ( value_p == nullptr ) {
     std::ostringstream buf;
     buf << key << ": invalid key";
     throw std::invalid_argument{buf.str()};
   }
-  return mDict.at(key);
+  return borrow_value(*value_p);
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonDict::to_json(
-  int indent
-) const
+// @brief 複製を作る．
+JsonObj*
+JsonDict::clone() const
 {
-  bool first = true;
-  int indent1 = indent;
-  std::string ans;
-  ans = "{";
-  if ( indent >= 0 ) {
-    ans += '\n';
-    ++ indent1;
+  ItemListType item_list;
+  item_list.reserve(mItemList.size());
+  for ( auto& p: mItemList ) {
+    item_list.emplace_back(p.first, own_value(p.second));
   }
-  for ( auto& p: item_list() ) {
-    if ( first ) {
-      first = false;
-    }
-    else {
-      ans += ",";
-      if ( indent >= 0 ) {
-	ans += '\n';
+  auto obj = new JsonDict{std::move(item_list)};
+  obj->copy_keys(0);
+  return obj;
+}
+
+// @brief オブジェクトの要素を設定する．
+void
+JsonDict::set_value(
+  const std::string& key,
+  const JsonValue& value
+)
+{
+  ASSERT_COND( doc() == nullptr );
+
+  clear_hash();
+  auto value_p = find(key);
+  if ( value_p != nullptr ) {
+    *const_cast<JsonValue*>(value_p) = value;
+    return;
+  }
+
+  auto n = mItemList.size();
+  mItemList.emplace_back(add_key(key), value);
+  // 索引は大きさが変わらなければそのまま追加し，
+  // 変わる場合は次の探索時に作り直す．
+  auto index = mIndex.load(std::memory_order_relaxed);
+  if ( index != nullptr ) {
+    if ( index_size(n + 1) == index_size(n) ) {
+      auto mask = index_size(n) - 1;
+      auto h = key_hash(key) & mask;
+      while ( index[h] != 0 ) {
+	h = (h + 1) & mask;
       }
+      index[h] = n + 1;
     }
-    auto key = p.first;
-    auto value = p.second;
-    if ( indent >= 0 ) {
-      ans += tab(indent1);
+    else {
+      delete [] index;
+      mIndex.store(nullptr, std::memory_order_relaxed);
     }
-    ans += escaped_string(key);
-    ans += ":";
-    ans += obj_ptr(value)->to_json(indent1);
   }
-  if ( indent >= 0 ) {
-    ans += '\n';
-    ans += tab(indent);
-  }
-  ans += "}";
-  return ans;
 }
 
-// @brief 等価比較
+// @brief オブジェクトの要素を削除する．
 bool
-JsonDict::is_eq(
-  const JsonObj* right
-) const
+JsonDict::erase(
+  const std::string& key
+)
 {
-  if ( right->is_object() ) {
-    auto obj = reinterpret_cast<const JsonDict*>(right);
-    return mDict == obj->mDict;
+  ASSERT_COND( doc() == nullptr );
+
+  auto p = std::find_if(mItemList.begin(), mItemList.end(),
+			[&](const ItemType& item){
+			  return item.first == key;
+			});
+  if ( p == mItemList.end() ) {
+    return false;
   }
-  return false;
+  clear_hash();
+  // キーの領域は次に add_key() で確保し直す時に詰められる．
+  mItemList.erase(p);
+  // 位置がずれるので索引は作り直す．
+  delete [] mIndex.exchange(nullptr);
+  return true;
 }
 
-
-//////////////////////////////////////////////////////////////////////
-// クラス JsonArray
-//////////////////////////////////////////////////////////////////////
-
-// @brief コンストラクタ
-JsonArray::JsonArray(
-  const std::vector<JsonValue>& array
-) : mArray{array}
+// @brief 内容を出力する．
+void
+JsonDict::write(
+  JsonWriter& writer
+) const
 {
+  writer.object_begin();
+  for ( auto& p: mItemList ) {
+    writer.write_key(p.first);
+    writer.write_value(p.second);
+  }
+  writer.object_end();
 }
 
-// @brief デストラクタ
-JsonArray::~JsonArray()
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonDict::dump(
+  JsonBinEncoder& enc
+) const
 {
+  enc.object_begin(mItemList.size());
+  for ( auto& p: mItemList ) {
+    enc.write_key(p.first);
+    enc.write_value(p.second);
+  }
 }
 
-// @brief 配列型の時 true を返す．
+// @brief 等価比較
 bool
-JsonArray::is_array() const
+JsonDict::is_eq(
+  const JsonObj* right
+) const
 {
+  if ( !right->is_object() ) {
+    return false;
+  }
+  // 要素の順番は問わない．
+  auto obj = reinterpret_cast<const JsonDict*>(right);
+  if ( size() != obj->size() || hash_differs(obj) ) {
+    return false;
+  }
+  for ( auto& p: mItemList ) {
+    auto value_p = obj->find(p.first);
+    if ( value_p == nullptr || *value_p != p.second ) {
+      return false;
+    }
+  }
   return true;
 }
 
-// @brief 要素数を得る．
+// @brief 要素のリストからハッシュ値を計算する．
 SizeType
-JsonArray::size() const
+JsonDict::calc_hash(
+  const ItemType* item_list,
+  SizeType n
+)
 {
-  return mArray.size();
+  // 要素の順番によらないように要素ごとの値の和をとる．
+  // キーは登録の有無によらないように内容から求める．
+  std::uint64_t sum = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& p = item_list[i];
+    auto kh = std::hash<std::string_view>{}(p.first);
+    sum += mix_hash(kh * 31 + p.second.hash());
+  }
+  return mix_hash(sum + n * 7 + 6);
 }
 
-// @brief 配列の要素を得る．
-JsonValue
-JsonArray::get_value(
-  SizeType pos
-) const
+// @brief ハッシュ値を計算する．
+SizeType
+JsonDict::compute_hash() const
 {
-  if ( pos < 0 || size() <= pos ) {
-    throw std::out_of_range("pos is out of range");
-  }
-  return mArray[pos];
+  return calc_hash(mItemList.data(), mItemList.size());
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonArray::to_json(
-  int indent
+// @brief キーに対応する値を探す．
+const JsonValue*
+JsonDict::find(
+  std::string_view key
 ) const
 {
-  std::string ans;
-  ans = "[";
-  if ( indent >= 0 ) {
-    ans += '\n';
-  }
-  bool first = true;
-  int indent1 = indent;
-  if ( indent >= 0 ) {
-    ++ indent1;
-  }
-  for ( auto value: mArray ) {
-    if ( first ) {
-      first = false;
+  if ( mInterned ) {
+    // 登録されていないキーを持つオブジェクトはない．
+    // 登録されていればポインタの比較だけで済む．
+    auto ptr = doc()->find_key(key);
+    if ( ptr == nullptr ) {
+      return nullptr;
     }
-    else {
-      ans += ",";
-      if ( indent >= 0 ) {
-	ans += '\n';
+    key = std::string_view{ptr, key.size()};
+  }
+  auto same = [&](std::string_view key1) {
+    return mInterned ? key1.data() == key.data() : key1 == key;
+  };
+
+  auto n = mItemList.size();
+  if ( n <= INDEX_THRESHOLD ) {
+    for ( auto& p: mItemList ) {
+      if ( same(p.first) ) {
+	return &p.second;
       }
     }
-    if ( indent >= 0 ) {
-      ans += tab(indent1);
-    }
-    ans += obj_ptr(value)->to_json(indent1);
-  }
-  if ( indent >= 0 ) {
-    ans += '\n';
-    ans += tab(indent);
+    return nullptr;
   }
-  ans += "]";
-  return ans;
-}
 
-// @brief 等価比較
-bool
-JsonArray::is_eq(
-  const JsonObj* right
-) const
-{
-  if ( right->is_array() ) {
-    auto obj = reinterpret_cast<const JsonArray*>(right);
-    return mArray == obj->mArray;
+  const std::uint32_t* index = mIndex.load(std::memory_order_acquire);
+  if ( index == nullptr ) {
+    index = build_index();
+  }
+  auto mask = index_size(n) - 1;
+  for ( auto h = key_hash(key) & mask; ; h = (h + 1) & mask ) {
+    auto pos = index[h];
+    if ( pos == 0 ) {
+      return nullptr;
+    }
+    auto& p = mItemList[pos - 1];
+    if ( same(p.first) ) {
+      return &p.second;
+    }
   }
-  return false;
 }
 
-
-//////////////////////////////////////////////////////////////////////
-// クラス JsonString
-//////////////////////////////////////////////////////////////////////
-
-// @brief コンストラクタ
-JsonString::JsonString(
-  const std::string& value
-) : mValue{value}
+// @brief キーの順に並べ替える．
+void
+JsonDict::sort_items()
 {
+  std::sort(mItemList.begin(), mItemList.end(),
+	    [](const ItemType& a, const ItemType& b){
+	      return a.first < b.first;
+	    });
 }
 
-// @brief デストラクタ
-JsonString::~JsonString()
+// @brief 重複したキーを取り除く．
+void
+JsonDict::remove_dup()
 {
+  auto n = mItemList.size();
+  if ( n <= 1 ) {
+    return;
+  }
+  // 重複がなければ何もしない．
+  // 最初に出現したものを残す．
+  std::vector<bool> dup_mark;
+  if ( n <= INDEX_THRESHOLD ) {
+    for ( SizeType i = 1; i < n; ++ i ) {
+      for ( SizeType j = 0; j < i; ++ j ) {
+	if ( mItemList[i].first == mItemList[j].first ) {
+	  dup_mark.resize(n, false);
+	  dup_mark[i] = true;
+	  break;
+	}
+      }
+    }
+  }
+  else {
+    std::unordered_set<std::string_view> key_set;
+    key_set.reserve(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( !key_set.emplace(mItemList[i].first).second ) {
+	dup_mark.resize(n, false);
+	dup_mark[i] = true;
+      }
+    }
+  }
+  if ( dup_mark.empty() ) {
+    return;
+  }
+  SizeType wpos = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( !dup_mark[i] ) {
+      if ( wpos != i ) {
+	mItemList[wpos] = std::move(mItemList[i]);
+      }
+      ++ wpos;
+    }
+  }
+  mItemList.erase(mItemList.begin() + wpos, mItemList.end());
 }
 
-// @brief 文字列型の時 true を返す．
-bool
-JsonString::is_string() const
+// @brief 索引を作る．
+const std::uint32_t*
+JsonDict::build_index() const
 {
-  return true;
-}
+  auto n = mItemList.size();
+  auto size = index_size(n);
+  auto mask = size - 1;
+  std::uint32_t* index;
+  if ( doc() != nullptr ) {
+    index = static_cast<std::uint32_t*>(doc()->allocate_sync(sizeof(std::uint32_t) * size,
+							     alignof(std::uint32_t)));
+  }
+  else {
+    index = new std::uint32_t[size];
+  }
+  std::fill(index, index + size, 0);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto h = key_hash(mItemList[i].first) & mask;
+    while ( index[h] != 0 ) {
+      h = (h + 1) & mask;
+    }
+    index[h] = i + 1;
+  }
 
-// @brief 文字列を得る．
-std::string
-JsonString::get_string() const
-{
-  return mValue;
+  // 他のスレッドが先に作っていたらそちらを用いる．
+  std::uint32_t* expected = nullptr;
+  if ( !mIndex.compare_exchange_strong(expected, index,
+				       std::memory_order_acq_rel) ) {
+    if ( doc() == nullptr ) {
+      delete [] index;
+    }
+    return expected;
+  }
+  return index;
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonString::to_json(
-  int indent
+// @brief キーのハッシュ値を求める．
+SizeType
+JsonDict::key_hash(
+  std::string_view key
 ) const
 {
-  return escaped_string(get_string());
+  if ( mInterned ) {
+    // アリーナ上のアドレスは下位ビットが偏るので混ぜておく．
+    auto v = reinterpret_cast<std::uintptr_t>(key.data());
+    return static_cast<SizeType>((v * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+  return std::hash<std::string_view>{}(key);
 }
 
-// @brief 等価比較
-bool
-JsonString::is_eq(
-  const JsonObj* right
-) const
+// @brief キーを mKeyBuff にコピーしてそれを指すように置き換える．
+void
+JsonDict::copy_keys(
+  SizeType capacity
+)
 {
-  if ( right->is_string() ) {
-    return get_string() == right->get_string();
+  // 一つの領域にまとめてコピーする．
+  SizeType size = 0;
+  for ( auto& p: mItemList ) {
+    size += p.first.size();
   }
-  return false;
+  capacity = std::max(capacity, size);
+  auto mr = mItemList.get_allocator().resource();
+  char* buff = nullptr;
+  if ( capacity > 0 ) {
+    buff = static_cast<char*>(mr->allocate(capacity, 1));
+  }
+  auto dst = buff;
+  for ( auto& p: mItemList ) {
+    auto src = p.first;
+    std::copy(src.begin(), src.end(), dst);
+    p.first = std::string_view{dst, src.size()};
+    dst += src.size();
+  }
+  if ( mKeyBuff != nullptr ) {
+    mr->deallocate(mKeyBuff, mKeyBuffSize, 1);
+  }
+  mKeyBuff = buff;
+  mKeyBuffSize = capacity;
+  mKeyBuffUsed = size;
 }
 
+// @brief キーを mKeyBuff に追加する．
+std::string_view
+JsonDict::add_key(
+  std::string_view key
+)
+{
+  if ( mKeyBuffUsed + key.size() > mKeyBuffSize ) {
+    // 追加のたびに確保し直さないように倍の大きさにする．
+    copy_keys(std::max(mKeyBuffSize * 2, mKeyBuffUsed + key.size()));
+  }
+  auto dst = mKeyBuff + mKeyBuffUsed;
+  std::copy(key.begin(), key.end(), dst);
+  mKeyBuffUsed += key.size();
+  return std::string_view{dst, key.size()};
+}
 
 //////////////////////////////////////////////////////////////////////
-// クラス JsonInt
+// クラス JsonArray
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-JsonInt::JsonInt(
-  int value
-) : mValue{value}
+JsonArray::JsonArray(
+  const std::vector<JsonValue>& array,
+  std::pmr::memory_resource* mr
+) : mArray{array.begin(), array.end(), mr}
 {
 }
 
-// @brief デストラクタ
-JsonInt::~JsonInt()
+// @brief ムーブコンストラクタ
+JsonArray::JsonArray(
+  std::vector<JsonValue>&& array,
+  std::pmr::memory_resource* mr
+) : mArray{std::make_move_iterator(array.begin()),
+	   std::make_move_iterator(array.end()), mr}
 {
 }
 
-// @brief 整数型の時 true を返す．
-bool
-JsonInt::is_int() const
+// @brief 配列の本体を受け取るコンストラクタ
+JsonArray::JsonArray(
+  ArrayType&& array
+) : mArray{std::move(array)}
 {
-  return true;
 }
 
-// @brief 整数値を得る．
-int
-JsonInt::get_int() const
+// @brief デストラクタ
+JsonArray::~JsonArray()
 {
-  return mValue;
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonInt::to_json(
-  int indent
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonArray::type() const
+{
+  return Type::Array;
+}
+
+// @brief 要素数を得る．
+SizeType
+JsonArray::size() const
+{
+  return mArray.size();
+}
+
+// @brief 配列の要素を得る．
+JsonValue
+JsonArray::get_value(
+  SizeType pos
 ) const
 {
-  std::ostringstream buf;
-  buf << get_int();
-  return buf.str();
+  if ( pos < 0 || size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  return borrow_value(mArray[pos]);
+}
+
+// @brief 複製を作る．
+JsonObj*
+JsonArray::clone() const
+{
+  std::vector<JsonValue> array;
+  array.reserve(mArray.size());
+  for ( auto& value: mArray ) {
+    array.push_back(own_value(value));
+  }
+  return new JsonArray{std::move(array)};
+}
+
+// @brief 配列の要素を設定する．
+void
+JsonArray::set_value(
+  SizeType pos,
+  const JsonValue& value
+)
+{
+  ASSERT_COND( doc() == nullptr );
+
+  if ( pos < 0 || size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  clear_hash();
+  mArray[pos] = value;
+}
+
+// @brief 配列の末尾に要素を追加する．
+void
+JsonArray::push_back(
+  const JsonValue& value
+)
+{
+  ASSERT_COND( doc() == nullptr );
+
+  clear_hash();
+  mArray.push_back(value);
+}
+
+// @brief 配列の要素を削除する．
+void
+JsonArray::erase(
+  SizeType pos
+)
+{
+  ASSERT_COND( doc() == nullptr );
+
+  if ( pos < 0 || size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  clear_hash();
+  mArray.erase(mArray.begin() + pos);
+}
+
+// @brief 内容を出力する．
+void
+JsonArray::write(
+  JsonWriter& writer
+) const
+{
+  writer.array_begin();
+  for ( auto& value: mArray ) {
+    writer.write_value(value);
+  }
+  writer.array_end();
+}
+
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonArray::dump(
+  JsonBinEncoder& enc
+) const
+{
+  enc.array_begin(mArray.size());
+  for ( auto& value: mArray ) {
+    enc.write_value(value);
+  }
 }
 
 // @brief 等価比較
 bool
-JsonInt::is_eq(
+JsonArray::is_eq(
   const JsonObj* right
 ) const
 {
-  if ( right->is_int() ) {
-    return get_int() == right->get_int();
+  if ( right->is_array() ) {
+    auto obj = reinterpret_cast<const JsonArray*>(right);
+    return !hash_differs(obj) && mArray == obj->mArray;
   }
   return false;
 }
 
+// @brief 要素の配列からハッシュ値を計算する．
+SizeType
+JsonArray::calc_hash(
+  const JsonValue* array,
+  SizeType n
+)
+{
+  std::uint64_t h = n * 7 + 5;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    h = mix_hash(h * 31 + array[i].hash());
+  }
+  return h;
+}
+
+// @brief ハッシュ値を計算する．
+SizeType
+JsonArray::compute_hash() const
+{
+  return calc_hash(mArray.data(), mArray.size());
+}
+
 
 //////////////////////////////////////////////////////////////////////
-// クラス JsonFloat
+// クラス JsonString
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-JsonFloat::JsonFloat(
-  double value
-) : mValue{value}
+JsonString::JsonString(
+  std::string_view value,
+  std::pmr::memory_resource* mr
+) : mValue{value, mr}
 {
 }
 
-/// @brief デストラクタ
-JsonFloat::~JsonFloat()
+// @brief デストラクタ
+JsonString::~JsonString()
 {
 }
 
-// @brief 浮動小数点型の時 true を返す．
-bool
-JsonFloat::is_float() const
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonString::type() const
 {
-  return true;
+  return Type::String;
+}
+
+// @brief 文字列を得る．
+std::string
+JsonString::get_string() const
+{
+  return std::string{mValue};
 }
 
-// @brief 浮動小数点値を得る．
-double
-JsonFloat::get_float() const
+// @brief 内容を出力する．
+void
+JsonString::write(
+  JsonWriter& writer
+) const
 {
-  return mValue;
+  writer.write_string(mValue);
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonFloat::to_json(
-  int indent
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonString::dump(
+  JsonBinEncoder& enc
 ) const
 {
-  std::ostringstream buf;
-  buf << get_float();
-  return buf.str();
+  enc.write_string(mValue);
 }
 
 // @brief 等価比較
 bool
-JsonFloat::is_eq(
+JsonString::is_eq(
   const JsonObj* right
 ) const
 {
-  if ( right->is_float() ) {
-    return get_float() == right->get_float();
+  if ( right->is_string() ) {
+    auto obj = reinterpret_cast<const JsonString*>(right);
+    return !hash_differs(obj) && mValue == obj->mValue;
   }
   return false;
 }
 
+// @brief 文字列からハッシュ値を計算する．
+SizeType
+JsonString::calc_hash(
+  std::string_view str
+)
+{
+  return mix_hash(std::hash<std::string_view>{}(str) + 4);
+}
+
+// @brief ハッシュ値を計算する．
+SizeType
+JsonString::compute_hash() const
+{
+  return calc_hash(mValue);
+}
+
 
 //////////////////////////////////////////////////////////////////////
-// クラス JsonTrue
+// クラス JsonLazy
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-JsonTrue::JsonTrue()
+JsonLazy::JsonLazy(
+  bool is_object,
+  const JsonPos& pos,
+  std::pmr::memory_resource* mr,
+  bool is_root
+) : mType{is_object ? Type::Object : Type::Array},
+    mIsRoot{is_root},
+    mNext{pos},
+    mItemList{mr},
+    mArray{mr}
 {
 }
 
 // @brief デストラクタ
-JsonTrue::~JsonTrue()
+JsonLazy::~JsonLazy()
 {
 }
 
-// @brief ブール型の時 true を返す．
-bool
-JsonTrue::is_bool() const
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonLazy::type() const
 {
-  return true;
+  return mType;
 }
 
-// @brief ブール値を得る．
+// @brief 要素数を得る．
+SizeType
+JsonLazy::size() const
+{
+  return resolve()->size();
+}
+
+// @brief オブジェクトがキーを持つか調べる．
 bool
-JsonTrue::get_bool() const
+JsonLazy::has_key(
+  const std::string& key
+) const
 {
-  return true;
+  JsonValue value;
+  return find(key, value);
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonTrue::to_json(
-  int indent
+// @brief キーのリストを返す．
+std::vector<std::string>
+JsonLazy::key_list() const
+{
+  return resolve()->key_list();
+}
+
+// @brief キーと値のリストを返す．
+std::vector<std::pair<std::string, JsonValue>>
+JsonLazy::item_list() const
+{
+  return resolve()->item_list();
+}
+
+// @brief オブジェクトの要素を得る．
+JsonValue
+JsonLazy::get_value(
+  const std::string& key
 ) const
 {
-  return "true";
+  JsonValue value;
+  if ( !find(key, value) ) {
+    std::ostringstream buf;
+    buf << key << ": invalid key";
+    throw std::invalid_argument{buf.str()};
+  }
+  return value;
+}
+
+// @brief 配列の要素を得る．
+JsonValue
+JsonLazy::get_value(
+  SizeType pos
+) const
+{
+  if ( mBody.load(std::memory_order_acquire) == nullptr ) {
+    std::lock_guard<std::mutex> lock{doc()->mutex()};
+    if ( mBody.load(std::memory_order_relaxed) == nullptr ) {
+      // pos 番目の要素まで読み込む．
+      if ( mArray.size() <= pos ) {
+	read_items([&]() { return mArray.size() > pos; });
+      }
+      if ( mBody.load(std::memory_order_relaxed) == nullptr ) {
+	return mArray[pos];
+      }
+    }
+  }
+  return resolve()->get_value(pos);
+}
+
+// @brief 内容を出力する．
+void
+JsonLazy::write(
+  JsonWriter& writer
+) const
+{
+  resolve()->write(writer);
+}
+
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonLazy::dump(
+  JsonBinEncoder& enc
+) const
+{
+  resolve()->dump(enc);
 }
 
 // @brief 等価比較
 bool
-JsonTrue::is_eq(
+JsonLazy::is_eq(
   const JsonObj* right
 ) const
 {
-  if ( right->is_bool() ) {
-    return right->get_bool();
+  return resolve()->is_eq(right->resolve());
+}
+
+// @brief ハッシュ値を計算する．
+SizeType
+JsonLazy::compute_hash() const
+{
+  return resolve()->hash();
+}
+
+// @brief 実体を返す．
+const JsonObj*
+JsonLazy::resolve() const
+{
+  auto body = mBody.load(std::memory_order_acquire);
+  if ( body == nullptr ) {
+    std::lock_guard<std::mutex> lock{doc()->mutex()};
+    body = mBody.load(std::memory_order_relaxed);
+    if ( body == nullptr ) {
+      read_items([]() { return false; });
+      body = mBody.load(std::memory_order_relaxed);
+    }
   }
-  return false;
+  return body;
+}
+
+// @brief 閉じ括弧の直後の位置を返す．
+JsonPos
+JsonLazy::end_pos() const
+{
+  if ( !mHasEnd ) {
+    JsonParser parser{doc(), mNext, mPending};
+    parser.skip_rest();
+    if ( mIsRoot ) {
+      parser.read_end();
+    }
+    mEnd = parser.cur_pos();
+    mHasEnd = true;
+  }
+  return mEnd;
+}
+
+// @brief キーに対応する値を探す．
+bool
+JsonLazy::find(
+  const std::string& key,
+  JsonValue& value
+) const
+{
+  if ( mBody.load(std::memory_order_acquire) == nullptr ) {
+    std::lock_guard<std::mutex> lock{doc()->mutex()};
+    // 読み込んだ要素が少ないうちは線形探索を行う．
+    // 多くなったら全体を読み込んで JsonDict の索引を用いる．
+    if ( mBody.load(std::memory_order_relaxed) == nullptr &&
+	 mItemList.size() <= JsonDict::INDEX_THRESHOLD ) {
+      // 重複したキーは最初のものを用いる．
+      for ( auto& p: mItemList ) {
+	if ( p.first == key ) {
+	  value = p.second;
+	  return true;
+	}
+      }
+      bool found = false;
+      read_items([&]() {
+	if ( mItemList.back().first == key ) {
+	  found = true;
+	  return true;
+	}
+	return mItemList.size() > JsonDict::INDEX_THRESHOLD;
+      });
+      if ( found ) {
+	value = mItemList.back().second;
+	return true;
+      }
+    }
+  }
+  auto value_p = reinterpret_cast<const JsonDict*>(resolve())->find(key);
+  if ( value_p == nullptr ) {
+    return false;
+  }
+  value = *value_p;
+  return true;
+}
+
+// @brief 要素を読み込む．
+template<class Cond>
+void
+JsonLazy::read_items(
+  Cond cond
+) const
+{
+  auto doc = this->doc();
+  JsonParser parser{doc, mNext, mPending};
+  for ( ; ; ) {
+    bool first = !mStarted;
+    bool ok = mType == Type::Object ?
+      parser.read_item(mItemList, first) :
+      parser.read_element(mArray, first);
+    if ( !ok ) {
+      break;
+    }
+    // 途中で例外が送出されても読み込んだ要素と位置が食い違わないように
+    // 要素ごとに位置を更新する．
+    mStarted = true;
+    mNext = parser.cur_pos();
+    mPending = parser.pending();
+    if ( cond() ) {
+      return;
+    }
+  }
+
+  if ( mIsRoot ) {
+    // 根の場合は後ろに余分な内容がないことを確かめる．
+    // エラーの場合は実体を作らないので，参照するたびに例外が送出される．
+    parser.read_end();
+  }
+
+  // 最後まで読み込んだので実体を作る．
+  mEnd = parser.cur_pos();
+  mHasEnd = true;
+  mPending = nullptr;
+  auto value = mType == Type::Object ?
+    doc->new_value<JsonDict>(std::move(mItemList)) :
+    doc->new_value<JsonArray>(std::move(mArray));
+  mBody.store(obj_ptr(value), std::memory_order_release);
 }
 
 
 //////////////////////////////////////////////////////////////////////
-// クラス JsonFalse
+// クラス JsonTable::Column
 //////////////////////////////////////////////////////////////////////
 
-// @brief コンストラクタ
-JsonFalse::JsonFalse()
+// @brief 末尾に値を追加する．
+void
+JsonTable::Column::push_back(
+  const JsonValue& value
+)
 {
+  auto n = size();
+  if ( n == 0 ) {
+    // 最初の値で種類を決める．
+    mKind = value.is_int()   ? Kind::Int :
+            value.is_float() ? Kind::Float : Kind::Value;
+  }
+  if ( mKind == Kind::Int && value.is_int() ) {
+    mIntArray.push_back(value.get_int());
+    return;
+  }
+  if ( mKind == Kind::Float && value.is_float() ) {
+    mFloatArray.push_back(value.get_float());
+    return;
+  }
+  if ( mKind != Kind::Value ) {
+    // 種類の異なる値が来たので JsonValue の配列に移す．
+    mValueArray.reserve(n + 1);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mValueArray.push_back(get(i));
+    }
+    mIntArray.clear();
+    mIntArray.shrink_to_fit();
+    mFloatArray.clear();
+    mFloatArray.shrink_to_fit();
+    mKind = Kind::Value;
+  }
+  mValueArray.push_back(value);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonTable
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+JsonTable::JsonTable(
+  KeyListType&& key_list,
+  const std::vector<Column>& column_list,
+  bool interned
+) : mKeyList{std::move(key_list)},
+    mColumnList{mKeyList.get_allocator()},
+    mNum{column_list.empty() ? 0 : column_list.front().size()},
+    mInterned{interned}
+{
+  auto mr = mKeyList.get_allocator().resource();
+  mColumnList.reserve(column_list.size());
+  for ( auto& column: column_list ) {
+    mColumnList.emplace_back(column, mr);
+  }
 }
 
 // @brief デストラクタ
-JsonFalse::~JsonFalse()
+JsonTable::~JsonTable()
 {
 }
 
-// @brief ブール型の時 true を返す．
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonTable::type() const
+{
+  return Type::Array;
+}
+
+// @brief 要素数を得る．
+SizeType
+JsonTable::size() const
+{
+  return mNum;
+}
+
+// @brief 配列の要素を得る．
+JsonValue
+JsonTable::get_value(
+  SizeType pos
+) const
+{
+  if ( pos < 0 || size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  auto row_list = mRowList.load(std::memory_order_acquire);
+  if ( row_list != nullptr ) {
+    auto obj = row_list[pos].load(std::memory_order_acquire);
+    if ( obj != nullptr ) {
+      return JsonDocument::borrow(obj);
+    }
+  }
+  std::lock_guard<std::mutex> lock{doc()->mutex()};
+  return JsonDocument::borrow(row(pos));
+}
+
+// @brief 内容を出力する．
+void
+JsonTable::write(
+  JsonWriter& writer
+) const
+{
+  // 要素のノードは作らずに列から直接出力する．
+  writer.array_begin();
+  for ( SizeType i = 0; i < mNum; ++ i ) {
+    write_row(writer, i);
+  }
+  writer.array_end();
+}
+
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonTable::dump(
+  JsonBinEncoder& enc
+) const
+{
+  enc.array_begin(mNum);
+  for ( SizeType i = 0; i < mNum; ++ i ) {
+    dump_row(enc, i);
+  }
+}
+
+// @brief 等価比較
 bool
-JsonFalse::is_bool() const
+JsonTable::is_eq(
+  const JsonObj* right
+) const
 {
-  return true;
+  return resolve()->is_eq(right->resolve());
+}
+
+// @brief 実体を返す．
+const JsonObj*
+JsonTable::resolve() const
+{
+  auto body = mBody.load(std::memory_order_acquire);
+  if ( body == nullptr ) {
+    auto doc = this->doc();
+    std::lock_guard<std::mutex> lock{doc->mutex()};
+    body = mBody.load(std::memory_order_relaxed);
+    if ( body == nullptr ) {
+      JsonArray::ArrayType array{doc->resource()};
+      array.reserve(mNum);
+      for ( SizeType i = 0; i < mNum; ++ i ) {
+	array.push_back(JsonDocument::borrow(row(i)));
+      }
+      body = obj_ptr(doc->new_value<JsonArray>(std::move(array)));
+      mBody.store(body, std::memory_order_release);
+    }
+  }
+  return body;
+}
+
+// @brief キーの位置を返す．
+int
+JsonTable::key_pos(
+  std::string_view key
+) const
+{
+  auto n = mKeyList.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( mKeyList[i] == key ) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// @brief 行の内容を出力する．
+void
+JsonTable::write_row(
+  JsonWriter& writer,
+  SizeType pos
+) const
+{
+  writer.object_begin();
+  auto n = mKeyList.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    writer.write_key(mKeyList[i]);
+    writer.write_value(mColumnList[i].get(pos));
+  }
+  writer.object_end();
+}
+
+// @brief 行の内容をバイナリ形式で出力する．
+void
+JsonTable::dump_row(
+  JsonBinEncoder& enc,
+  SizeType pos
+) const
+{
+  auto n = mKeyList.size();
+  enc.object_begin(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    enc.write_key(mKeyList[i]);
+    enc.write_value(mColumnList[i].get(pos));
+  }
+}
+
+// @brief ハッシュ値を計算する．
+SizeType
+JsonTable::compute_hash() const
+{
+  return resolve()->hash();
+}
+
+// @brief 要素のノードを返す．
+JsonObj*
+JsonTable::row(
+  SizeType pos
+) const
+{
+  auto doc = this->doc();
+  auto row_list = mRowList.load(std::memory_order_relaxed);
+  if ( row_list == nullptr ) {
+    using RowPtr = std::atomic<JsonObj*>;
+    auto p = doc->resource()->allocate(sizeof(RowPtr) * mNum,
+				       alignof(RowPtr));
+    row_list = static_cast<RowPtr*>(p);
+    for ( SizeType i = 0; i < mNum; ++ i ) {
+      new (&row_list[i]) RowPtr{nullptr};
+    }
+    mRowList.store(row_list, std::memory_order_release);
+  }
+  auto obj = row_list[pos].load(std::memory_order_relaxed);
+  if ( obj == nullptr ) {
+    obj = doc->new_obj<JsonTableRow>(this, pos);
+    row_list[pos].store(obj, std::memory_order_release);
+  }
+  return obj;
 }
 
-// @brief ブール値を得る．
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonTableRow
+//////////////////////////////////////////////////////////////////////
+
+// @brief デストラクタ
+JsonTableRow::~JsonTableRow()
+{
+}
+
+// @brief 値の種類を返す．
+JsonObj::Type
+JsonTableRow::type() const
+{
+  return Type::Object;
+}
+
+// @brief 要素数を得る．
+SizeType
+JsonTableRow::size() const
+{
+  return mTable->keys().size();
+}
+
+// @brief オブジェクトがキーを持つか調べる．
 bool
-JsonFalse::get_bool() const
+JsonTableRow::has_key(
+  const std::string& key
+) const
 {
-  return false;
+  return mTable->key_pos(key) >= 0;
 }
 
-// @brief 内容を JSON 文字列に変換する．
-std::string
-JsonFalse::to_json(
-  int indent
+// @brief キーのリストを返す．
+std::vector<std::string>
+JsonTableRow::key_list() const
+{
+  std::vector<std::string> ans_list;
+  ans_list.reserve(size());
+  for ( auto key: mTable->keys() ) {
+    ans_list.push_back(std::string{key});
+  }
+  return ans_list;
+}
+
+// @brief キーと値のリストを返す．
+std::vector<std::pair<std::string, JsonValue>>
+JsonTableRow::item_list() const
+{
+  std::vector<std::pair<std::string, JsonValue>> ans_list;
+  auto n = size();
+  ans_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    ans_list.push_back({std::string{mTable->keys()[i]},
+			mTable->column(i).get(mPos)});
+  }
+  return ans_list;
+}
+
+// @brief オブジェクトの要素を得る．
+JsonValue
+JsonTableRow::get_value(
+  const std::string& key
+) const
+{
+  auto i = mTable->key_pos(key);
+  if ( i < 0 ) {
+    std::ostringstream buf;
+    buf << key << ": invalid key";
+    throw std::invalid_argument{buf.str()};
+  }
+  return mTable->column(i).get(mPos);
+}
+
+// @brief 内容を出力する．
+void
+JsonTableRow::write(
+  JsonWriter& writer
+) const
+{
+  mTable->write_row(writer, mPos);
+}
+
+// @brief 内容をバイナリ形式で出力する．
+void
+JsonTableRow::dump(
+  JsonBinEncoder& enc
 ) const
 {
-  return "false";
+  mTable->dump_row(enc, mPos);
 }
 
 // @brief 等価比較
 bool
-JsonFalse::is_eq(
+JsonTableRow::is_eq(
   const JsonObj* right
 ) const
 {
-  if ( right->is_bool() ) {
-    return !right->get_bool();
+  return resolve()->is_eq(right->resolve());
+}
+
+// @brief 実体を返す．
+const JsonObj*
+JsonTableRow::resolve() const
+{
+  auto body = mBody.load(std::memory_order_acquire);
+  if ( body == nullptr ) {
+    auto doc = this->doc();
+    std::lock_guard<std::mutex> lock{doc->mutex()};
+    body = mBody.load(std::memory_order_relaxed);
+    if ( body == nullptr ) {
+      auto n = size();
+      JsonDict::ItemListType item_list{doc->resource()};
+      item_list.reserve(n);
+      for ( SizeType i = 0; i < n; ++ i ) {
+	item_list.emplace_back(mTable->keys()[i], mTable->column(i).get(mPos));
+      }
+      auto value = doc->new_value<JsonDict>(std::move(item_list),
+					    mTable->interned());
+      body = obj_ptr(value);
+      mBody.store(body, std::memory_order_release);
+    }
   }
-  return false;
+  return body;
+}
+
+// @brief ハッシュ値を計算する．
+SizeType
+JsonTableRow::compute_hash() const
+{
+  return resolve()->hash();
 }
 
 END_NAMESPACE_YM_JSON
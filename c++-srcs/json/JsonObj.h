@@ -10,16 +10,40 @@
 
 #include "ym/json.h"
 #include "ym/JsonValue.h"
+#include "ym/JsonWriter.h"
+#include "JsonScanner.h"
+#include <atomic>
+#include <memory_resource>
 
 
 BEGIN_NAMESPACE_YM_JSON
 
+class JsonDocument;
+class JsonBinEncoder;
+
 //////////////////////////////////////////////////////////////////////
 /// @class JsonObj JsonObj.h "JsonObj.h"
-/// @brief json の値を表す基底クラス
+/// @brief json の文字列，配列，オブジェクトを表す基底クラス
+///
+/// null, ブール，整数，浮動小数点数は JsonValue が直接保持するので
+/// JsonObj は用いない．
+///
+/// 内部で確保する領域は std::pmr::memory_resource から確保する．
+/// JsonDocument 上に作られたオブジェクトは JsonDocument のアリーナを
+/// 用いるのでデストラクタを起動せずにまとめて解放できる．
+/// この場合，参照回数は JsonDocument 全体で管理する．
 //////////////////////////////////////////////////////////////////////
 class JsonObj
 {
+  friend class JsonDocument;
+  friend class JsonDedup;
+
+protected:
+
+  /// @brief 値の種類
+  using Type = JsonValue::Type;
+
+
 public:
 
   /// @brief デストラクタ
@@ -32,35 +56,31 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 文字列型の時 true を返す．
-  virtual
-  bool
-  is_string() const;
-
-  /// @brief 整数型の時 true を返す．
+  /// @brief 値の種類を返す．
   virtual
-  bool
-  is_int() const;
-
-  /// @brief 浮動小数点型の時 true を返す．
-  virtual
-  bool
-  is_float() const;
+  Type
+  type() const = 0;
 
-  /// @brief ブール型の時 true を返す．
-  virtual
+  /// @brief 文字列型の時 true を返す．
   bool
-  is_bool() const;
+  is_string() const
+  {
+    return type() == Type::String;
+  }
 
   /// @brief オブジェクト型の時 true を返す．
-  virtual
   bool
-  is_object() const;
+  is_object() const
+  {
+    return type() == Type::Object;
+  }
 
   /// @brief 配列型の時 true を返す．
-  virtual
   bool
-  is_array() const;
+  is_array() const
+  {
+    return type() == Type::Array;
+  }
 
   /// @brief 要素数を得る．
   ///
@@ -96,6 +116,7 @@ public:
   ///
   /// - オブジェクト型でない場合は無効
   /// - key に対応する値がない場合は null を返す．
+  /// - 結果は所有権を持たない形で返す．
   virtual
   JsonValue
   get_value(
@@ -106,6 +127,7 @@ public:
   ///
   /// - 配列型でない場合は無効
   /// - 配列のサイズ外のアクセスはエラーとなる．
+  /// - 結果は所有権を持たない形で返す．
   virtual
   JsonValue
   get_value(
@@ -119,32 +141,81 @@ public:
   std::string
   get_string() const;
 
-  /// @brief 整数値を得る．
+  /// @brief 複製を作る．
   ///
-  /// - 整数型でない場合は無効
+  /// 自身と同じ要素を持つノードをヒープ上に作る．
+  /// 要素の値は共有する．
+  /// - オブジェクト型|配列型でない場合は無効
   virtual
-  int
-  get_int() const;
+  JsonObj*
+  clone() const;
+
+  /// @brief オブジェクトの要素を設定する．
+  ///
+  /// - オブジェクト型でない場合は無効
+  /// - key に対応する値がない場合は末尾に追加する．
+  /// - value は所有権を持つ値でなければならない．
+  virtual
+  void
+  set_value(
+    const std::string& key, ///< [in] キー
+    const JsonValue& value  ///< [in] 値
+  );
+
+  /// @brief 配列の要素を設定する．
+  ///
+  /// - 配列型でない場合は無効
+  /// - 配列のサイズ外のアクセスはエラーとなる．
+  /// - value は所有権を持つ値でなければならない．
+  virtual
+  void
+  set_value(
+    SizeType pos,          ///< [in] 位置番号 ( 0 <= pos < size() )
+    const JsonValue& value ///< [in] 値
+  );
 
-  /// @brief 浮動小数点値を得る．
+  /// @brief 配列の末尾に要素を追加する．
   ///
-  /// - 浮動小数点型でない場合は無効
+  /// - 配列型でない場合は無効
+  /// - value は所有権を持つ値でなければならない．
   virtual
-  double
-  get_float() const;
+  void
+  push_back(
+    const JsonValue& value ///< [in] 値
+  );
 
-  /// @brief ブール値を得る．
+  /// @brief オブジェクトの要素を削除する．
+  /// @return 削除した時 true を返す．
   ///
-  /// - ブール型でない場合は無効
+  /// - オブジェクト型でない場合は無効
   virtual
   bool
-  get_bool() const;
+  erase(
+    const std::string& key ///< [in] キー
+  );
+
+  /// @brief 配列の要素を削除する．
+  ///
+  /// - 配列型でない場合は無効
+  /// - 配列のサイズ外のアクセスはエラーとなる．
+  virtual
+  void
+  erase(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  );
 
-  /// @brief 内容を JSON 文字列に変換する．
+  /// @brief 内容を出力する．
   virtual
-  std::string
-  to_json(
-    int indent
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const = 0;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  virtual
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const = 0;
 
   /// @brief 等価比較
@@ -154,34 +225,243 @@ public:
     const JsonObj* right
   ) const = 0;
 
+  /// @brief 実体を返す．
+  ///
+  /// 遅延ノード(JsonLazy)の場合は全体を読み込んだ
+  /// JsonDict/JsonArray を返す．
+  /// 表形式のノード(JsonTable, JsonTableRow)の場合は
+  /// 同じ要素を持つ JsonArray/JsonDict を返す．
+  /// それ以外の場合は自身を返す．
+  virtual
+  const JsonObj*
+  resolve() const;
+
+  /// @brief 構造に基づくハッシュ値を返す．
+  ///
+  /// 最初に求めた値を保持しておき，2回目以降はそれを返す．
+  SizeType
+  hash() const;
+
+  /// @brief ハッシュ値を混ぜ合わせる．
+  static
+  SizeType
+  mix_hash(
+    std::uint64_t h ///< [in] 元の値
+  )
+  {
+    // splitmix64 の最終段
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return static_cast<SizeType>(h);
+  }
+
+  /// @brief 他から参照されていない時 true を返す．
+  ///
+  /// ヒープ上に作られて参照回数が 1 のノードは
+  /// 内容を直接書き換えることができる．
+  bool
+  is_unique() const
+  {
+    return mDoc == nullptr &&
+      mRefCount.load(std::memory_order_acquire) == 1;
+  }
+
+  /// @brief 参照回数を増やす．
+  void
+  inc_ref();
+
+  /// @brief 参照回数を減らす．
+  ///
+  /// 参照回数が 0 になったら自身(アリーナ上の場合は JsonDocument)を
+  /// 削除する．
+  void
+  dec_ref();
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
   // 継承クラスから用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ハッシュ値を計算する．
+  ///
+  /// hash() から最初の一回だけ呼ばれる．
+  virtual
+  SizeType
+  compute_hash() const = 0;
+
+  /// @brief 両方のハッシュ値が求められていて異なる時 true を返す．
+  ///
+  /// is_eq() で中身をたどらずに不一致を判定するために用いる．
+  bool
+  hash_differs(
+    const JsonObj* right ///< [in] 比較対象
+  ) const
+  {
+    auto h1 = mHash.load(std::memory_order_relaxed);
+    auto h2 = right->mHash.load(std::memory_order_relaxed);
+    return h1 != 0 && h2 != 0 && h1 != h2;
+  }
+
+  /// @brief 保持しているハッシュ値を捨てる．
+  ///
+  /// 内容を書き換えた時に用いる．
+  void
+  clear_hash()
+  {
+    mHash.store(0, std::memory_order_relaxed);
+  }
+
+  /// @brief 所有権を持つ形にした値を返す．
+  ///
+  /// ヒープ上のノードに格納する値に用いる．
+  static
+  JsonValue
+  own_value(
+    const JsonValue& value ///< [in] 値
+  )
+  {
+    return value._own();
+  }
+
+  /// @brief 所有権を持たない形にした値を返す．
+  ///
+  /// get_value() の結果に用いる．
+  /// 呼び出し側で必要な場合にのみ所有権を持つ形にするので，
+  /// 読み出すだけの場合は参照回数を操作しない．
+  static
+  JsonValue
+  borrow_value(
+    const JsonValue& value ///< [in] 値
+  )
+  {
+    return value._borrow();
+  }
+
   /// @brief JsonValue の内容を取り出す．
+  ///
+  /// 文字列，配列，オブジェクト以外の場合は nullptr を返す．
   static
   JsonObj*
   obj_ptr(
     const JsonValue& value
   );
 
+  /// @brief 所属する JsonDocument を返す．
+  ///
+  /// ヒープ上に確保された場合は nullptr を返す．
+  JsonDocument*
+  doc() const
+  {
+    return mDoc;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 参照回数
+  std::atomic<SizeType> mRefCount{0};
+
+  // ハッシュ値
+  //
+  // 0 の時はまだ求められていない．
+  mutable std::atomic<SizeType> mHash{0};
+
+  // 所属する JsonDocument
+  //
+  // ヒープ上に確保された場合は nullptr
+  JsonDocument* mDoc{nullptr};
+
 };
 
 
 //////////////////////////////////////////////////////////////////////
 /// @class JsonDict JsonObj.h "JsonObj.h"
 /// @brief オブジェクト型を表すクラス
+///
+/// キーと値の対を挿入順に連続した配列で保持する．
+/// 要素数が INDEX_THRESHOLD 以下の場合は線形探索を行い，
+/// それを超える場合は最初の探索時にハッシュ表の索引を作る．
+/// 重複したキーは最初のものが残る．
+///
+/// キーの文字列はヒープ上に作られた場合は自身が保持し，
+/// JsonDocument 上に作られた場合はアリーナ上に置かれる．
+/// キーが JsonDocument::intern() で登録されたものの場合は
+/// キーの比較とハッシュ値の計算はポインタに対して行う．
+///
+/// 要素の追加と削除はヒープ上に作られたものに対してのみ行える．
+/// JsonDocument 上のものは JsonValue 側で clone() した複製を書き換える．
 //////////////////////////////////////////////////////////////////////
 class JsonDict :
   public JsonObj
 {
 public:
 
+  /// @brief キーと値の対
+  using ItemType = std::pair<std::string_view, JsonValue>;
+
+  /// @brief キーと値の対のリスト
+  using ItemListType = std::pmr::vector<ItemType>;
+
+  /// @brief 索引を作る要素数の閾値
+  static const SizeType INDEX_THRESHOLD = 16;
+
   /// @brief コンストラクタ
+  ///
+  /// 要素はキーの順に並べられる．
+  JsonDict(
+    const std::unordered_map<std::string, JsonValue>& dict, ///< [in] 本体の辞書
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
+  );
+
+  /// @brief ムーブコンストラクタ
+  ///
+  /// 値はムーブされるが，キーの文字列はコピーされる．
+  /// 要素はキーの順に並べられる．
+  JsonDict(
+    std::unordered_map<std::string, JsonValue>&& dict, ///< [in] 本体の辞書
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
+  );
+
+  /// @brief キーと値の対のリストを受け取るコンストラクタ
+  ///
+  /// 要素は item_list の順に並べられる．
+  /// 重複したキーは最初のものが残る．
+  JsonDict(
+    const std::vector<std::pair<std::string, JsonValue>>& item_list, ///< [in] キーと値の対のリスト
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
+  );
+
+  /// @brief キーと値の対のリストを受け取るコンストラクタ(ムーブ版)
+  ///
+  /// 値はムーブされるが，キーの文字列はコピーされる．
+  /// 要素は item_list の順に並べられる．
+  /// 重複したキーは最初のものが残る．
+  JsonDict(
+    std::vector<std::pair<std::string, JsonValue>>&& item_list, ///< [in] キーと値の対のリスト
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
+  );
+
+  /// @brief キーと値の対のリストを受け取るコンストラクタ
+  ///
+  /// item_list のメモリリソースがそのまま用いられる．
+  /// 要素は item_list の順に並べられる．
+  /// キーの文字列はコピーしないので，アリーナ上に置かれていなければならない．
+  /// interned が true の場合，キーはすべて所属する JsonDocument の
+  /// intern() で登録されたものでなければならない．
   JsonDict(
-    const std::unordered_map<std::string, JsonValue>& dict ///< [in] 本体の辞書
+    ItemListType&& item_list, ///< [in] キーと値の対のリスト
+    bool interned = false     ///< [in] キーが登録されたものの時 true
   );
 
   /// @brief デストラクタ
@@ -193,9 +473,9 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief オブジェクト型の時 true を返す．
-  bool
-  is_object() const override;
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
 
   /// @brief 要素数を得る．
   SizeType
@@ -230,10 +510,36 @@ public:
     const std::string& key ///< [in] キー
   ) const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief 複製を作る．
+  JsonObj*
+  clone() const override;
+
+  /// @brief オブジェクトの要素を設定する．
+  ///
+  /// - key に対応する値がない場合は末尾に追加する．
+  void
+  set_value(
+    const std::string& key, ///< [in] キー
+    const JsonValue& value  ///< [in] 値
+  ) override;
+
+  /// @brief オブジェクトの要素を削除する．
+  /// @return 削除した時 true を返す．
+  bool
+  erase(
+    const std::string& key ///< [in] キー
+  ) override;
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -242,14 +548,103 @@ public:
     const JsonObj* right
   ) const override;
 
+  /// @brief キーに対応する値を探す．
+  /// @return 値へのポインタを返す．
+  ///
+  /// 見つからない場合は nullptr を返す．
+  const JsonValue*
+  find(
+    std::string_view key ///< [in] キー
+  ) const;
+
+  /// @brief キーと値の対のリストを返す．
+  ///
+  /// item_list() と異なりコピーを作らない．
+  const ItemListType&
+  items() const
+  {
+    return mItemList;
+  }
+
+  /// @brief 要素のリストからハッシュ値を計算する．
+  ///
+  /// 同じ要素を持つノードの hash() と同じ値になる．
+  static
+  SizeType
+  calc_hash(
+    const ItemType* item_list, ///< [in] キーと値の対の配列
+    SizeType n                 ///< [in] 要素数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
+
+  /// @brief キーの順に並べ替える．
+  void
+  sort_items();
+
+  /// @brief 重複したキーを取り除く．
+  void
+  remove_dup();
+
+  /// @brief 索引を作る．
+  const std::uint32_t*
+  build_index() const;
+
+  /// @brief キーのハッシュ値を求める．
+  SizeType
+  key_hash(
+    std::string_view key ///< [in] キー
+  ) const;
+
+  /// @brief キーを mKeyBuff にコピーしてそれを指すように置き換える．
+  ///
+  /// mKeyBuff は capacity の大きさで確保し直す．
+  void
+  copy_keys(
+    SizeType capacity ///< [in] 確保する大きさ
+  );
+
+  /// @brief キーを mKeyBuff に追加する．
+  /// @return 追加したキーを返す．
+  std::string_view
+  add_key(
+    std::string_view key ///< [in] キー
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 本体
-  std::unordered_map<std::string, JsonValue> mDict;
+  // キーと値の対のリスト
+  ItemListType mItemList;
+
+  // ヒープ上に作られた場合のキーの文字列の領域
+  char* mKeyBuff{nullptr};
+
+  // mKeyBuff のサイズ
+  SizeType mKeyBuffSize{0};
+
+  // mKeyBuff の使用済みのサイズ
+  SizeType mKeyBuffUsed{0};
+
+  // キーが JsonDocument::intern() で登録されたものの時 true
+  bool mInterned{false};
+
+  // 索引(オープンアドレス法のハッシュ表)
+  //
+  // 要素は mItemList 上の位置 + 1 (0 は空きを表す)
+  // 要素数が INDEX_THRESHOLD を超える場合に最初の探索時に作られる．
+  mutable std::atomic<std::uint32_t*> mIndex{nullptr};
 
 };
 
@@ -263,9 +658,30 @@ class JsonArray :
 {
 public:
 
+  /// @brief 配列の型
+  using ArrayType = std::pmr::vector<JsonValue>;
+
   /// @brief コンストラクタ
   JsonArray(
-    const std::vector<JsonValue>& array ///< [in] 配列の本体
+    const std::vector<JsonValue>& array, ///< [in] 配列の本体
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource()   ///< [in] メモリリソース
+  );
+
+  /// @brief ムーブコンストラクタ
+  ///
+  /// 要素はムーブされる．
+  JsonArray(
+    std::vector<JsonValue>&& array,    ///< [in] 配列の本体
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
+  );
+
+  /// @brief 配列の本体を受け取るコンストラクタ
+  ///
+  /// array のメモリリソースがそのまま用いられる．
+  JsonArray(
+    ArrayType&& array ///< [in] 配列の本体
   );
 
   /// @brief デストラクタ
@@ -277,9 +693,9 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 配列型の時 true を返す．
-  bool
-  is_array() const override;
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
 
   /// @brief 要素数を得る．
   SizeType
@@ -294,10 +710,43 @@ public:
     SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
   ) const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief 複製を作る．
+  JsonObj*
+  clone() const override;
+
+  /// @brief 配列の要素を設定する．
+  ///
+  /// - 配列のサイズ外のアクセスはエラーとなる．
+  void
+  set_value(
+    SizeType pos,          ///< [in] 位置番号 ( 0 <= pos < size() )
+    const JsonValue& value ///< [in] 値
+  ) override;
+
+  /// @brief 配列の末尾に要素を追加する．
+  void
+  push_back(
+    const JsonValue& value ///< [in] 値
+  ) override;
+
+  /// @brief 配列の要素を削除する．
+  ///
+  /// - 配列のサイズ外のアクセスはエラーとなる．
+  void
+  erase(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) override;
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -306,6 +755,33 @@ public:
     const JsonObj* right
   ) const override;
 
+  /// @brief 配列の本体を返す．
+  const ArrayType&
+  elements() const
+  {
+    return mArray;
+  }
+
+  /// @brief 要素の配列からハッシュ値を計算する．
+  ///
+  /// 同じ要素を持つノードの hash() と同じ値になる．
+  static
+  SizeType
+  calc_hash(
+    const JsonValue* array, ///< [in] 要素の配列
+    SizeType n              ///< [in] 要素数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -313,7 +789,7 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 配列の実体
-  std::vector<JsonValue> mArray;
+  ArrayType mArray;
 
 };
 
@@ -329,7 +805,9 @@ public:
 
   /// @brief コンストラクタ
   JsonString(
-    const std::string& value ///< [in] 文字列の値
+    std::string_view value,           ///< [in] 文字列の値
+    std::pmr::memory_resource* mr
+    = std::pmr::get_default_resource() ///< [in] メモリリソース
   );
 
   /// @brief デストラクタ
@@ -341,9 +819,9 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 文字列型の時 true を返す．
-  bool
-  is_string() const override;
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
 
   /// @brief 文字列を得る．
   ///
@@ -351,10 +829,16 @@ public:
   std::string
   get_string() const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -363,6 +847,32 @@ public:
     const JsonObj* right
   ) const override;
 
+  /// @brief 文字列の本体を返す．
+  std::string_view
+  str() const
+  {
+    return mValue;
+  }
+
+  /// @brief 文字列からハッシュ値を計算する．
+  ///
+  /// 同じ値を持つノードの hash() と同じ値になる．
+  static
+  SizeType
+  calc_hash(
+    std::string_view str ///< [in] 文字列
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -370,27 +880,41 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 文字列の本体
-  std::string mValue;
+  std::pmr::string mValue;
 
 };
 
 
 //////////////////////////////////////////////////////////////////////
-/// @class JsonInt JsonInt.h "JsonInt.h"
-/// @brief 整数型を表すクラス
+/// @class JsonLazy JsonObj.h "JsonObj.h"
+/// @brief 遅延モードの配列かオブジェクトを表すクラス
+///
+/// 入力中の位置だけを持ち，要素は参照された時に必要な所まで読み込む．
+/// 要素が配列かオブジェクトの場合は中身を読み飛ばして JsonLazy を作るので，
+/// 一度に読み込むのは一段分だけとなる．
+/// 最後まで読み込んだら JsonDict/JsonArray を作り，以降はそちらに委譲する．
+///
+/// 必ず JsonDocument 上に作られる．
+/// 読み込みは JsonDocument::mutex() で排他制御を行う．
 //////////////////////////////////////////////////////////////////////
-class JsonInt :
+class JsonLazy :
   public JsonObj
 {
 public:
 
   /// @brief コンストラクタ
-  JsonInt(
-    int value ///< [in] 整数の値
+  ///
+  /// is_root が true の場合は閉じ括弧の後ろが入力の末尾であることを
+  /// 最後まで読み込んだ時に確かめる．
+  JsonLazy(
+    bool is_object,                ///< [in] オブジェクトの時 true
+    const JsonPos& pos,            ///< [in] 開き括弧の直後の位置
+    std::pmr::memory_resource* mr, ///< [in] メモリリソース
+    bool is_root = false           ///< [in] 根の値の時 true
   );
 
   /// @brief デストラクタ
-  ~JsonInt();
+  ~JsonLazy();
 
 
 public:
@@ -398,20 +922,50 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 整数型の時 true を返す．
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
+
+  /// @brief 要素数を得る．
+  SizeType
+  size() const override;
+
+  /// @brief オブジェクトがキーを持つか調べる．
   bool
-  is_int() const override;
+  has_key(
+    const std::string& key ///< [in] キー
+  ) const override;
 
-  /// @brief 整数値を得る．
-  ///
-  /// - 整数型でない場合は無効
-  int
-  get_int() const override;
+  /// @brief キーのリストを返す．
+  std::vector<std::string>
+  key_list() const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief キーと値のリストを返す．
+  std::vector<std::pair<std::string, JsonValue>>
+  item_list() const override;
+
+  /// @brief オブジェクトの要素を得る．
+  JsonValue
+  get_value(
+    const std::string& key ///< [in] キー
+  ) const override;
+
+  /// @brief 配列の要素を得る．
+  JsonValue
+  get_value(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const override;
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -420,34 +974,256 @@ public:
     const JsonObj* right
   ) const override;
 
+  /// @brief 実体を返す．
+  const JsonObj*
+  resolve() const override;
+
+  /// @brief 読み込みを始めていない時 true を返す．
+  ///
+  /// JsonDocument::mutex() を獲得した状態で呼ばなければならない．
+  bool
+  untouched() const
+  {
+    return !mStarted && !mHasEnd &&
+      mBody.load(std::memory_order_relaxed) == nullptr;
+  }
+
+  /// @brief 閉じ括弧の直後の位置を返す．
+  ///
+  /// 必要なら残りを読み飛ばす．
+  /// JsonDocument::mutex() を獲得した状態で呼ばなければならない．
+  JsonPos
+  end_pos() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
+
+  /// @brief キーに対応する値を探す．
+  /// @return 見つかった時 true を返す．
+  ///
+  /// 必要な所まで読み込む．
+  bool
+  find(
+    const std::string& key, ///< [in] キー
+    JsonValue& value        ///< [out] 見つかった値
+  ) const;
+
+  /// @brief 要素を読み込む．
+  ///
+  /// 要素を一つ読み込むごとに cond() を呼び出して，
+  /// true が返されたら止める．
+  /// 最後まで読み込んだら実体を作る．
+  /// JsonDocument::mutex() を獲得した状態で呼ばなければならない．
+  template<class Cond>
+  void
+  read_items(
+    Cond cond ///< [in] 終了条件
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 整数値の本体
-  int mValue;
+  // 値の種類
+  Type mType;
+
+  // 根の値の時 true
+  bool mIsRoot;
+
+  // 全体を読み込んだ実体
+  mutable std::atomic<const JsonObj*> mBody{nullptr};
+
+  // 以下はいずれも JsonDocument::mutex() で保護される．
+
+  // 次に読み込む位置
+  mutable JsonPos mNext;
+
+  // 最初の要素を読み込んだ時 true
+  mutable bool mStarted{false};
+
+  // 直前に読み込んだ要素で読み飛ばしていないもの
+  mutable JsonLazy* mPending{nullptr};
+
+  // 閉じ括弧の直後の位置
+  mutable JsonPos mEnd;
+
+  // mEnd が求められている時 true
+  mutable bool mHasEnd{false};
+
+  // 読み込んだオブジェクトの要素
+  mutable JsonDict::ItemListType mItemList;
+
+  // 読み込んだ配列の要素
+  mutable JsonArray::ArrayType mArray;
 
 };
 
 
 //////////////////////////////////////////////////////////////////////
-/// @class JsonFloat JsonFloat.h "JsonFloat.h"
-/// @brief 浮動小数点型を表すクラス
+/// @class JsonTable JsonObj.h "JsonObj.h"
+/// @brief 同じキーを持つオブジェクトの並んだ配列を表形式で保持するクラス
+///
+/// キーのリスト(形)を一つだけ持ち，値はキーごとの列で保持する．
+/// 整数だけの列と浮動小数点数だけの列はそれぞれの型の連続した配列となる．
+/// 配列型として振る舞い，要素は JsonTableRow で表される．
+///
+/// 要素のノードは参照された時に作られる．
+/// elements() などで JsonArray が必要になった場合も参照された時に作る．
+///
+/// 必ず JsonDocument 上に作られる．
+/// ノードの生成は JsonDocument::mutex() で排他制御を行う．
 //////////////////////////////////////////////////////////////////////
-class JsonFloat :
+class JsonTable :
   public JsonObj
 {
 public:
 
+  /// @brief キーのリストの型
+  using KeyListType = std::pmr::vector<std::string_view>;
+
+  /// @brief 列
+  ///
+  /// 最初の値の型で種類が決まり，
+  /// 異なる種類の値が追加されたら Value に変わる．
+  class Column
+  {
+  public:
+
+    /// @brief 列の種類
+    enum class Kind {
+      Int,   ///< 整数
+      Float, ///< 浮動小数点数
+      Value  ///< それ以外(JsonValue)
+    };
+
+    /// @brief コンストラクタ
+    explicit
+    Column(
+      std::pmr::memory_resource* mr
+      = std::pmr::get_default_resource() ///< [in] メモリリソース
+    ) : mIntArray{mr},
+	mFloatArray{mr},
+	mValueArray{mr}
+    {
+    }
+
+    /// @brief 別のメモリリソース上に複製するコンストラクタ
+    ///
+    /// 領域はちょうど要素数の分だけ確保する．
+    Column(
+      const Column& src,            ///< [in] コピー元
+      std::pmr::memory_resource* mr ///< [in] メモリリソース
+    ) : mKind{src.mKind},
+	mIntArray{src.mIntArray, mr},
+	mFloatArray{src.mFloatArray, mr},
+	mValueArray{src.mValueArray, mr}
+    {
+    }
+
+    /// @brief 種類を返す．
+    Kind
+    kind() const
+    {
+      return mKind;
+    }
+
+    /// @brief 要素数を返す．
+    SizeType
+    size() const
+    {
+      switch ( mKind ) {
+      case Kind::Int:   return mIntArray.size();
+      case Kind::Float: return mFloatArray.size();
+      default:          return mValueArray.size();
+      }
+    }
+
+    /// @brief 値を得る．
+    JsonValue
+    get(
+      SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+    ) const
+    {
+      switch ( mKind ) {
+      case Kind::Int:   return JsonValue{mIntArray[pos]};
+      case Kind::Float: return JsonValue{mFloatArray[pos]};
+      default:          return mValueArray[pos];
+      }
+    }
+
+    /// @brief 末尾に値を追加する．
+    void
+    push_back(
+      const JsonValue& value ///< [in] 値
+    );
+
+    /// @brief 整数の配列を返す．
+    ///
+    /// kind() == Kind::Int の時のみ有効
+    const std::pmr::vector<std::int64_t>&
+    int_array() const
+    {
+      return mIntArray;
+    }
+
+    /// @brief 浮動小数点数の配列を返す．
+    ///
+    /// kind() == Kind::Float の時のみ有効
+    const std::pmr::vector<double>&
+    float_array() const
+    {
+      return mFloatArray;
+    }
+
+
+  private:
+    //////////////////////////////////////////////////////////////////////
+    // データメンバ
+    //////////////////////////////////////////////////////////////////////
+
+    // 種類
+    Kind mKind{Kind::Int};
+
+    // 整数の配列
+    std::pmr::vector<std::int64_t> mIntArray;
+
+    // 浮動小数点数の配列
+    std::pmr::vector<double> mFloatArray;
+
+    // それ以外の値の配列
+    std::pmr::vector<JsonValue> mValueArray;
+
+  };
+
+  /// @brief 列の最大数
+  ///
+  /// 行のキーの探索は線形探索で行うので JsonDict の索引の閾値に合わせる．
+  static const SizeType MAX_COLUMNS = JsonDict::INDEX_THRESHOLD;
+
+  /// @brief 表形式にする行数の下限
+  static const SizeType MIN_ROWS = 8;
+
   /// @brief コンストラクタ
-  JsonFloat(
-    double value ///< [in] 浮動小数点の値
+  ///
+  /// キーの文字列はコピーしないので，アリーナ上に置かれていなければならない．
+  /// 列は key_list のメモリリソース上に複製される．
+  JsonTable(
+    KeyListType&& key_list,                 ///< [in] キーのリスト
+    const std::vector<Column>& column_list, ///< [in] 列のリスト
+    bool interned = false                   ///< [in] キーが登録されたものの時 true
   );
 
   /// @brief デストラクタ
-  ~JsonFloat();
+  ~JsonTable();
 
 
 public:
@@ -455,20 +1231,30 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 浮動小数点型の時 true を返す．
-  bool
-  is_float() const override;
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
 
-  /// @brief 浮動小数点値を得る．
-  ///
-  /// - 浮動小数点型でない場合は無効
-  double
-  get_float() const override;
+  /// @brief 要素数を得る．
+  SizeType
+  size() const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief 配列の要素を得る．
+  JsonValue
+  get_value(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const override;
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -477,32 +1263,129 @@ public:
     const JsonObj* right
   ) const override;
 
+  /// @brief 実体を返す．
+  ///
+  /// 要素のノードを並べた JsonArray を返す．
+  const JsonObj*
+  resolve() const override;
+
+  /// @brief キーのリストを返す．
+  const KeyListType&
+  keys() const
+  {
+    return mKeyList;
+  }
+
+  /// @brief キーの位置を返す．
+  /// @return 見つからない場合は -1 を返す．
+  int
+  key_pos(
+    std::string_view key ///< [in] キー
+  ) const;
+
+  /// @brief 列を返す．
+  const Column&
+  column(
+    SizeType pos ///< [in] 列番号 ( 0 <= pos < keys().size() )
+  ) const
+  {
+    return mColumnList[pos];
+  }
+
+  /// @brief キーが JsonDocument::intern() で登録されたものの時 true を返す．
+  bool
+  interned() const
+  {
+    return mInterned;
+  }
+
+  /// @brief 行の内容を出力する．
+  void
+  write_row(
+    JsonWriter& writer, ///< [in] 出力先
+    SizeType pos        ///< [in] 行番号
+  ) const;
+
+  /// @brief 行の内容をバイナリ形式で出力する．
+  void
+  dump_row(
+    JsonBinEncoder& enc, ///< [in] 出力先
+    SizeType pos         ///< [in] 行番号
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
+
+  /// @brief 要素のノードを返す．
+  ///
+  /// なければ作る．
+  /// JsonDocument::mutex() を獲得した状態で呼ばなければならない．
+  JsonObj*
+  row(
+    SizeType pos ///< [in] 位置番号
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 浮動小数点値の本体
-  double mValue;
+  // キーのリスト
+  KeyListType mKeyList;
+
+  // 列のリスト
+  std::pmr::vector<Column> mColumnList;
+
+  // 行数
+  SizeType mNum;
+
+  // キーが JsonDocument::intern() で登録されたものの時 true
+  bool mInterned;
+
+  // 要素のノードの配列
+  //
+  // 最初に要素が参照された時に確保される．
+  mutable std::atomic<std::atomic<JsonObj*>*> mRowList{nullptr};
+
+  // 要素のノードを並べた実体
+  mutable std::atomic<const JsonObj*> mBody{nullptr};
 
 };
 
 
 //////////////////////////////////////////////////////////////////////
-/// @class JsonBool JsonBool.h "JsonBool.h"
-/// @brief ブール型の true を表すクラス
+/// @class JsonTableRow JsonObj.h "JsonObj.h"
+/// @brief JsonTable の行を表すクラス
+///
+/// オブジェクト型として振る舞い，値は JsonTable の列から取り出す．
+/// items() などで JsonDict が必要になった場合は参照された時に作る．
+///
+/// 必ず JsonTable と同じ JsonDocument 上に作られる．
 //////////////////////////////////////////////////////////////////////
-class JsonTrue :
+class JsonTableRow :
   public JsonObj
 {
 public:
 
   /// @brief コンストラクタ
-  JsonTrue();
+  JsonTableRow(
+    const JsonTable* table, ///< [in] 表
+    SizeType pos            ///< [in] 行番号
+  ) : mTable{table},
+      mPos{pos}
+  {
+  }
 
   /// @brief デストラクタ
-  ~JsonTrue();
+  ~JsonTableRow();
 
 
 public:
@@ -510,20 +1393,44 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief ブール型の時 true を返す．
-  bool
-  is_bool() const override;
+  /// @brief 値の種類を返す．
+  Type
+  type() const override;
 
-  /// @brief ブール値を得る．
-  ///
-  /// - ブール型でない場合は無効
+  /// @brief 要素数を得る．
+  SizeType
+  size() const override;
+
+  /// @brief オブジェクトがキーを持つか調べる．
   bool
-  get_bool() const override;
+  has_key(
+    const std::string& key ///< [in] キー
+  ) const override;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
+  /// @brief キーのリストを返す．
+  std::vector<std::string>
+  key_list() const override;
+
+  /// @brief キーと値のリストを返す．
+  std::vector<std::pair<std::string, JsonValue>>
+  item_list() const override;
+
+  /// @brief オブジェクトの要素を得る．
+  JsonValue
+  get_value(
+    const std::string& key ///< [in] キー
+  ) const override;
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    JsonWriter& writer ///< [in] 出力先
+  ) const override;
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  dump(
+    JsonBinEncoder& enc ///< [in] 出力先
   ) const override;
 
   /// @brief 等価比較
@@ -532,51 +1439,36 @@ public:
     const JsonObj* right
   ) const override;
 
-};
-
+  /// @brief 実体を返す．
+  ///
+  /// 同じ要素を持つ JsonDict を返す．
+  const JsonObj*
+  resolve() const override;
 
-//////////////////////////////////////////////////////////////////////
-/// @class JsonBool JsonBool.h "JsonBool.h"
-/// @brief ブール型の false を表すクラス
-//////////////////////////////////////////////////////////////////////
-class JsonFalse :
-  public JsonObj
-{
-public:
 
-  /// @brief コンストラクタ
-  JsonFalse();
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
 
-  /// @brief デストラクタ
-  ~JsonFalse();
+  /// @brief ハッシュ値を計算する．
+  SizeType
+  compute_hash() const override;
 
 
-public:
+private:
   //////////////////////////////////////////////////////////////////////
-  // 外部インターフェイス
+  // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief ブール型の時 true を返す．
-  bool
-  is_bool() const override;
-
-  /// @brief ブール値を得る．
-  ///
-  /// - ブール型でない場合は無効
-  bool
-  get_bool() const override;
+  // 表
+  const JsonTable* mTable;
 
-  /// @brief 内容を JSON 文字列に変換する．
-  std::string
-  to_json(
-    int indent
-  ) const override;
+  // 行番号
+  SizeType mPos;
 
-  /// @brief 等価比較
-  bool
-  is_eq(
-    const JsonObj* right
-  ) const override;
+  // 同じ要素を持つ実体
+  mutable std::atomic<const JsonObj*> mBody{nullptr};
 
 };
 
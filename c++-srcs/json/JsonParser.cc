@@ -9,114 +9,404 @@
 #include "JsonParser.h"
 #include "JsonScanner.h"
 #include "JsonObj.h"
+#include "JsonDocument.h"
 #include "ym/JsonValue.h"
+#include "ym/JsonPointer.h"
+#include "ParallelFor.h"
 
 
 BEGIN_NAMESPACE_YM_JSON
 
-// @brief コンストラクタ
+BEGIN_NONAMESPACE
+
+// 複数のスレッドで読み込む入力の大きさの下限
+const SizeType PARALLEL_MIN_SIZE = 1024 * 1024;
+
+// 範囲の大きさの下限
+const SizeType MIN_RANGE_SIZE = 256 * 1024;
+
+// スレッドあたりの範囲数の目安
+const SizeType RANGE_PER_THREAD = 8;
+
+END_NONAMESPACE
+
+// @brief 入力ストリームを指定したコンストラクタ
 JsonParser::JsonParser(
   std::istream& s
 ) : mScanner{s}
 {
 }
 
+// @brief 入力バッファを指定したコンストラクタ
+JsonParser::JsonParser(
+  std::string_view buff
+) : mScanner{buff}
+{
+}
+
+// @brief 入力バッファの途中から読み込むコンストラクタ
+JsonParser::JsonParser(
+  std::string_view buff,
+  const JsonPos& pos,
+  JsonDocument* doc
+) : mScanner{buff, pos},
+    mDoc{doc}
+{
+  if ( mDoc != nullptr ) {
+    mDoc->inc_ref();
+  }
+}
+
+// @brief 遅延モードのコンストラクタ
+JsonParser::JsonParser(
+  JsonDocument* doc,
+  const JsonPos& pos,
+  JsonLazy* pending
+) : mScanner{doc->source(), pos},
+    mDoc{doc},
+    mLazy{true},
+    mPending{pending}
+{
+  mDoc->inc_ref();
+}
+
 // @brief デストラクタ
 JsonParser::~JsonParser()
 {
+  if ( mDoc != nullptr ) {
+    mDoc->dec_ref();
+  }
 }
 
 // @brief 読み込む．
 JsonValue
 JsonParser::read()
 {
-  auto obj = read_value();
+  // ノードはすべて mDoc のアリーナ上に確保する．
+  // 途中でエラーが起きた場合もデストラクタでアリーナごと解放される．
+  if ( mDoc == nullptr ) {
+    mDoc = new JsonDocument;
+    mDoc->inc_ref();
+  }
+  JsonValue value;
   auto tk = mScanner.read_token();
-  if ( tk != JsonToken::End ) {
-    error("syntax error");
+  if ( mLazy && (tk == JsonToken::LCB || tk == JsonToken::LBK) ) {
+    // 根は読み飛ばさない．
+    // 末尾の確認は根を最後まで読み込んだ時に行う．
+    value = mDoc->new_value<JsonLazy>(tk == JsonToken::LCB,
+				      mScanner.cur_pos(),
+				      mDoc->resource(),
+				      true);
+  }
+  else {
+    value = read_value(tk);
+    read_end();
+  }
+  // 根が文字列，配列，オブジェクトの場合は mDoc の所有権を共有する．
+  auto ans = JsonDocument::own(value);
+  mDoc->dec_ref();
+  mDoc = nullptr;
+  return ans;
+}
+
+// @brief 複数のスレッドで読み込む．
+JsonValue
+JsonParser::read_parallel(
+  std::string_view buff,
+  SizeType thread_num,
+  bool intern
+)
+{
+  thread_num = resolve_thread_num(thread_num);
+  if ( thread_num > 1 && buff.size() >= PARALLEL_MIN_SIZE ) {
+    try {
+      JsonParser parser{buff};
+      if ( parser.mScanner.read_token() == JsonToken::LBK ) {
+	auto size = std::max(buff.size() / (thread_num * RANGE_PER_THREAD),
+			     MIN_RANGE_SIZE);
+	std::vector<JsonPos> pos_list;
+	std::vector<SizeType> num_list;
+	parser.split_array(size, pos_list, num_list);
+	auto n = pos_list.size();
+	if ( n > 1 ) {
+	  // 根の配列は parser.mDoc 上に作り，
+	  // 各範囲の要素は範囲ごとの部分ドキュメント上に作る．
+	  // エラーの場合は parser のデストラクタでまとめて解放される．
+	  parser.mDoc = new JsonDocument;
+	  parser.mDoc->inc_ref();
+	  std::vector<SizeType> start_list(n);
+	  SizeType total = 0;
+	  for ( SizeType k = 0; k < n; ++ k ) {
+	    start_list[k] = total;
+	    total += num_list[k];
+	  }
+	  JsonArray::ArrayType array(total, parser.mDoc->resource());
+	  std::vector<JsonDocument*> sub_list(n);
+	  for ( auto& sub: sub_list ) {
+	    sub = new JsonDocument;
+	    parser.mDoc->add_sub(sub);
+	  }
+	  std::vector<std::exception_ptr> error_list(n);
+	  parallel_for(thread_num, n, [&](SizeType k) {
+	    try {
+	      JsonParser sub_parser{buff, pos_list[k], sub_list[k]};
+	      sub_parser.set_intern(intern);
+	      auto end = k + 1 < n ? &pos_list[k + 1] : nullptr;
+	      sub_parser.read_range(num_list[k], end, &array[start_list[k]]);
+	    }
+	    catch ( ... ) {
+	      error_list[k] = std::current_exception();
+	    }
+	  });
+	  if ( std::find_if(error_list.begin(), error_list.end(),
+			    [](const std::exception_ptr& e) { return e; })
+	       == error_list.end() ) {
+	    auto value = parser.mDoc->new_value<JsonArray>(std::move(array));
+	    return JsonDocument::own(value);
+	  }
+	}
+      }
+    }
+    catch ( std::invalid_argument& ) {
+      // 下で逐次に読み直してエラーを送出する．
+    }
   }
-  return JsonValue{obj};
+  JsonParser parser{buff};
+  parser.set_intern(intern);
+  return parser.read();
 }
 
-// @brief 値を読み込む．
-JsonObj*
-JsonParser::read_value()
+// @brief 経路の指す値を読み込む．
+JsonValue
+JsonParser::read_path(
+  const JsonPointer& path
+)
 {
+  if ( mDoc != nullptr ) {
+    mDoc->dec_ref();
+  }
+  mDoc = new JsonDocument;
+  mDoc->inc_ref();
+  for ( SizeType i = 0; i < path.size(); ++ i ) {
+    auto tk = mScanner.read_token();
+    bool found = false;
+    if ( tk == JsonToken::LCB ) {
+      found = seek_key(path.key(i));
+    }
+    else if ( tk == JsonToken::LBK ) {
+      auto index = path.index(i);
+      found = index != JsonPointer::NOT_INDEX && seek_index(index);
+    }
+    else {
+      // 配列でもオブジェクトでもない．
+      // 文法エラーの検出のために読み飛ばしておく．
+      skip_value(tk);
+    }
+    if ( !found ) {
+      return JsonValue::null();
+    }
+  }
+  auto value = read_value();
+  auto ans = JsonDocument::own(value);
+  mDoc->dec_ref();
+  mDoc = nullptr;
+  return ans;
+}
+
+// @brief オブジェクトの要素を一つ読み込む．
+bool
+JsonParser::read_item(
+  JsonDict::ItemListType& item_list,
+  bool first
+)
+{
+  skip_pending();
+  if ( !read_key(first) ) {
+    return false;
+  }
+  read_item_value(item_list);
+  return true;
+}
+
+// @brief 配列の要素を一つ読み込む．
+bool
+JsonParser::read_element(
+  JsonArray::ArrayType& array,
+  bool first
+)
+{
+  skip_pending();
   auto tk = mScanner.read_token();
+  if ( tk == JsonToken::RBK ) {
+    return false;
+  }
+  if ( first ) {
+    if ( tk == JsonToken::End ) {
+      // シンタックスエラー
+      error("unexpected EOF");
+    }
+  }
+  else {
+    if ( tk != JsonToken::Comma ) {
+      // シンタックスエラー
+      std::ostringstream buf;
+      buf << mScanner.cur_string()
+	  << ": illegal token, ',' is expected";
+      error(buf.str());
+    }
+    tk = mScanner.read_token();
+  }
+  array.push_back(read_value(tk));
+  return true;
+}
+
+// @brief 先頭のトークンを読んだ後で値を読み込む．
+JsonValue
+JsonParser::read_value(
+  JsonToken tk
+)
+{
   switch ( tk ) {
   case JsonToken::String:
-    return new JsonString{mScanner.cur_string()};
+    return mDoc->new_value<JsonString>(mScanner.cur_string(),
+				       mDoc->resource());
 
   case JsonToken::Int:
-    return new JsonInt{mScanner.cur_int()};
+    return JsonValue{mScanner.cur_int()};
 
   case JsonToken::Float:
-    return new JsonFloat{mScanner.cur_float()};
+    return JsonValue{mScanner.cur_float()};
 
   case JsonToken::LCB:
-    return read_object();
+    return mLazy ? read_lazy(tk) : read_object();
 
   case JsonToken::LBK:
-    return read_array();
+    return mLazy ? read_lazy(tk) : read_array();
 
   case JsonToken::True:
-    return new JsonTrue;
+    return JsonValue{true};
 
   case JsonToken::False:
-    return new JsonFalse;
+    return JsonValue{false};
 
   case JsonToken::Null:
-    return nullptr;
+    return JsonValue::null();
 
   default:
-    // シンタックスエラー
-    {
-      std::ostringstream buf;
-      buf << "'" << mScanner.cur_string() << "': unexpected token";
-      error(buf.str());
-    }
+    break;
   }
 
-  return nullptr;
+  // シンタックスエラー
+  std::ostringstream buf;
+  buf << "'" << mScanner.cur_string() << "': unexpected token";
+  error(buf.str());
 }
 
-// @brief オブジェクトを読み込む．
-JsonObj*
-JsonParser::read_object()
+// @brief 最上位の配列を要素の区切りで範囲に分割する．
+void
+JsonParser::split_array(
+  SizeType size,
+  std::vector<JsonPos>& pos_list,
+  std::vector<SizeType>& num_list
+)
 {
-  std::unordered_map<std::string, JsonValue> dict;
-  auto tk = mScanner.read_token();
-  if ( tk == JsonToken::RCB ) {
-    // 空のオブジェクト
-    auto obj = new JsonDict{dict};
-    return obj;
-  }
-  mScanner.unget_token(tk);
-  for ( ; ; ) {
+  auto pos = mScanner.cur_pos();
+  pos_list.push_back(pos);
+  auto limit = pos.mOffset + size;
+  SizeType num = 0;
+  for ( bool first = true; ; first = false ) {
     auto tk = mScanner.read_token();
-    if ( tk == JsonToken::String ) {
-      auto key = mScanner.cur_string();
-      tk = mScanner.read_token();
-      if ( tk != JsonToken::Colon ) {
-	// ':' ではなかった．
-	error("':' is expected");
+    if ( tk == JsonToken::RBK ) {
+      break;
+    }
+    if ( !first ) {
+      if ( tk != JsonToken::Comma ) {
+	error("syntax error");
       }
-      auto value = read_value();
-      dict.emplace(key, JsonValue{value});
+      pos = mScanner.cur_pos();
+      if ( pos.mOffset >= limit ) {
+	// ここで範囲を区切る．
+	num_list.push_back(num);
+	pos_list.push_back(pos);
+	num = 0;
+	limit = pos.mOffset + size;
+      }
+      tk = mScanner.read_token();
     }
-    else {
-      // シンタックスエラー
-      std::ostringstream buf;
-      buf << mScanner.cur_string()
-	  << ": illegal token, string is expected";
-      error(buf.str());
+    skip_value(tk);
+    ++ num;
+  }
+  num_list.push_back(num);
+}
+
+// @brief split_array() で求めた範囲の要素を読み込む．
+void
+JsonParser::read_range(
+  SizeType num,
+  const JsonPos* end,
+  JsonValue* dst
+)
+{
+  for ( SizeType i = 0; i < num; ++ i ) {
+    if ( i > 0 && mScanner.read_token() != JsonToken::Comma ) {
+      error("syntax error");
+    }
+    dst[i] = read_value();
+  }
+  auto tk = mScanner.read_token();
+  if ( end != nullptr ) {
+    // 次の範囲の直前で終わっていなければならない．
+    if ( tk != JsonToken::Comma ||
+	 mScanner.cur_pos().mOffset != end->mOffset ) {
+      error("syntax error");
+    }
+  }
+  else {
+    if ( tk != JsonToken::RBK ||
+	 mScanner.read_token() != JsonToken::End ) {
+      error("syntax error");
     }
+  }
+}
 
-    tk = mScanner.read_token();
-    if ( tk == JsonToken::RCB ) {
-      break;
+// @brief オブジェクトを読み込む．
+JsonValue
+JsonParser::read_object()
+{
+  // 要素のリストはアリーナ上に直接作ってノードにムーブする．
+  JsonDict::ItemListType item_list{mDoc->resource()};
+  for ( bool first = true; read_item(item_list, first); first = false ) {
+  }
+  return mDoc->new_value<JsonDict>(std::move(item_list), mIntern);
+}
+
+// @brief 配列を読み込む．
+JsonValue
+JsonParser::read_array()
+{
+  // 配列はアリーナ上に直接作ってノードにムーブする．
+  JsonArray::ArrayType array{mDoc->resource()};
+  auto value = read_table(array);
+  if ( value.is_null() ) {
+    // 表形式でなくなった要素の続きから読み込む．
+    while ( read_element(array, false) ) {
     }
+    value = mDoc->new_value<JsonArray>(std::move(array));
+  }
+  return value;
+}
 
+// @brief オブジェクトのキーを読み込む．
+bool
+JsonParser::read_key(
+  bool first
+)
+{
+  auto tk = mScanner.read_token();
+  if ( tk == JsonToken::RCB ) {
+    return false;
+  }
+  if ( !first ) {
     if ( tk != JsonToken::Comma ) {
       // シンタックスエラー
       std::ostringstream buf;
@@ -124,31 +414,100 @@ JsonParser::read_object()
 	  << ": illegal token, ',' is expected";
       error(buf.str());
     }
+    tk = mScanner.read_token();
   }
-  auto obj = new JsonDict{dict};
-  return obj;
+  if ( tk != JsonToken::String ) {
+    // シンタックスエラー
+    std::ostringstream buf;
+    buf << mScanner.cur_string()
+	<< ": illegal token, string is expected";
+    error(buf.str());
+  }
+  return true;
 }
 
-// @brief 配列を読み込む．
-JsonObj*
-JsonParser::read_array()
+// @brief キーを読んだ後で値を読み込んで要素を追加する．
+void
+JsonParser::read_item_value(
+  JsonDict::ItemListType& item_list
+)
+{
+  auto key = mIntern ?
+    mDoc->intern(mScanner.cur_string()) :
+    mDoc->copy_string(mScanner.cur_string());
+  auto tk = mScanner.read_token();
+  if ( tk != JsonToken::Colon ) {
+    // ':' ではなかった．
+    error("':' is expected");
+  }
+  auto value = read_value();
+  item_list.emplace_back(std::move(key), std::move(value));
+}
+
+// @brief 配列の先頭から表形式で読み込む．
+JsonValue
+JsonParser::read_table(
+  JsonArray::ArrayType& array
+)
 {
   auto tk = mScanner.read_token();
   if ( tk == JsonToken::RBK ) {
-    // 空の配列
-    auto obj = new JsonArray{{}};
-    return obj;
+    return mDoc->new_value<JsonArray>(std::move(array));
   }
   if ( tk == JsonToken::End ) {
     // シンタックスエラー
     error("unexpected EOF");
   }
+  if ( tk != JsonToken::LCB ) {
+    array.push_back(read_value(tk));
+    return JsonValue::null();
+  }
 
-  mScanner.unget_token(tk);
-  std::vector<JsonValue> array;
+  // 最初の要素のキーのリストを表の形とする．
+  // キーの重複したオブジェクトは表形式にしない．
+  JsonDict::ItemListType item_list{mDoc->resource()};
+  for ( bool first = true; read_item(item_list, first); first = false ) {
+  }
+  auto n = item_list.size();
+  bool ok = 0 < n && n <= JsonTable::MAX_COLUMNS;
+  for ( SizeType i = 0; ok && i < n; ++ i ) {
+    for ( SizeType j = 0; j < i; ++ j ) {
+      if ( item_list[i].first == item_list[j].first ) {
+	ok = false;
+	break;
+      }
+    }
+  }
+  if ( !ok ) {
+    array.push_back(mDoc->new_value<JsonDict>(std::move(item_list), mIntern));
+    return JsonValue::null();
+  }
+  JsonTable::KeyListType key_list{mDoc->resource()};
+  key_list.reserve(n);
+  std::vector<JsonTable::Column> column_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    key_list.push_back(item_list[i].first);
+    column_list[i].push_back(item_list[i].second);
+  }
+
+  // 読み込んだ行を JsonDict にして array に追加する．
+  auto flush = [&]() {
+    auto num = column_list.front().size();
+    array.reserve(num + 1);
+    for ( SizeType r = 0; r < num; ++ r ) {
+      JsonDict::ItemListType row_items{mDoc->resource()};
+      row_items.reserve(n);
+      for ( SizeType i = 0; i < n; ++ i ) {
+	row_items.emplace_back(key_list[i], column_list[i].get(r));
+      }
+      array.push_back(mDoc->new_value<JsonDict>(std::move(row_items),
+						mIntern));
+    }
+  };
+
+  std::vector<JsonValue> row;
+  row.reserve(n);
   for ( ; ; ) {
-    auto value = read_value();
-    array.push_back(JsonValue{value});
     tk = mScanner.read_token();
     if ( tk == JsonToken::RBK ) {
       break;
@@ -160,9 +519,238 @@ JsonParser::read_array()
 	  << ": illegal token, ',' is expected";
       error(buf.str());
     }
+    tk = mScanner.read_token();
+    if ( tk != JsonToken::LCB ) {
+      flush();
+      array.push_back(read_value(tk));
+      return JsonValue::null();
+    }
+    JsonValue value;
+    if ( !read_row(key_list, row, value) ) {
+      flush();
+      array.push_back(value);
+      return JsonValue::null();
+    }
+    for ( SizeType i = 0; i < n; ++ i ) {
+      column_list[i].push_back(row[i]);
+    }
+  }
+
+  if ( column_list.front().size() < JsonTable::MIN_ROWS ) {
+    // 行数が少ない場合は表形式にしない．
+    flush();
+    return mDoc->new_value<JsonArray>(std::move(array));
+  }
+  return mDoc->new_value<JsonTable>(std::move(key_list), column_list, mIntern);
+}
+
+// @brief 表の行となるオブジェクトを読み込む．
+bool
+JsonParser::read_row(
+  const JsonTable::KeyListType& key_list,
+  std::vector<JsonValue>& row,
+  JsonValue& value
+)
+{
+  auto n = key_list.size();
+  row.clear();
+  bool closed = false;
+  for ( bool first = true; ; first = false ) {
+    if ( !read_key(first) ) {
+      if ( row.size() == n ) {
+	return true;
+      }
+      closed = true;
+      break;
+    }
+    auto i = row.size();
+    if ( i == n || mScanner.cur_string() != key_list[i] ) {
+      break;
+    }
+    auto tk = mScanner.read_token();
+    if ( tk != JsonToken::Colon ) {
+      // ':' ではなかった．
+      error("':' is expected");
+    }
+    row.push_back(read_value());
+  }
+
+  // 形が一致しなかったので読み込んだ所までと残りから JsonDict を作る．
+  JsonDict::ItemListType item_list{mDoc->resource()};
+  for ( SizeType i = 0; i < row.size(); ++ i ) {
+    item_list.emplace_back(key_list[i], row[i]);
+  }
+  if ( !closed ) {
+    read_item_value(item_list);
+    while ( read_item(item_list, false) ) {
+    }
+  }
+  value = mDoc->new_value<JsonDict>(std::move(item_list), mIntern);
+  return false;
+}
+
+// @brief オブジェクト中のキーに対応する値の直前まで読み進める．
+bool
+JsonParser::seek_key(
+  const std::string& key
+)
+{
+  // 重複したキーは最初のものを用いる．
+  for ( bool first = true; ; first = false ) {
+    auto tk = mScanner.read_token();
+    if ( tk == JsonToken::RCB ) {
+      return false;
+    }
+    if ( !first ) {
+      if ( tk != JsonToken::Comma ) {
+	// シンタックスエラー
+	std::ostringstream buf;
+	buf << mScanner.cur_string()
+	    << ": illegal token, ',' is expected";
+	error(buf.str());
+      }
+      tk = mScanner.read_token();
+    }
+    if ( tk != JsonToken::String ) {
+      // シンタックスエラー
+      std::ostringstream buf;
+      buf << mScanner.cur_string()
+	  << ": illegal token, string is expected";
+      error(buf.str());
+    }
+    bool match = mScanner.cur_string() == key;
+    tk = mScanner.read_token();
+    if ( tk != JsonToken::Colon ) {
+      // ':' ではなかった．
+      error("':' is expected");
+    }
+    if ( match ) {
+      return true;
+    }
+    skip_value(mScanner.read_token());
   }
-  auto obj = new JsonArray{array};
-  return obj;
+}
+
+// @brief 配列中の指定された位置の要素の直前まで読み進める．
+bool
+JsonParser::seek_index(
+  SizeType pos
+)
+{
+  for ( SizeType i = 0; ; ++ i ) {
+    auto tk = mScanner.read_token();
+    if ( tk == JsonToken::RBK ) {
+      return false;
+    }
+    if ( i == 0 ) {
+      if ( tk == JsonToken::End ) {
+	// シンタックスエラー
+	error("unexpected EOF");
+      }
+    }
+    else {
+      if ( tk != JsonToken::Comma ) {
+	// シンタックスエラー
+	std::ostringstream buf;
+	buf << mScanner.cur_string()
+	    << ": illegal token, ',' is expected";
+	error(buf.str());
+      }
+      tk = mScanner.read_token();
+    }
+    if ( i == pos ) {
+      mScanner.unget_token(tk);
+      return true;
+    }
+    skip_value(tk);
+  }
+}
+
+// @brief 値を読み飛ばす．
+void
+JsonParser::skip_value(
+  JsonToken tk
+)
+{
+  switch ( tk ) {
+  case JsonToken::LCB:
+  case JsonToken::LBK:
+    if ( !mScanner.skip_container() ) {
+      // シンタックスエラー
+      error("unexpected EOF");
+    }
+    return;
+
+  case JsonToken::String:
+  case JsonToken::Int:
+  case JsonToken::Float:
+  case JsonToken::True:
+  case JsonToken::False:
+  case JsonToken::Null:
+    return;
+
+  default:
+    break;
+  }
+
+  // シンタックスエラー
+  std::ostringstream buf;
+  buf << "'" << mScanner.cur_string() << "': unexpected token";
+  error(buf.str());
+}
+
+// @brief 現在の配列かオブジェクトの残りを読み飛ばす．
+void
+JsonParser::skip_rest()
+{
+  skip_pending();
+  if ( !mScanner.skip_container() ) {
+    // シンタックスエラー
+    error("unexpected EOF");
+  }
+}
+
+// @brief 入力の末尾であることを確かめる．
+void
+JsonParser::read_end()
+{
+  if ( mScanner.read_token() != JsonToken::End ) {
+    error("syntax error");
+  }
+}
+
+// @brief 読み飛ばしていない JsonLazy の残りを読み飛ばす．
+void
+JsonParser::skip_pending()
+{
+  if ( mPending == nullptr ) {
+    return;
+  }
+  auto obj = mPending;
+  mPending = nullptr;
+  if ( obj->untouched() ) {
+    // 開き括弧の直後にいるのでそのまま読み飛ばす．
+    if ( !mScanner.skip_container() ) {
+      // シンタックスエラー
+      error("unexpected EOF");
+    }
+  }
+  else {
+    // 読み込みが進んでいる場合はその続きから読み飛ばす．
+    mScanner.seek(obj->end_pos());
+  }
+}
+
+// @brief 配列かオブジェクトの JsonLazy を作る．
+JsonValue
+JsonParser::read_lazy(
+  JsonToken tk
+)
+{
+  mPending = mDoc->new_obj<JsonLazy>(tk == JsonToken::LCB,
+				     mScanner.cur_pos(),
+				     mDoc->resource());
+  return JsonDocument::borrow(mPending);
 }
 
 // @brief エラーを出力する．
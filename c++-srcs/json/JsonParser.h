@@ -10,26 +10,60 @@
 
 #include "ym/json.h"
 #include "JsonScanner.h"
+#include "JsonObj.h"
 
 
 BEGIN_NAMESPACE_YM_JSON
 
-class JsonObj;
+class JsonDocument;
 class Region;
 
 //////////////////////////////////////////////////////////////////////
 /// @class JsonParser JsonParser.h "JsonParser.h"
 /// @brief json のパーサークラス
+///
+/// 遅延モードでは配列とオブジェクトの中身を読み飛ばして
+/// JsonLazy を作る．
+/// 遅延モードの入力は JsonDocument が保持する．
 //////////////////////////////////////////////////////////////////////
 class JsonParser
 {
 public:
 
-  /// @brief コンストラクタ
+  /// @brief 入力ストリームを指定したコンストラクタ
   JsonParser(
     std::istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief 入力バッファを指定したコンストラクタ
+  ///
+  /// buff の内容はこのオブジェクトが存在する間は有効でなければならない．
+  JsonParser(
+    std::string_view buff ///< [in] 入力バッファ
+  );
+
+  /// @brief 入力バッファの途中から読み込むコンストラクタ
+  ///
+  /// buff の pos の位置から buff の末尾までを読み込む．
+  /// エラーメッセージの位置は pos を基準としたものとなる．
+  /// doc を指定した場合は作られたノードは doc 上に置かれる．
+  JsonParser(
+    std::string_view buff,      ///< [in] 入力バッファ
+    const JsonPos& pos,         ///< [in] 開始位置
+    JsonDocument* doc = nullptr ///< [in] ドキュメント
+  );
+
+  /// @brief 遅延モードのコンストラクタ
+  ///
+  /// doc の入力の pos の位置から読み込む．
+  /// 作られたノードは doc 上に置かれる．
+  /// pending は pending() で得たもので，次の要素を読む前に読み飛ばす．
+  JsonParser(
+    JsonDocument* doc,            ///< [in] ドキュメント
+    const JsonPos& pos = {},      ///< [in] 開始位置
+    JsonLazy* pending = nullptr   ///< [in] 読み飛ばしていない要素
+  );
+
   /// @brief デストラクタ
   ~JsonParser();
 
@@ -39,10 +73,104 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief オブジェクトのキーを JsonDocument に登録するか設定する．
+  ///
+  /// true の場合，同じ内容のキーは JsonDocument::intern() で
+  /// 一つの領域を共有する．
+  /// 遅延モードでは JsonLazy の展開と探索が並行に行われる可能性が
+  /// あるので常に false となる．
+  void
+  set_intern(
+    bool intern ///< [in] キーを登録する時 true
+  )
+  {
+    mIntern = intern && !mLazy;
+  }
+
   /// @brief 読み込む．
+  ///
+  /// 遅延モードで根が配列かオブジェクトの場合は
+  /// 全体を読み飛ばさずに JsonLazy を作る．
+  /// この場合，末尾の文法チェックは根の JsonLazy を最後まで
+  /// 読み込んだ時に行う．
   JsonValue
   read();
 
+  /// @brief 複数のスレッドで読み込む．
+  ///
+  /// 根が配列の場合は先に要素の区切りだけを走査して
+  /// 一定の大きさの範囲に分割し，各範囲を別々のスレッドで読み込む．
+  /// 根が配列でない場合と入力が小さい場合は通常の読み込みを行う．
+  /// 文法エラーがあった場合は逐次に読み直して
+  /// read() と同じ例外を送出する．
+  static
+  JsonValue
+  read_parallel(
+    std::string_view buff, ///< [in] 入力バッファ
+    SizeType thread_num,   ///< [in] スレッド数
+                           ///<      0 の時はハードウェアのスレッド数
+    bool intern = false    ///< [in] キーを登録する時 true
+  );
+
+  /// @brief 経路の指す値を読み込む．
+  /// @return 値が存在しない場合は null を返す．
+  ///
+  /// 経路上にない値は読み飛ばす．
+  /// 経路の指す値の後ろの部分は読まない．
+  JsonValue
+  read_path(
+    const JsonPointer& path ///< [in] 経路
+  );
+
+  /// @brief オブジェクトの要素を一つ読み込む．
+  /// @return 要素を読み込んだ時 true を返す．
+  ///
+  /// '}' を読んだ時は false を返す．
+  bool
+  read_item(
+    JsonDict::ItemListType& item_list, ///< [inout] 要素のリスト
+    bool first                         ///< [in] '{' の直後の時 true
+  );
+
+  /// @brief 配列の要素を一つ読み込む．
+  /// @return 要素を読み込んだ時 true を返す．
+  ///
+  /// ']' を読んだ時は false を返す．
+  bool
+  read_element(
+    JsonArray::ArrayType& array, ///< [inout] 要素のリスト
+    bool first                   ///< [in] '[' の直後の時 true
+  );
+
+  /// @brief 現在の配列かオブジェクトの残りを読み飛ばす．
+  void
+  skip_rest();
+
+  /// @brief 入力の末尾であることを確かめる．
+  ///
+  /// 根の値の後ろに余分な内容がある場合は
+  /// std::invalid_argument 例外を送出する．
+  void
+  read_end();
+
+  /// @brief 次に読み出す位置を返す．
+  JsonPos
+  cur_pos() const
+  {
+    return mScanner.cur_pos();
+  }
+
+  /// @brief 直前に読んだ要素が読み飛ばしていない JsonLazy の場合にそれを返す．
+  ///
+  /// 遅延モードでは要素の JsonLazy は作った時点では読み飛ばさずに
+  /// 次の要素を読む時に読み飛ばす．
+  /// そのため cur_pos() は JsonLazy の開き括弧の直後の位置となる．
+  JsonLazy*
+  pending() const
+  {
+    return mPending;
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -50,18 +178,130 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 値を読み込む．
-  JsonObj*
-  read_value();
+  JsonValue
+  read_value()
+  {
+    return read_value(mScanner.read_token());
+  }
+
+  /// @brief 先頭のトークンを読んだ後で値を読み込む．
+  JsonValue
+  read_value(
+    JsonToken tk ///< [in] 先頭のトークン
+  );
+
+  /// @brief 最上位の配列を要素の区切りで範囲に分割する．
+  ///
+  /// '[' を読んだ直後に呼ばれる．
+  /// 要素は値の先頭のトークン以外は読み飛ばす．
+  /// 各範囲の先頭の位置と要素数を pos_list と num_list に追加する．
+  void
+  split_array(
+    SizeType size,                  ///< [in] 範囲の大きさの目安
+    std::vector<JsonPos>& pos_list, ///< [out] 範囲の先頭の位置のリスト
+    std::vector<SizeType>& num_list ///< [out] 範囲の要素数のリスト
+  );
+
+  /// @brief split_array() で求めた範囲の要素を読み込む．
+  ///
+  /// 範囲の先頭から呼ばれる．
+  /// 範囲の後ろの ',' までか最後の範囲の場合は入力の末尾まで読み込む．
+  void
+  read_range(
+    SizeType num,       ///< [in] 要素数
+    const JsonPos* end, ///< [in] 次の範囲の先頭の位置
+                        ///<      最後の範囲の場合は nullptr
+    JsonValue* dst      ///< [out] 読み込んだ要素を格納する領域
+  );
 
   /// @brief オブジェクトを読み込む．
-  JsonObj*
+  JsonValue
   read_object();
 
   /// @brief 配列を読み込む．
-  JsonObj*
+  JsonValue
   read_array();
 
+  /// @brief オブジェクトのキーを読み込む．
+  /// @return キーを読み込んだ時 true を返す．
+  ///
+  /// '}' を読んだ時は false を返す．
+  /// キーは mScanner.cur_string() で得られる．
+  bool
+  read_key(
+    bool first ///< [in] '{' の直後の時 true
+  );
+
+  /// @brief キーを読んだ後で値を読み込んで要素を追加する．
+  void
+  read_item_value(
+    JsonDict::ItemListType& item_list ///< [inout] 要素のリスト
+  );
+
+  /// @brief 配列の先頭から表形式で読み込む．
+  /// @return 配列の最後まで読み込んだ時はその値を返す．
+  ///
+  /// '[' を読んだ直後に呼ばれる．
+  /// 要素が同じキーを同じ順に持つオブジェクトの間は JsonTable の
+  /// 列に読み込む．
+  /// そうでない要素が現れた場合はそれまでの要素を JsonDict にして
+  /// array に追加し，その要素まで読み込んで null を返す．
+  JsonValue
+  read_table(
+    JsonArray::ArrayType& array ///< [inout] 要素のリスト
+  );
+
+  /// @brief 表の行となるオブジェクトを読み込む．
+  /// @return 表の形と一致した時 true を返す．
+  ///
+  /// '{' を読んだ直後に呼ばれる．
+  /// 一致した場合は値を row に入れる．
+  /// 一致しなかった場合は残りを読み込んで作った JsonDict を value に入れる．
+  bool
+  read_row(
+    const JsonTable::KeyListType& key_list, ///< [in] 表の形
+    std::vector<JsonValue>& row,            ///< [out] 値のリスト
+    JsonValue& value                        ///< [out] 一致しなかった時の値
+  );
+
+  /// @brief オブジェクト中のキーに対応する値の直前まで読み進める．
+  /// @return キーが見つからなかった時 false を返す．
+  ///
+  /// '{' を読んだ直後に呼ばれる．
+  bool
+  seek_key(
+    const std::string& key ///< [in] キー
+  );
+
+  /// @brief 配列中の指定された位置の要素の直前まで読み進める．
+  /// @return 要素が存在しなかった時 false を返す．
+  ///
+  /// '[' を読んだ直後に呼ばれる．
+  bool
+  seek_index(
+    SizeType pos ///< [in] 位置番号
+  );
+
+  /// @brief 値を読み飛ばす．
+  void
+  skip_value(
+    JsonToken tk ///< [in] 先頭のトークン
+  );
+
+  /// @brief 読み飛ばしていない JsonLazy の残りを読み飛ばす．
+  void
+  skip_pending();
+
+  /// @brief 配列かオブジェクトの JsonLazy を作る．
+  ///
+  /// 中身はまだ読み飛ばさない．
+  JsonValue
+  read_lazy(
+    JsonToken tk ///< [in] 先頭のトークン(LCB か LBK)
+  );
+
   /// @brief エラーを出力する．
+  [[noreturn]]
   void
   error(
     const std::string& msg ///< [in] メッセージ
@@ -76,6 +316,20 @@ private:
   // スキャナー
   JsonScanner mScanner;
 
+  // 読み込み中のドキュメント
+  //
+  // 読み込み中はこのオブジェクトが参照回数を一つ持つ．
+  JsonDocument* mDoc{nullptr};
+
+  // 遅延モードの時 true
+  bool mLazy{false};
+
+  // オブジェクトのキーを登録する時 true
+  bool mIntern{false};
+
+  // 読み飛ばしていない JsonLazy
+  JsonLazy* mPending{nullptr};
+
 };
 
 END_NAMESPACE_YM_JSON
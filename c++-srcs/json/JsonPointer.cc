@@ -0,0 +1,143 @@
+
+/// @file JsonPointer.cc
+/// @brief JsonPointer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonPointer.h"
+#include "JsonParser.h"
+#include "MappedFile.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+// 参照トークンを配列の位置として解釈する．
+SizeType
+to_index(
+  const std::string& key
+)
+{
+  if ( key.empty() || (key[0] == '0' && key.size() > 1) ) {
+    return JsonPointer::NOT_INDEX;
+  }
+  SizeType index = 0;
+  for ( auto c: key ) {
+    if ( c < '0' || '9' < c ) {
+      return JsonPointer::NOT_INDEX;
+    }
+    auto next = index * 10 + (c - '0');
+    if ( next / 10 != index ) {
+      // 桁あふれ
+      return JsonPointer::NOT_INDEX;
+    }
+    index = next;
+  }
+  return index;
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonPointer
+//////////////////////////////////////////////////////////////////////
+
+const SizeType JsonPointer::NOT_INDEX;
+
+// @brief コンストラクタ
+JsonPointer::JsonPointer(
+  std::string_view path
+) : mPath{path}
+{
+  if ( path.empty() ) {
+    return;
+  }
+  if ( path[0] != '/' ) {
+    std::ostringstream buf;
+    buf << path << ": invalid JSON pointer, '/' is expected";
+    throw std::invalid_argument{buf.str()};
+  }
+  std::string key;
+  for ( SizeType i = 1; i <= path.size(); ++ i ) {
+    if ( i == path.size() || path[i] == '/' ) {
+      mIndexList.push_back(to_index(key));
+      mKeyList.push_back(std::move(key));
+      key.clear();
+      continue;
+    }
+    char c = path[i];
+    if ( c == '~' ) {
+      ++ i;
+      if ( i < path.size() && path[i] == '0' ) {
+	c = '~';
+      }
+      else if ( i < path.size() && path[i] == '1' ) {
+	c = '/';
+      }
+      else {
+	std::ostringstream buf;
+	buf << path << ": invalid JSON pointer, illegal escape sequence";
+	throw std::invalid_argument{buf.str()};
+      }
+    }
+    key += c;
+  }
+}
+
+// @brief 値の中から経路の指す値を取り出す．
+JsonValue
+JsonPointer::get(
+  const JsonValue& value
+) const
+{
+  auto cur = value;
+  for ( SizeType i = 0; i < size(); ++ i ) {
+    if ( cur.is_object() ) {
+      cur = cur.get(mKeyList[i]);
+    }
+    else if ( cur.is_array() ) {
+      auto index = mIndexList[i];
+      if ( index == NOT_INDEX ) {
+	return JsonValue::null();
+      }
+      // 遅延モードの配列の size() は全体を読み込んでしまうので
+      // 範囲外の例外で判定する．
+      try {
+	cur = cur.at(index);
+      }
+      catch ( std::out_of_range& ) {
+	return JsonValue::null();
+      }
+    }
+    else {
+      return JsonValue::null();
+    }
+  }
+  return cur;
+}
+
+// @brief JSON文字列から経路の指す値を取り出す．
+JsonValue
+JsonPointer::parse(
+  std::string_view json_str
+) const
+{
+  JsonParser parser{json_str};
+  return parser.read_path(*this);
+}
+
+// @brief ファイルから経路の指す値を取り出す．
+JsonValue
+JsonPointer::read(
+  const std::string& filename
+) const
+{
+  MappedFile file{filename};
+  JsonParser parser{file.view()};
+  return parser.read_path(*this);
+}
+
+END_NAMESPACE_YM_JSON
@@ -0,0 +1,413 @@
+
+/// @file JsonPushParser.cc
+/// @brief JsonPushParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonPushParser.h"
+#include "JsonParser.h"
+#include "JsonSimd.h"
+#include <algorithm>
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+// トップレベルの数値などの終わりを表す文字の時 true を返す．
+inline
+bool
+is_delimiter(
+  char c
+)
+{
+  switch ( c ) {
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\r':
+  case '{':
+  case '}':
+  case '[':
+  case ']':
+  case ',':
+  case ':':
+  case '"':
+  case '\'':
+  case '#':
+  case '/':
+    return true;
+  default:
+    return false;
+  }
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonPushParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+JsonPushParser::JsonPushParser(
+  const Callback& callback
+) : mCallback{callback}
+{
+}
+
+// @brief デストラクタ
+JsonPushParser::~JsonPushParser()
+{
+}
+
+// @brief 入力を追加する．
+void
+JsonPushParser::feed(
+  const char* data,
+  SizeType size
+)
+{
+  mBuff.append(data, size);
+  try {
+    scan(false);
+  }
+  catch ( ... ) {
+    discard();
+    throw;
+  }
+  discard();
+}
+
+// @brief 入力の終わりを知らせる．
+void
+JsonPushParser::finish()
+{
+  scan(true);
+  if ( mStart != std::string::npos ) {
+    // 完結していない値は末尾までを読み込む．
+    // 数値などの場合はこれで完結し，それ以外はエラーとなる．
+    emit_value(mBuff.size());
+  }
+  reset();
+}
+
+// @brief バッファを走査して完結した値を読み込む．
+void
+JsonPushParser::scan(
+  bool last
+)
+{
+  const char* begin = mBuff.data();
+  const char* end = begin + mBuff.size();
+  const char* p = begin + mPos;
+  // 次の文字を見ないと判断できない場合は last でなければ
+  // その位置で走査を中断して次の入力を待つ．
+  auto need_next = [&](const char* p) {
+    return p + 1 == end && !last;
+  };
+  while ( p < end ) {
+    switch ( mState ) {
+    case State::Blank:
+      {
+	p = JsonSimd::skip_blank(p, end);
+	if ( p == end ) {
+	  break;
+	}
+	auto c = *p;
+	if ( c == '\n' ) {
+	  ++ p;
+	  break;
+	}
+	if ( c == '\r' ) {
+	  // '\r\n' が分割された場合に行番号を二重に数えないように
+	  // 次の文字が来るまで待つ．
+	  if ( need_next(p) ) {
+	    mPos = p - begin;
+	    return;
+	  }
+	  ++ p;
+	  break;
+	}
+	if ( c == '#' ) {
+	  mCommentReturn = State::Blank;
+	  mState = State::LineComment;
+	  ++ p;
+	  break;
+	}
+	if ( c == '/' ) {
+	  if ( need_next(p) ) {
+	    mPos = p - begin;
+	    return;
+	  }
+	  if ( p + 1 < end && (p[1] == '/' || p[1] == '*') ) {
+	    mCommentReturn = State::Blank;
+	    mState = p[1] == '/' ? State::LineComment : State::BlockComment;
+	    p += 2;
+	    break;
+	  }
+	}
+	auto pos = p - begin;
+	++ p;
+	switch ( c ) {
+	case '{':
+	case '[':
+	  start_value(pos, State::Container);
+	  mDepth = 1;
+	  break;
+
+	case '"':
+	case '\'':
+	  start_value(pos, State::String);
+	  mQuote = c;
+	  break;
+
+	case '}':
+	case ']':
+	case ',':
+	case ':':
+	  // 値の先頭になり得ない文字はそれだけで値とみなして
+	  // パーサーにエラーを出させる．
+	  start_value(pos, State::Blank);
+	  emit_value(pos + 1);
+	  break;
+
+	default:
+	  start_value(pos, State::Scalar);
+	  break;
+	}
+      }
+      break;
+
+    case State::Scalar:
+      while ( p < end && !is_delimiter(*p) ) {
+	++ p;
+      }
+      if ( p < end ) {
+	emit_value(p - begin);
+      }
+      break;
+
+    case State::Container:
+      p = JsonSimd::find_structural(p, end);
+      if ( p == end ) {
+	break;
+      }
+      switch ( *p ) {
+      case '{':
+      case '[':
+	++ mDepth;
+	++ p;
+	break;
+
+      case '}':
+      case ']':
+	++ p;
+	-- mDepth;
+	if ( mDepth == 0 ) {
+	  emit_value(p - begin);
+	}
+	break;
+
+      case '"':
+      case '\'':
+	mQuote = *p;
+	mState = State::String;
+	++ p;
+	break;
+
+      case '#':
+	mCommentReturn = State::Container;
+	mState = State::LineComment;
+	++ p;
+	break;
+
+      case '/':
+	if ( need_next(p) ) {
+	  mPos = p - begin;
+	  return;
+	}
+	if ( p + 1 < end && (p[1] == '/' || p[1] == '*') ) {
+	  mCommentReturn = State::Container;
+	  mState = p[1] == '/' ? State::LineComment : State::BlockComment;
+	  p += 2;
+	}
+	else {
+	  ++ p;
+	}
+	break;
+
+      default:
+	// 改行文字
+	++ p;
+	break;
+      }
+      break;
+
+    case State::String:
+      p = JsonSimd::find_string_special(p, end, mQuote);
+      if ( p == end ) {
+	break;
+      }
+      if ( *p == mQuote ) {
+	++ p;
+	if ( mDepth == 0 ) {
+	  emit_value(p - begin);
+	}
+	else {
+	  mState = State::Container;
+	}
+      }
+      else if ( *p == '\\' ) {
+	// エスケープされた文字は調べない．
+	if ( need_next(p) ) {
+	  mPos = p - begin;
+	  return;
+	}
+	p = std::min(p + 2, end);
+      }
+      else {
+	++ p;
+      }
+      break;
+
+    case State::LineComment:
+      while ( p < end && *p != '\n' && *p != '\r' ) {
+	++ p;
+      }
+      if ( p < end ) {
+	// 改行文字は戻った先の状態で処理する．
+	mState = mCommentReturn;
+      }
+      break;
+
+    case State::BlockComment:
+      p = static_cast<const char*>(std::memchr(p, '*', end - p));
+      if ( p == nullptr ) {
+	p = end;
+	break;
+      }
+      if ( need_next(p) ) {
+	mPos = p - begin;
+	return;
+      }
+      if ( p + 1 < end && p[1] == '/' ) {
+	mState = mCommentReturn;
+	p += 2;
+      }
+      else {
+	++ p;
+      }
+      break;
+    }
+  }
+  mPos = p - begin;
+}
+
+// @brief 値の始まりを記録する．
+void
+JsonPushParser::start_value(
+  SizeType pos,
+  State state
+)
+{
+  count_lines(pos);
+  mStart = pos;
+  mState = state;
+}
+
+// @brief 完結した値を読み込んで callback を呼び出す．
+void
+JsonPushParser::emit_value(
+  SizeType end
+)
+{
+  // 値の途中では行番号を数えないので mLine は先頭の行番号となる．
+  auto start = mStart;
+  auto line = mLine;
+  // 行の先頭は取り除かれている場合がある．
+  // 符号なし整数の演算なので，その場合も列番号は正しく求まる．
+  auto top = mTop - mBase;
+
+  // エラーの場合も値を読み捨てるように先に状態を戻しておく．
+  mStart = std::string::npos;
+  mPos = end;
+  mState = State::Blank;
+  mDepth = 0;
+
+  JsonParser parser{std::string_view{mBuff}.substr(0, end),
+		    JsonPos{start, static_cast<int>(line), top}};
+  auto value = parser.read();
+  mCallback(line, value);
+}
+
+// @brief 行番号を pos の位置まで進める．
+void
+JsonPushParser::count_lines(
+  SizeType pos
+)
+{
+  auto begin = mBuff.data();
+  auto p = begin + mLinePos;
+  auto end = begin + pos;
+  for ( ; p < end; ++ p ) {
+    auto c = *p;
+    if ( c == '\r' ) {
+      if ( p + 1 == begin + mBuff.size() ) {
+	// '\r\n' かどうかわからないので次の入力まで待つ．
+	break;
+      }
+      if ( p[1] == '\n' ) {
+	// '\n' の方で数える．
+	continue;
+      }
+    }
+    else if ( c != '\n' ) {
+      continue;
+    }
+    ++ mLine;
+    mTop = mBase + (p + 1 - begin);
+  }
+  mLinePos = p - begin;
+}
+
+// @brief 走査済みの部分をバッファから取り除く．
+void
+JsonPushParser::discard()
+{
+  if ( mStart == std::string::npos ) {
+    count_lines(mPos);
+  }
+  // 読み込み途中の値がある場合は mLinePos は値の先頭を指している．
+  auto n = mLinePos;
+  if ( n == 0 ) {
+    return;
+  }
+  mBuff.erase(0, n);
+  mBase += n;
+  mPos -= n;
+  if ( mStart != std::string::npos ) {
+    mStart -= n;
+  }
+  mLinePos = 0;
+}
+
+// @brief 初期状態に戻す．
+void
+JsonPushParser::reset()
+{
+  mBuff.clear();
+  mBase = 0;
+  mPos = 0;
+  mStart = std::string::npos;
+  mState = State::Blank;
+  mDepth = 0;
+  mLinePos = 0;
+  mLine = 1;
+  mTop = 0;
+}
+
+END_NAMESPACE_YM_JSON
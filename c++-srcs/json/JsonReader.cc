@@ -0,0 +1,260 @@
+
+/// @file JsonReader.cc
+/// @brief JsonReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonReader.h"
+#include "ym/JsonHandler.h"
+#include "JsonScanner.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力ストリームを指定したコンストラクタ
+JsonReader::JsonReader(
+  std::istream& s
+) : mScanner{new JsonScanner{s}}
+{
+}
+
+// @brief 入力バッファを指定したコンストラクタ
+JsonReader::JsonReader(
+  std::string_view buff
+) : mScanner{new JsonScanner{buff}}
+{
+}
+
+// @brief デストラクタ
+JsonReader::~JsonReader()
+{
+}
+
+// @brief 次のイベントを読み出す．
+JsonEvent
+JsonReader::next()
+{
+  // 文法は JsonParser と同一で，エラーメッセージも同じものを用いる．
+  if ( mStack.empty() ) {
+    if ( mDone ) {
+      return mLastEvent = JsonEvent::End;
+    }
+    if ( !mStarted ) {
+      mStarted = true;
+      return mLastEvent = value_event(mScanner->read_token());
+    }
+    auto tk = mScanner->read_token();
+    if ( tk != JsonToken::End ) {
+      error("syntax error");
+    }
+    mDone = true;
+    return mLastEvent = JsonEvent::End;
+  }
+
+  auto& state = mStack.back();
+  switch ( state ) {
+  case ObjFirst:
+    {
+      auto tk = mScanner->read_token();
+      if ( tk == JsonToken::RCB ) {
+	// 空のオブジェクト
+	mStack.pop_back();
+	return mLastEvent = JsonEvent::EndObject;
+      }
+      return mLastEvent = read_key(tk);
+    }
+
+  case ObjKey:
+    return mLastEvent = read_key(mScanner->read_token());
+
+  case ObjValue:
+    state = ObjNext;
+    return mLastEvent = value_event(mScanner->read_token());
+
+  case ObjNext:
+    {
+      auto tk = mScanner->read_token();
+      if ( tk == JsonToken::RCB ) {
+	mStack.pop_back();
+	return mLastEvent = JsonEvent::EndObject;
+      }
+      if ( tk != JsonToken::Comma ) {
+	// シンタックスエラー
+	std::ostringstream buf;
+	buf << mScanner->cur_string()
+	    << ": illegal token, ',' is expected";
+	error(buf.str());
+      }
+      return mLastEvent = read_key(mScanner->read_token());
+    }
+
+  case ArrFirst:
+    {
+      auto tk = mScanner->read_token();
+      if ( tk == JsonToken::RBK ) {
+	// 空の配列
+	mStack.pop_back();
+	return mLastEvent = JsonEvent::EndArray;
+      }
+      if ( tk == JsonToken::End ) {
+	// シンタックスエラー
+	error("unexpected EOF");
+      }
+      state = ArrNext;
+      return mLastEvent = value_event(tk);
+    }
+
+  case ArrNext:
+    {
+      auto tk = mScanner->read_token();
+      if ( tk == JsonToken::RBK ) {
+	mStack.pop_back();
+	return mLastEvent = JsonEvent::EndArray;
+      }
+      if ( tk != JsonToken::Comma ) {
+	// シンタックスエラー
+	std::ostringstream buf;
+	buf << mScanner->cur_string()
+	    << ": illegal token, ',' is expected";
+	error(buf.str());
+      }
+      return mLastEvent = value_event(mScanner->read_token());
+    }
+  }
+  ASSERT_NOT_REACHED;
+  return JsonEvent::End;
+}
+
+// @brief 直前の StartObject/StartArray に対応する終わりまで読み飛ばす．
+void
+JsonReader::skip()
+{
+  if ( mLastEvent != JsonEvent::StartObject &&
+       mLastEvent != JsonEvent::StartArray ) {
+    return;
+  }
+  auto target = mStack.size() - 1;
+  while ( mStack.size() > target ) {
+    next();
+  }
+}
+
+// @brief 全てのイベントを handler に送る．
+void
+JsonReader::parse(
+  JsonHandler& handler
+)
+{
+  for ( ; ; ) {
+    switch ( next() ) {
+    case JsonEvent::StartObject: handler.on_start_object(); break;
+    case JsonEvent::EndObject:   handler.on_end_object(); break;
+    case JsonEvent::StartArray:  handler.on_start_array(); break;
+    case JsonEvent::EndArray:    handler.on_end_array(); break;
+    case JsonEvent::Key:         handler.on_key(key()); break;
+    case JsonEvent::Null:        handler.on_null(); break;
+    case JsonEvent::Bool:        handler.on_bool(bool_value()); break;
+    case JsonEvent::Int:         handler.on_int(int_value()); break;
+    case JsonEvent::Float:       handler.on_float(float_value()); break;
+    case JsonEvent::String:      handler.on_string(string_value()); break;
+    case JsonEvent::End:         return;
+    }
+  }
+}
+
+// @brief 直前の String イベントの文字列を返す．
+std::string_view
+JsonReader::string_value() const
+{
+  return mScanner->cur_string();
+}
+
+// @brief 値の先頭のトークンからイベントを作る．
+JsonEvent
+JsonReader::value_event(
+  JsonToken tk
+)
+{
+  switch ( tk ) {
+  case JsonToken::String:
+    return JsonEvent::String;
+
+  case JsonToken::Int:
+    mInt = mScanner->cur_int();
+    return JsonEvent::Int;
+
+  case JsonToken::Float:
+    mFloat = mScanner->cur_float();
+    return JsonEvent::Float;
+
+  case JsonToken::LCB:
+    mStack.push_back(ObjFirst);
+    return JsonEvent::StartObject;
+
+  case JsonToken::LBK:
+    mStack.push_back(ArrFirst);
+    return JsonEvent::StartArray;
+
+  case JsonToken::True:
+    mBool = true;
+    return JsonEvent::Bool;
+
+  case JsonToken::False:
+    mBool = false;
+    return JsonEvent::Bool;
+
+  case JsonToken::Null:
+    return JsonEvent::Null;
+
+  default:
+    break;
+  }
+  // シンタックスエラー
+  std::ostringstream buf;
+  buf << "'" << mScanner->cur_string() << "': unexpected token";
+  error(buf.str());
+}
+
+// @brief オブジェクトのキーを読み込む．
+JsonEvent
+JsonReader::read_key(
+  JsonToken tk
+)
+{
+  if ( tk != JsonToken::String ) {
+    // シンタックスエラー
+    std::ostringstream buf;
+    buf << mScanner->cur_string()
+	<< ": illegal token, string is expected";
+    error(buf.str());
+  }
+  // ':' を読むと cur_string() が上書きされるのでコピーしておく．
+  mKey = mScanner->cur_string();
+  tk = mScanner->read_token();
+  if ( tk != JsonToken::Colon ) {
+    // ':' ではなかった．
+    error("':' is expected");
+  }
+  mStack.back() = ObjValue;
+  return JsonEvent::Key;
+}
+
+// @brief 現在の位置を付けたエラーを送出する．
+void
+JsonReader::error(
+  const std::string& msg
+)
+{
+  std::ostringstream buf;
+  buf << mScanner->cur_loc()
+      << ": " << msg;
+  throw std::invalid_argument(buf.str());
+}
+
+END_NAMESPACE_YM_JSON
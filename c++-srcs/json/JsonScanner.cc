@@ -7,22 +7,176 @@
 /// All rights reserved.
 
 #include "JsonScanner.h"
+#include <charconv>
 
 
 BEGIN_NAMESPACE_YM_JSON
 
-// @brief コンストラクタ
+BEGIN_NONAMESPACE
+
+// 入力ストリームから一度に読み込むサイズ
+const SizeType CHUNK_SIZE = 64 * 1024;
+
+END_NONAMESPACE
+
+// @brief 入力ストリームを指定したコンストラクタ
 JsonScanner::JsonScanner(
   std::istream& s
-) : mS{s},
-    mCurLine{1},
-    mCurColumn{1},
-    mFirstLine{1},
-    mFirstColumn{1},
-    mNextLine{1},
-    mNextColumn{1},
-    mNeedUpdate{true}
+) : mS{&s},
+    mChunk(CHUNK_SIZE)
+{
+}
+
+// @brief 入力バッファを指定したコンストラクタ
+JsonScanner::JsonScanner(
+  std::string_view buff
+) : mBegin{buff.data()},
+    mPtr{buff.data()},
+    mEnd{buff.data() + buff.size()}
+{
+}
+
+// @brief 入力バッファと開始位置を指定したコンストラクタ
+JsonScanner::JsonScanner(
+  std::string_view buff,
+  const JsonPos& pos
+) : mBegin{buff.data()},
+    mPtr{buff.data()},
+    mEnd{buff.data() + buff.size()}
+{
+  seek(pos);
+}
+
+// @brief 読み出す位置を移動する．
+void
+JsonScanner::seek(
+  const JsonPos& pos
+)
+{
+  ASSERT_COND( mS == nullptr );
+
+  mPtr = mBegin + pos.mOffset;
+  mCurPos = pos.mOffset;
+  mCurLine = pos.mLine;
+  mCurTop = pos.mTop;
+  mFirstLine = pos.mLine;
+  mNextLine = pos.mLine;
+  mNextTop = pos.mTop;
+  mNeedUpdate = true;
+  mUngetToken = JsonToken::None;
+}
+
+// @brief 配列かオブジェクトの残りを読み飛ばす．
+bool
+JsonScanner::skip_container()
 {
+  ASSERT_COND( mS == nullptr && mUngetToken == JsonToken::None );
+  ASSERT_COND( mNeedUpdate );
+
+  // 以降は peek() を用いずに直接走査する．
+  // 行番号は mNextLine と mNextTop を更新しておけばよい．
+  SizeType depth = 1;
+  auto p = mPtr;
+  for ( ; ; ) {
+    p = JsonSimd::find_structural(p, mEnd);
+    if ( p == mEnd ) {
+      break;
+    }
+    switch ( *p ) {
+    case '{':
+    case '[':
+      ++ depth;
+      ++ p;
+      break;
+
+    case '}':
+    case ']':
+      ++ p;
+      -- depth;
+      if ( depth == 0 ) {
+	advance(p);
+	return true;
+      }
+      break;
+
+    case '"':
+    case '\'':
+      {
+	char quote = *p;
+	++ p;
+	for ( ; ; ) {
+	  p = JsonSimd::find_string_special(p, mEnd, quote);
+	  if ( p == mEnd ) {
+	    break;
+	  }
+	  char c = *p;
+	  if ( c == quote ) {
+	    ++ p;
+	    break;
+	  }
+	  if ( c == '\n' || c == '\r' ) {
+	    p = skip_newline(p);
+	  }
+	  else if ( c == '\\' ) {
+	    // エスケープされた文字は調べない．
+	    // ただし改行文字は行番号を数えるために残す．
+	    ++ p;
+	    if ( p < mEnd && *p != '\n' && *p != '\r' ) {
+	      ++ p;
+	    }
+	  }
+	  else {
+	    ++ p;
+	  }
+	}
+      }
+      break;
+
+    case '\n':
+    case '\r':
+      p = skip_newline(p);
+      break;
+
+    case '#':
+      // 改行までをコメントとして読み飛ばす．
+      while ( p < mEnd && *p != '\n' && *p != '\r' ) {
+	++ p;
+      }
+      break;
+
+    case '/':
+      ++ p;
+      if ( p < mEnd && *p == '/' ) {
+	// 改行までをコメントとして読み飛ばす．
+	while ( p < mEnd && *p != '\n' && *p != '\r' ) {
+	  ++ p;
+	}
+      }
+      else if ( p < mEnd && *p == '*' ) {
+	// '*/' までをコメントとして読み飛ばす．
+	++ p;
+	while ( p < mEnd ) {
+	  if ( *p == '*' && p + 1 < mEnd && p[1] == '/' ) {
+	    p += 2;
+	    break;
+	  }
+	  if ( *p == '\n' || *p == '\r' ) {
+	    p = skip_newline(p);
+	  }
+	  else {
+	    ++ p;
+	  }
+	}
+      }
+      break;
+
+    default:
+      ASSERT_NOT_REACHED;
+      break;
+    }
+  }
+  advance(mEnd);
+  return false;
 }
 
 // @brief トークンを一つ読み出す．
@@ -34,9 +188,7 @@ JsonScanner::read_token()
     mUngetToken = JsonToken::None;
     return tk;
   }
-  auto tk = scan();
-  mCurLoc = Region{mFirstLine, mFirstColumn, mCurLine, mCurColumn};
-  return tk;
+  return scan();
 }
 
 // @brief 直前に読み込んだトークンを戻す．
@@ -54,10 +206,24 @@ JsonToken
 JsonScanner::scan()
 {
   mCurString = "";
+  mRawNum = false;
 
   int c;
+  // 文字列の終端文字
+  char quote = '"';
 
  ST_INIT:
+  skip_blank();
+  {
+    auto tk = read_structural();
+    if ( tk != JsonToken::None ) {
+      return tk;
+    }
+    tk = read_number();
+    if ( tk != JsonToken::None ) {
+      return tk;
+    }
+  }
   c = get();
   set_first_loc();
 
@@ -90,10 +256,9 @@ JsonScanner::scan()
     return JsonToken::Colon;
 
   case '"':
-    goto ST_DQ;
-
   case '\'':
-    goto ST_SQ;
+    quote = c;
+    goto ST_STR;
 
   case '-':
     mCurString += static_cast<char>(c);
@@ -193,10 +358,12 @@ JsonScanner::scan()
     goto ST_NUM_EXP1;
 
   default:
-    return JsonToken::Int;
+    return int_token(mCurString.data(),
+		     mCurString.data() + mCurString.size());
   }
 
  ST_NUM1: // '1'〜'9' を読んだ直後
+  read_digits();
   c = peek();
   switch ( c ) {
   case '0':
@@ -225,10 +392,12 @@ JsonScanner::scan()
     goto ST_NUM_EXP1;
 
   default:
-    return JsonToken::Int;
+    return int_token(mCurString.data(),
+		     mCurString.data() + mCurString.size());
   }
 
  ST_NUM_DOT: // '.' を読んだ直後
+  read_digits();
   c = peek();
   switch ( c ) {
   case '0':
@@ -300,9 +469,10 @@ JsonScanner::scan()
     return JsonToken::Float;
   }
 
- ST_DQ: // 次の '"' までを文字列だと思う．
+ ST_STR: // 次の quote までを文字列だと思う．
+  read_string_body(quote);
   c = get();
-  if ( c == '\"' ) {
+  if ( c == quote ) {
     return JsonToken::String;
   }
   if ( c == '\\' ) {
@@ -321,66 +491,82 @@ JsonScanner::scan()
     default: goto ST_ERROR;
     }
   }
+  else if ( c >= 0x80 ) {
+    goto ST_UTF8;
+  }
   else if ( !isprint(c) ) {
     goto ST_ERROR;
   }
   mCurString += static_cast<char>(c);
-  goto ST_DQ;
+  goto ST_STR;
 
- ST_SQ: // 次の '\'' までを文字列だと思う．
-  c = get();
-  if ( c == '\'' ) {
-    return JsonToken::String;
-  }
-  if ( c == '\\' ) {
-    c = get();
-    switch ( c ) {
-    case '\"': c = '\"'; break;
-    case '\'': c = '\''; break;
-    case '\\': c = '\\'; break;
-    case '/': c = '/'; break;
-    case 'b': c = '\b'; break;
-    case 'f': c = '\f'; break;
-    case 'n': c = '\n'; break;
-    case 'r': c = '\r'; break;
-    case 't': c = '\t'; break;
-    case 'u': goto ST_UHEX4; break;
-    default: goto ST_ERROR;
+ ST_UTF8: // UTF-8 の2バイト目以降を読み込む．
+  // 通常は read_string_body() でまとめて読み込まれるので
+  // ここに来るのは誤りがある場合か入力ストリームのブロックの
+  // 境界で文字が分割された場合のみ
+  {
+    SizeType n;
+    std::uint32_t code;
+    std::uint32_t min;
+    if ( (c & 0xE0) == 0xC0 ) {
+      n = 2;
+      code = c & 0x1F;
+      min = 0x80;
+    }
+    else if ( (c & 0xF0) == 0xE0 ) {
+      n = 3;
+      code = c & 0x0F;
+      min = 0x800;
+    }
+    else if ( (c & 0xF8) == 0xF0 ) {
+      n = 4;
+      code = c & 0x07;
+      min = 0x10000;
+    }
+    else {
+      goto ST_ERROR;
+    }
+    mCurString += static_cast<char>(c);
+    for ( SizeType i = 1; i < n; ++ i ) {
+      c = get();
+      if ( c == EOF || (c & 0xC0) != 0x80 ) {
+	goto ST_ERROR;
+      }
+      code = (code << 6) | (c & 0x3F);
+      mCurString += static_cast<char>(c);
+    }
+    // 冗長な符号化，サロゲート，範囲外の符号は誤り
+    if ( code < min || code > 0x10FFFF ||
+	 (0xD800 <= code && code <= 0xDFFF) ) {
+      goto ST_ERROR;
     }
   }
-  else if ( !isprint(c) ) {
-    goto ST_ERROR;
-  }
-  mCurString += static_cast<char>(c);
-  goto ST_SQ;
+  goto ST_STR;
 
  ST_UHEX4: // 4桁のHEXコードを読み込み，unicode と解釈する．
   {
-    char buff[5];
-    for ( SizeType i = 0; i < 4; ++ i ) {
-      int c = get();
-      if ( !isxdigit(c) ) {
+    auto code = read_hex4();
+    if ( 0xDC00 <= code && code <= 0xDFFF ) {
+      // 対になる上位サロゲートがない．
+      goto ST_ERROR;
+    }
+    if ( 0xD800 <= code && code <= 0xDBFF ) {
+      // サロゲートペアの下位を読み込む．
+      if ( get() != '\\' || get() != 'u' ) {
 	goto ST_ERROR;
       }
-      buff[i] = c;
-    }
-    buff[4] = '\0';
-    std::uint32_t code = strtol(buff, nullptr, 16);
-    // code を unicode とみなして UTF-8 に符号化する．
-    if ( code <= 0x007F ) {
-      mCurString += static_cast<char>(code);
-    }
-    else if ( code <= 0x07FF ) {
-      mCurString += static_cast<char>((code >> 6) & 0x1F) | 0xC0;
-      mCurString += static_cast<char>(code & 0x3F) | 0x80;
+      auto low = read_hex4();
+      if ( low < 0xDC00 || 0xDFFF < low ) {
+	goto ST_ERROR;
+      }
+      code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
     }
-    else { // ここでは 0x10000 以上のコードはない．
-      mCurString += static_cast<char>((code >> 12) & 0x0F) | 0xE0;
-      mCurString += static_cast<char>((code >> 6) & 0x3F) | 0x80;
-      mCurString += static_cast<char>(code & 0x3F) | 0x80;
+    if ( code < 0 ) {
+      goto ST_ERROR;
     }
+    append_utf8(code);
   }
-  goto ST_DQ;
+  goto ST_STR;
 
  ST_CM1: // '*/' までをコメントとして読み飛ばす．
   c = get();
@@ -419,6 +605,100 @@ JsonScanner::scan()
   throw std::invalid_argument{"Syntax error"};
 }
 
+// @brief 直前の read_token() で読み出した字句の浮動小数点数を返す．
+double
+JsonScanner::cur_float() const
+{
+  auto str = num_string();
+  double val = 0.0;
+  auto res = std::from_chars(str.data(), str.data() + str.size(), val);
+  if ( res.ec == std::errc::result_out_of_range ) {
+    // オーバーフローとアンダーフローは strtod() に合わせる．
+    val = strtod(std::string{str}.c_str(), nullptr);
+  }
+  return val;
+}
+
+// @brief 数値をまとめて読み込む．
+JsonToken
+JsonScanner::read_number()
+{
+  if ( !mNeedUpdate || mPtr == mEnd ) {
+    return JsonToken::None;
+  }
+
+  auto is_digit = [](char c) { return '0' <= c && c <= '9'; };
+
+  auto p = mPtr;
+  if ( *p == '-' ) {
+    ++ p;
+  }
+  if ( p == mEnd || !is_digit(*p) ) {
+    return JsonToken::None;
+  }
+  if ( *p == '0' ) {
+    ++ p;
+  }
+  else {
+    p = JsonSimd::skip_digits(p + 1, mEnd);
+  }
+  bool is_float = false;
+  if ( p < mEnd && *p == '.' ) {
+    is_float = true;
+    p = JsonSimd::skip_digits(p + 1, mEnd);
+  }
+  if ( p < mEnd && (*p == 'e' || *p == 'E') ) {
+    is_float = true;
+    ++ p;
+    if ( p < mEnd && (*p == '+' || *p == '-') ) {
+      ++ p;
+    }
+    auto q = JsonSimd::skip_digits(p, mEnd);
+    if ( q == p ) {
+      // 指数部の数字がない．
+      return JsonToken::None;
+    }
+    p = q;
+  }
+  if ( p == mEnd ) {
+    if ( mS != nullptr ) {
+      // 続きが次のブロックにあるかもしれない．
+      return JsonToken::None;
+    }
+  }
+  else if ( is_digit(*p) || *p == '.' || *p == 'e' || *p == 'E' ) {
+    // 標準的でない形式は状態遷移で読む．
+    return JsonToken::None;
+  }
+
+  auto begin = mPtr;
+  advance(mPtr + 1);
+  set_first_loc();
+  advance(p);
+  mRawNum = true;
+  mNumBegin = begin;
+  mNumEnd = p;
+  if ( is_float ) {
+    return JsonToken::Float;
+  }
+  return int_token(begin, p);
+}
+
+// @brief 整数の字句を変換して JsonToken::Int を返す．
+JsonToken
+JsonScanner::int_token(
+  const char* begin,
+  const char* end
+)
+{
+  auto res = std::from_chars(begin, end, mCurInt);
+  if ( res.ec != std::errc{} ) {
+    // 64ビット整数に収まらない．
+    return JsonToken::Float;
+  }
+  return JsonToken::Int;
+}
+
 // @brief 'true' を読み込む．
 bool
 JsonScanner::read_true()
@@ -470,12 +750,85 @@ JsonScanner::read_null()
   return true;
 }
 
+// @brief 4桁の16進数を読み込む．
+int
+JsonScanner::read_hex4()
+{
+  int code = 0;
+  for ( SizeType i = 0; i < 4; ++ i ) {
+    int c = get();
+    if ( '0' <= c && c <= '9' ) {
+      code = code * 16 + (c - '0');
+    }
+    else if ( 'a' <= c && c <= 'f' ) {
+      code = code * 16 + (c - 'a' + 10);
+    }
+    else if ( 'A' <= c && c <= 'F' ) {
+      code = code * 16 + (c - 'A' + 10);
+    }
+    else {
+      return -1;
+    }
+  }
+  return code;
+}
+
+// @brief unicode の符号を UTF-8 に符号化して mCurString に追加する．
+void
+JsonScanner::append_utf8(
+  std::uint32_t code
+)
+{
+  if ( code <= 0x007F ) {
+    mCurString += static_cast<char>(code);
+  }
+  else if ( code <= 0x07FF ) {
+    mCurString += static_cast<char>(((code >> 6) & 0x1F) | 0xC0);
+    mCurString += static_cast<char>((code & 0x3F) | 0x80);
+  }
+  else if ( code <= 0xFFFF ) {
+    mCurString += static_cast<char>(((code >> 12) & 0x0F) | 0xE0);
+    mCurString += static_cast<char>(((code >> 6) & 0x3F) | 0x80);
+    mCurString += static_cast<char>((code & 0x3F) | 0x80);
+  }
+  else {
+    mCurString += static_cast<char>(((code >> 18) & 0x07) | 0xF0);
+    mCurString += static_cast<char>(((code >> 12) & 0x3F) | 0x80);
+    mCurString += static_cast<char>(((code >> 6) & 0x3F) | 0x80);
+    mCurString += static_cast<char>((code & 0x3F) | 0x80);
+  }
+}
+
+// @brief 入力ストリームから次のブロックを読み込む．
+bool
+JsonScanner::fill()
+{
+  if ( mS == nullptr ) {
+    return false;
+  }
+  mBase += mEnd - mBegin;
+  mS->read(mChunk.data(), mChunk.size());
+  SizeType n = mS->gcount();
+  mBegin = mChunk.data();
+  mPtr = mBegin;
+  mEnd = mBegin + n;
+  return n > 0;
+}
+
 // @brief peek() の下請け関数
 void
 JsonScanner::update()
 {
-  int c = mS.peek();
-  mS.ignore();
+  if ( mPtr == mEnd && !fill() ) {
+    mNextChar = EOF;
+    mNextPos = offset(mPtr);
+    mNeedUpdate = false;
+    return;
+  }
+
+  mNextPos = offset(mPtr);
+  int c = static_cast<unsigned char>(*mPtr);
+  ++ mPtr;
 
   // Windows(DOS)/Mac/UNIX の間で改行コードの扱いが異なるのでここで
   // 強制的に '\n' に書き換えてしまう．
@@ -483,17 +836,14 @@ JsonScanner::update()
   // Mac     : '\r'
   // UNIX    : '\n'
   // なので '\r' を '\n' に書き換えてしまう．
-  // ただし次に本当の '\n' が来たときには無視するために
-  // mCR を true にしておく．
+  // ただし直後に本当の '\n' が来たときにはそれも読み飛ばす．
   if ( c == '\r' ) {
-    c = mS.peek();
-    if ( c != '\n' ) {
-      // MAC 形式 ('\r' のみ)
-      c = '\n';
-    }
-    else {
-      // Windows 形式 ('\r', '\n')
-      mS.ignore();
+    c = '\n';
+    if ( mPtr < mEnd || fill() ) {
+      if ( *mPtr == '\n' ) {
+	// Windows 形式 ('\r', '\n')
+	++ mPtr;
+      }
     }
   }
   mNeedUpdate = false;
@@ -507,15 +857,15 @@ JsonScanner::accept()
   ASSERT_COND( mNeedUpdate == false );
 
   mNeedUpdate = true;
+  mCurPos = mNextPos;
   mCurLine = mNextLine;
-  mCurColumn = mNextColumn;
-  // mNextLine と mNextColumn を先に設定しておく
+  mCurTop = mNextTop;
+  // mNextLine と mNextTop を先に設定しておく
   if ( mNextChar == '\n' ) {
     check_line(mCurLine);
     ++ mNextLine;
-    mNextColumn = 0;
+    mNextTop = offset(mPtr);
   }
-  ++ mNextColumn;
 }
 
 // @brief 改行を読み込んだ時に起動する関数
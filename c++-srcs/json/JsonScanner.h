@@ -11,6 +11,8 @@
 #include "ym/json.h"
 #include "Loc.h"
 #include "Region.h"
+#include "JsonSimd.h"
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_JSON
@@ -34,19 +36,61 @@ enum class JsonToken {
 };
 
 
+//////////////////////////////////////////////////////////////////////
+/// @class JsonPos JsonScanner.h "JsonScanner.h"
+/// @brief 入力バッファ中の位置を表す構造体
+///
+/// JsonScanner::cur_pos() で得た位置から読み込みを再開するために用いる．
+//////////////////////////////////////////////////////////////////////
+struct JsonPos
+{
+  /// @brief 入力先頭からのオフセット
+  SizeType mOffset{0};
+
+  /// @brief 行番号
+  int mLine{1};
+
+  /// @brief 行の先頭のオフセット
+  SizeType mTop{0};
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class JsonScanner JsonScanner.h "JsonScanner.h"
 /// @brief json 用の字句解析器
+///
+/// 入力はメモリ上の連続した領域を直接走査する．
+/// istream を指定した場合には一定サイズずつバッファに読み込んで
+/// 同じ処理を行う．
+///
+/// 位置情報は入力先頭からのオフセットで保持しておき，
+/// cur_loc() が呼ばれた時に行番号とコラム位置に変換する．
 //////////////////////////////////////////////////////////////////////
 class JsonScanner
 {
 public:
 
-  /// @brief コンストラクタ
+  /// @brief 入力ストリームを指定したコンストラクタ
   JsonScanner(
     std::istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief 入力バッファを指定したコンストラクタ
+  ///
+  /// buff の内容はこのオブジェクトが存在する間は有効でなければならない．
+  JsonScanner(
+    std::string_view buff ///< [in] 入力バッファ
+  );
+
+  /// @brief 入力バッファと開始位置を指定したコンストラクタ
+  ///
+  /// buff の内容はこのオブジェクトが存在する間は有効でなければならない．
+  /// pos は同じ buff に対する cur_pos() で得たものでなければならない．
+  JsonScanner(
+    std::string_view buff, ///< [in] 入力バッファ
+    const JsonPos& pos     ///< [in] 開始位置
+  );
+
   /// @brief デストラクタ
   ~JsonScanner() = default;
 
@@ -66,32 +110,72 @@ public:
     JsonToken tk ///< [in] トークン
   );
 
+  /// @brief 読み出す位置を移動する．
+  ///
+  /// 入力バッファを指定した場合のみ有効
+  /// pos は cur_pos() で得たものでなければならない．
+  void
+  seek(
+    const JsonPos& pos ///< [in] 位置
+  );
+
+  /// @brief 次に読み出す位置を返す．
+  ///
+  /// 入力バッファを指定した場合のみ有効
+  /// 読み戻したトークンがある場合は無効
+  JsonPos
+  cur_pos() const
+  {
+    ASSERT_COND( mS == nullptr && mUngetToken == JsonToken::None );
+    if ( mNeedUpdate ) {
+      return JsonPos{offset(mPtr), mNextLine, mNextTop};
+    }
+    return JsonPos{mNextPos, mNextLine, mNextTop};
+  }
+
+  /// @brief 配列かオブジェクトの残りを読み飛ばす．
+  /// @return 対応する閉じ括弧が見つからなかった時 false を返す．
+  ///
+  /// read_token() が JsonToken::LCB か JsonToken::LBK を返した直後のみ有効
+  /// 括弧の対応と文字列，コメントの区切りだけを調べるので
+  /// 中身の文法エラーは検出しない．
+  /// 入力バッファを指定した場合のみ有効
+  bool
+  skip_container();
+
   /// @brief 直前の read_token() で読み出した字句の文字列を返す．
-  std::string
+  ///
+  /// 内容は次の read_token() までの間有効
+  const std::string&
   cur_string()
   {
+    if ( mRawNum ) {
+      // 入力から直接読んだ数値をここで文字列にする．
+      mCurString.assign(mNumBegin, mNumEnd - mNumBegin);
+      mRawNum = false;
+    }
     return mCurString;
   }
 
   /// @brief 直前の read_token() で読み出した字句の整数を返す．
-  int
-  cur_int()
+  ///
+  /// 64ビット整数で表せない整数は JsonToken::Float になる．
+  std::int64_t
+  cur_int() const
   {
-    return atoi(mCurString.c_str());
+    return mCurInt;
   }
 
   /// @brief 直前の read_token() で読み出した字句の浮動小数点数を返す．
   double
-  cur_float()
-  {
-    return atof(mCurString.c_str());
-  }
+  cur_float() const;
 
   /// @brief 直前の read_token() で読み出した字句の位置を返す．
   Region
   cur_loc()
   {
-    return mCurLoc;
+    return Region{mFirstLine, mFirstColumn,
+		  mCurLine, static_cast<int>(mCurPos - mCurTop + 1)};
   }
 
 
@@ -104,6 +188,52 @@ private:
   JsonToken
   scan();
 
+  /// @brief skip_container() 中で改行文字を読み飛ばす．
+  /// @return 改行文字の次の位置を返す．
+  const char*
+  skip_newline(
+    const char* p ///< [in] 改行文字('\n' か '\r')の位置
+  )
+  {
+    if ( *p == '\r' && p + 1 < mEnd && p[1] == '\n' ) {
+      ++ p;
+    }
+    ++ p;
+    check_line(mNextLine);
+    ++ mNextLine;
+    mNextTop = offset(p);
+    return p;
+  }
+
+  /// @brief 数値をまとめて読み込む．
+  /// @return 読み込めなかった場合は JsonToken::None を返す．
+  ///
+  /// 標準的な形式の数値を入力から直接読む．
+  /// それ以外の場合は scan() の状態遷移で読む．
+  /// 先読みした文字がない場合のみ有効
+  JsonToken
+  read_number();
+
+  /// @brief 整数の字句を変換して JsonToken::Int を返す．
+  ///
+  /// 64ビット整数で表せない場合は JsonToken::Float を返す．
+  JsonToken
+  int_token(
+    const char* begin, ///< [in] 先頭
+    const char* end    ///< [in] 末尾
+  );
+
+  /// @brief 数値の字句を返す．
+  std::string_view
+  num_string() const
+  {
+    if ( mRawNum ) {
+      return std::string_view{mNumBegin,
+			      static_cast<SizeType>(mNumEnd - mNumBegin)};
+    }
+    return mCurString;
+  }
+
   /// @brief 'true' を読み込む．
   bool
   read_true();
@@ -116,6 +246,123 @@ private:
   bool
   read_null();
 
+  /// @brief 4桁の16進数を読み込む．
+  /// @return 16進数でない文字があった場合は -1 を返す．
+  int
+  read_hex4();
+
+  /// @brief unicode の符号を UTF-8 に符号化して mCurString に追加する．
+  void
+  append_utf8(
+    std::uint32_t code ///< [in] 符号
+  );
+
+  /// @brief 空白とタブを読み飛ばす．
+  ///
+  /// 先読みした文字がない場合のみ有効
+  void
+  skip_blank()
+  {
+    if ( mNeedUpdate && mPtr < mEnd && (*mPtr == ' ' || *mPtr == '\t') ) {
+      mPtr = JsonSimd::skip_blank(mPtr + 1, mEnd);
+    }
+  }
+
+  /// @brief 区切り文字ならその場で確定させる．
+  /// @return 区切り文字でなければ JsonToken::None を返す．
+  ///
+  /// 先読みした文字がない場合のみ有効
+  JsonToken
+  read_structural()
+  {
+    if ( mNeedUpdate && mPtr < mEnd ) {
+      auto tk = JsonToken::None;
+      switch ( *mPtr ) {
+      case '{': tk = JsonToken::LCB; break;
+      case '}': tk = JsonToken::RCB; break;
+      case '[': tk = JsonToken::LBK; break;
+      case ']': tk = JsonToken::RBK; break;
+      case ',': tk = JsonToken::Comma; break;
+      case ':': tk = JsonToken::Colon; break;
+      default: return JsonToken::None;
+      }
+      advance(mPtr + 1);
+      set_first_loc();
+      return tk;
+    }
+    return JsonToken::None;
+  }
+
+  /// @brief 数字の並びをまとめて読み込む．
+  ///
+  /// 先読みした文字がない場合のみ有効
+  void
+  read_digits()
+  {
+    if ( mNeedUpdate ) {
+      append_run(JsonSimd::skip_digits(mPtr, mEnd));
+    }
+  }
+
+  /// @brief 文字列の中身をまとめて読み込む．
+  ///
+  /// 終端文字(quote)，'\\' および制御文字の手前まで読み込む．
+  /// UTF-8 として正しくない文字と入力の末尾で切れている文字が
+  /// あればその手前までとなる．
+  /// 先読みした文字がない場合のみ有効
+  void
+  read_string_body(
+    char quote ///< [in] 終端文字
+  )
+  {
+    if ( mNeedUpdate ) {
+      auto end = JsonSimd::find_string_special(mPtr, mEnd, quote);
+      append_run(JsonSimd::validate_utf8(mPtr, end));
+    }
+  }
+
+  /// @brief mPtr から end の手前までを mCurString に追加して読み進める．
+  ///
+  /// 改行文字を含んでいてはいけない．
+  void
+  append_run(
+    const char* end ///< [in] 末尾
+  )
+  {
+    if ( end != mPtr ) {
+      mCurString.append(mPtr, end - mPtr);
+      advance(end);
+    }
+  }
+
+  /// @brief mPtr から end の手前までを確定させる．
+  ///
+  /// 改行文字を含んでいてはいけない．
+  void
+  advance(
+    const char* end ///< [in] 末尾
+  )
+  {
+    mCurPos = offset(end - 1);
+    mCurLine = mNextLine;
+    mCurTop = mNextTop;
+    mPtr = end;
+  }
+
+  /// @brief ポインタを入力先頭からのオフセットに変換する．
+  SizeType
+  offset(
+    const char* p ///< [in] mBegin から mEnd までの間を指すポインタ
+  ) const
+  {
+    return mBase + (p - mBegin);
+  }
+
+  /// @brief 入力ストリームから次のブロックを読み込む．
+  /// @return 読み込んだ文字があれば true を返す．
+  bool
+  fill();
+
   /// @brief peek() の下請け関数
   void
   update();
@@ -156,7 +403,7 @@ private:
   set_first_loc()
   {
     mFirstLine = mCurLine;
-    mFirstColumn = mCurColumn;
+    mFirstColumn = static_cast<int>(mCurPos - mCurTop + 1);
   }
 
   /// @brief 改行を読み込んだ時に起動する関数
@@ -174,37 +421,69 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 入力ストリーム
-  std::istream& mS;
+  // バッファを直接走査する場合は nullptr
+  std::istream* mS{nullptr};
+
+  // 入力ストリームから読み込むためのバッファ
+  std::vector<char> mChunk;
+
+  // 現在走査中の領域の先頭
+  const char* mBegin{nullptr};
+
+  // 次に読み出す文字の位置
+  const char* mPtr{nullptr};
+
+  // 現在走査中の領域の末尾
+  const char* mEnd{nullptr};
 
-  // 現在の行番号
-  int mCurLine;
+  // mBegin の入力先頭からのオフセット
+  SizeType mBase{0};
 
-  // 現在のコラム位置
-  int mCurColumn;
+  // 直前に確定した文字のオフセット
+  SizeType mCurPos{0};
+
+  // 直前に確定した文字の行番号
+  int mCurLine{1};
+
+  // 直前に確定した文字の行の先頭のオフセット
+  SizeType mCurTop{0};
 
   // トークンの最初の行番号
-  int mFirstLine;
+  int mFirstLine{1};
 
   // トークンの最初のコラム位置
-  int mFirstColumn;
+  int mFirstColumn{1};
 
   // peek() した文字
-  int mNextChar;
+  int mNextChar{EOF};
+
+  // peek() した文字のオフセット
+  SizeType mNextPos{0};
 
   // peek() した文字の行番号
-  int mNextLine;
+  int mNextLine{1};
 
-  // peek() した文字のコラム位置
-  int mNextColumn;
+  // peek() した文字の行の先頭のオフセット
+  SizeType mNextTop{0};
 
   // 新しい文字を読み込む必要がある時 true となるフラグ
-  bool mNeedUpdate;
+  bool mNeedUpdate{true};
 
   // 文字列バッファ
   std::string mCurString;
 
-  // 直前に読み出した字句の位置
-  Region mCurLoc;
+  // 数値を入力から直接読んだ時 true
+  // その場合の字句は mNumBegin から mNumEnd の手前まで
+  bool mRawNum{false};
+
+  // 数値の字句の先頭
+  const char* mNumBegin{nullptr};
+
+  // 数値の字句の末尾
+  const char* mNumEnd{nullptr};
+
+  // 整数値
+  std::int64_t mCurInt{0};
 
   // 読み戻したトークン
   JsonToken mUngetToken{JsonToken::None};
@@ -0,0 +1,718 @@
+
+/// @file JsonSimd.cc
+/// @brief JsonSimd の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "JsonSimd.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// スカラー版
+//////////////////////////////////////////////////////////////////////
+
+inline
+bool
+is_blank(
+  char c
+)
+{
+  return c == ' ' || c == '\t';
+}
+
+inline
+bool
+is_digit(
+  char c
+)
+{
+  return '0' <= c && c <= '9';
+}
+
+inline
+bool
+is_string_special(
+  char c,
+  char quote
+)
+{
+  auto uc = static_cast<unsigned char>(c);
+  return c == quote || c == '\\' || uc < 0x20 || uc == 0x7F;
+}
+
+inline
+bool
+is_structural(
+  char c
+)
+{
+  switch ( c ) {
+  case '{': case '}': case '[': case ']':
+  case '"': case '\'':
+  case '\n': case '\r':
+  case '#': case '/':
+    return true;
+  default:
+    return false;
+  }
+}
+
+const char*
+skip_blank_scalar(
+  const char* p,
+  const char* end
+)
+{
+  while ( p < end && is_blank(*p) ) {
+    ++ p;
+  }
+  return p;
+}
+
+const char*
+skip_digits_scalar(
+  const char* p,
+  const char* end
+)
+{
+  while ( p < end && is_digit(*p) ) {
+    ++ p;
+  }
+  return p;
+}
+
+const char*
+find_string_special_scalar(
+  const char* p,
+  const char* end,
+  char quote
+)
+{
+  while ( p < end && !is_string_special(*p, quote) ) {
+    ++ p;
+  }
+  return p;
+}
+
+const char*
+find_structural_scalar(
+  const char* p,
+  const char* end
+)
+{
+  while ( p < end && !is_structural(*p) ) {
+    ++ p;
+  }
+  return p;
+}
+
+// p から始まる UTF-8 の文字のバイト数を返す．
+// 正しくない場合と end で切れている場合は 0 を返す．
+inline
+SizeType
+utf8_char_size(
+  const char* p,
+  const char* end
+)
+{
+  auto c = static_cast<unsigned char>(*p);
+  if ( c < 0x80 ) {
+    return 1;
+  }
+  SizeType n;
+  std::uint32_t code;
+  std::uint32_t min;
+  if ( (c & 0xE0) == 0xC0 ) {
+    n = 2;
+    code = c & 0x1F;
+    min = 0x80;
+  }
+  else if ( (c & 0xF0) == 0xE0 ) {
+    n = 3;
+    code = c & 0x0F;
+    min = 0x800;
+  }
+  else if ( (c & 0xF8) == 0xF0 ) {
+    n = 4;
+    code = c & 0x07;
+    min = 0x10000;
+  }
+  else {
+    return 0;
+  }
+  if ( static_cast<SizeType>(end - p) < n ) {
+    return 0;
+  }
+  for ( SizeType i = 1; i < n; ++ i ) {
+    auto c1 = static_cast<unsigned char>(p[i]);
+    if ( (c1 & 0xC0) != 0x80 ) {
+      return 0;
+    }
+    code = (code << 6) | (c1 & 0x3F);
+  }
+  if ( code < min || code > 0x10FFFF ||
+       (0xD800 <= code && code <= 0xDFFF) ) {
+    return 0;
+  }
+  return n;
+}
+
+const char*
+validate_utf8_scalar(
+  const char* p,
+  const char* end
+)
+{
+  while ( p < end ) {
+    auto n = utf8_char_size(p, end);
+    if ( n == 0 ) {
+      break;
+    }
+    p += n;
+  }
+  return p;
+}
+
+#if defined(JSON_SIMD_X86)
+
+//////////////////////////////////////////////////////////////////////
+// SSE2 版
+//
+// x86_64 では SSE2 は常に使えるので target 属性は不要
+//////////////////////////////////////////////////////////////////////
+
+// 条件を満たす文字のマスクから最初の位置を求める．
+// mask が 0 でない時のみ呼ばれる．
+inline
+int
+first_bit(
+  std::uint32_t mask
+)
+{
+  return __builtin_ctz(mask);
+}
+
+const char*
+skip_blank_sse2(
+  const char* p,
+  const char* end
+)
+{
+  auto sp = _mm_set1_epi8(' ');
+  auto tab = _mm_set1_epi8('\t');
+  while ( end - p >= 16 ) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    auto m = _mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab));
+    std::uint32_t mask = ~_mm_movemask_epi8(m) & 0xFFFFU;
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 16;
+  }
+  return skip_blank_scalar(p, end);
+}
+
+const char*
+skip_digits_sse2(
+  const char* p,
+  const char* end
+)
+{
+  auto lo = _mm_set1_epi8('0' - 1);
+  auto hi = _mm_set1_epi8('9' + 1);
+  while ( end - p >= 16 ) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // 0x80 以上は符号付き比較で負になるので数字とはみなされない．
+    auto m = _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi));
+    std::uint32_t mask = ~_mm_movemask_epi8(m) & 0xFFFFU;
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 16;
+  }
+  return skip_digits_scalar(p, end);
+}
+
+const char*
+find_string_special_sse2(
+  const char* p,
+  const char* end,
+  char quote
+)
+{
+  auto q = _mm_set1_epi8(quote);
+  auto bs = _mm_set1_epi8('\\');
+  auto del = _mm_set1_epi8(0x7F);
+  auto ctrl = _mm_set1_epi8(0x1F);
+  while ( end - p >= 16 ) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // 符号なしで 0x20 未満のものは 0x1F との min が自分自身になる．
+    // 0x80 以上のものは含まない．
+    auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, q),
+				       _mm_cmpeq_epi8(v, bs)),
+			  _mm_or_si128(_mm_cmpeq_epi8(v, del),
+				       _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v)));
+    std::uint32_t mask = _mm_movemask_epi8(m);
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 16;
+  }
+  return find_string_special_scalar(p, end, quote);
+}
+
+const char*
+find_structural_sse2(
+  const char* p,
+  const char* end
+)
+{
+  // '{' と '['，'}' と ']' はそれぞれ 0x20 だけ異なるので
+  // 0x20 のビットを立ててから比較する．
+  auto bit = _mm_set1_epi8(0x20);
+  auto lcb = _mm_set1_epi8('{');
+  auto rcb = _mm_set1_epi8('}');
+  auto dq = _mm_set1_epi8('"');
+  auto sq = _mm_set1_epi8('\'');
+  auto nl = _mm_set1_epi8('\n');
+  auto cr = _mm_set1_epi8('\r');
+  auto sh = _mm_set1_epi8('#');
+  auto sl = _mm_set1_epi8('/');
+  while ( end - p >= 16 ) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    auto v1 = _mm_or_si128(v, bit);
+    auto m1 = _mm_or_si128(_mm_cmpeq_epi8(v1, lcb), _mm_cmpeq_epi8(v1, rcb));
+    auto m2 = _mm_or_si128(_mm_cmpeq_epi8(v, dq), _mm_cmpeq_epi8(v, sq));
+    auto m3 = _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, cr));
+    auto m4 = _mm_or_si128(_mm_cmpeq_epi8(v, sh), _mm_cmpeq_epi8(v, sl));
+    auto m = _mm_or_si128(_mm_or_si128(m1, m2), _mm_or_si128(m3, m4));
+    std::uint32_t mask = _mm_movemask_epi8(m);
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 16;
+  }
+  return find_structural_scalar(p, end);
+}
+
+const char*
+validate_utf8_sse2(
+  const char* p,
+  const char* end
+)
+{
+  while ( end - p >= 16 ) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    std::uint32_t mask = _mm_movemask_epi8(v);
+    if ( mask == 0 ) {
+      // すべて ASCII
+      p += 16;
+      continue;
+    }
+    // ASCII でない文字が続く間は一文字ずつ調べる．
+    p += first_bit(mask);
+    do {
+      auto n = utf8_char_size(p, end);
+      if ( n == 0 ) {
+	return p;
+      }
+      p += n;
+    } while ( p < end && static_cast<unsigned char>(*p) >= 0x80 );
+  }
+  return validate_utf8_scalar(p, end);
+}
+
+//////////////////////////////////////////////////////////////////////
+// AVX2 版
+//////////////////////////////////////////////////////////////////////
+
+__attribute__((target("avx2")))
+const char*
+skip_blank_avx2(
+  const char* p,
+  const char* end
+)
+{
+  auto sp = _mm256_set1_epi8(' ');
+  auto tab = _mm256_set1_epi8('\t');
+  while ( end - p >= 32 ) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto m = _mm256_or_si256(_mm256_cmpeq_epi8(v, sp),
+			     _mm256_cmpeq_epi8(v, tab));
+    std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 32;
+  }
+  return skip_blank_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+const char*
+skip_digits_avx2(
+  const char* p,
+  const char* end
+)
+{
+  auto lo = _mm256_set1_epi8('0' - 1);
+  auto hi = _mm256_set1_epi8('9' + 1);
+  while ( end - p >= 32 ) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto m = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo),
+			      _mm256_cmpgt_epi8(hi, v));
+    std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 32;
+  }
+  return skip_digits_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+const char*
+find_string_special_avx2(
+  const char* p,
+  const char* end,
+  char quote
+)
+{
+  auto q = _mm256_set1_epi8(quote);
+  auto bs = _mm256_set1_epi8('\\');
+  auto del = _mm256_set1_epi8(0x7F);
+  auto ctrl = _mm256_set1_epi8(0x1F);
+  while ( end - p >= 32 ) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto c = _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl), v);
+    auto m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, q),
+					     _mm256_cmpeq_epi8(v, bs)),
+			     _mm256_or_si256(_mm256_cmpeq_epi8(v, del), c));
+    std::uint32_t mask = _mm256_movemask_epi8(m);
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 32;
+  }
+  return find_string_special_sse2(p, end, quote);
+}
+
+__attribute__((target("avx2")))
+const char*
+find_structural_avx2(
+  const char* p,
+  const char* end
+)
+{
+  auto bit = _mm256_set1_epi8(0x20);
+  auto lcb = _mm256_set1_epi8('{');
+  auto rcb = _mm256_set1_epi8('}');
+  auto dq = _mm256_set1_epi8('"');
+  auto sq = _mm256_set1_epi8('\'');
+  auto nl = _mm256_set1_epi8('\n');
+  auto cr = _mm256_set1_epi8('\r');
+  auto sh = _mm256_set1_epi8('#');
+  auto sl = _mm256_set1_epi8('/');
+  while ( end - p >= 32 ) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto v1 = _mm256_or_si256(v, bit);
+    auto m1 = _mm256_or_si256(_mm256_cmpeq_epi8(v1, lcb),
+			      _mm256_cmpeq_epi8(v1, rcb));
+    auto m2 = _mm256_or_si256(_mm256_cmpeq_epi8(v, dq),
+			      _mm256_cmpeq_epi8(v, sq));
+    auto m3 = _mm256_or_si256(_mm256_cmpeq_epi8(v, nl),
+			      _mm256_cmpeq_epi8(v, cr));
+    auto m4 = _mm256_or_si256(_mm256_cmpeq_epi8(v, sh),
+			      _mm256_cmpeq_epi8(v, sl));
+    auto m = _mm256_or_si256(_mm256_or_si256(m1, m2),
+			     _mm256_or_si256(m3, m4));
+    std::uint32_t mask = _mm256_movemask_epi8(m);
+    if ( mask != 0 ) {
+      return p + first_bit(mask);
+    }
+    p += 32;
+  }
+  return find_structural_sse2(p, end);
+}
+
+// validate_utf8_avx2() 用の 16 エントリの表引き
+// 表は 128 ビットのレーンごとに同じ内容を持つ．
+__attribute__((target("avx2")))
+inline
+__m256i
+lookup16(
+  __m256i idx,
+  std::uint8_t v0, std::uint8_t v1, std::uint8_t v2, std::uint8_t v3,
+  std::uint8_t v4, std::uint8_t v5, std::uint8_t v6, std::uint8_t v7,
+  std::uint8_t v8, std::uint8_t v9, std::uint8_t v10, std::uint8_t v11,
+  std::uint8_t v12, std::uint8_t v13, std::uint8_t v14, std::uint8_t v15
+)
+{
+  auto table = _mm256_setr_epi8(v0, v1, v2, v3, v4, v5, v6, v7,
+				v8, v9, v10, v11, v12, v13, v14, v15,
+				v0, v1, v2, v3, v4, v5, v6, v7,
+				v8, v9, v10, v11, v12, v13, v14, v15);
+  return _mm256_shuffle_epi8(table, idx);
+}
+
+// input の N バイト前の値を並べたものを返す．
+// 先頭の N バイトは prev の末尾から取る．
+template<int N>
+__attribute__((target("avx2")))
+inline
+__m256i
+prev_bytes(
+  __m256i input,
+  __m256i prev
+)
+{
+  return _mm256_alignr_epi8(input,
+			    _mm256_permute2x128_si256(prev, input, 0x21),
+			    16 - N);
+}
+
+// 32 バイト単位で UTF-8 の誤りを検出する．
+//
+// 直前の 1 バイトの上位/下位 4 ビットと現在のバイトの上位 4 ビットの
+// 組み合わせで決まる誤りを表引きで求め，
+// 3/4 バイト文字の 3/4 バイト目の継続バイトの過不足を別に調べる．
+// 誤りを含むブロックが見つかった場合は直前の文字の区切りから
+// SSE2 版で調べ直して正確な位置を求める．
+__attribute__((target("avx2")))
+const char*
+validate_utf8_avx2(
+  const char* p,
+  const char* end
+)
+{
+  // 誤りの種類を表すビット
+  const std::uint8_t TOO_SHORT   = 1 << 0; // 継続バイトが足りない
+  const std::uint8_t TOO_LONG    = 1 << 1; // ASCII の後の継続バイト
+  const std::uint8_t OVERLONG_3  = 1 << 2; // 冗長な3バイト文字
+  const std::uint8_t TOO_LARGE   = 1 << 3; // 0x10FFFF を超える
+  const std::uint8_t SURROGATE   = 1 << 4; // サロゲート
+  const std::uint8_t OVERLONG_2  = 1 << 5; // 冗長な2バイト文字
+  const std::uint8_t TOO_LARGE_1000 = 1 << 6;
+  const std::uint8_t OVERLONG_4  = 1 << 6; // 冗長な4バイト文字
+  const std::uint8_t TWO_CONTS   = 1 << 7; // 継続バイトが2つ続く
+  const std::uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+  auto nibble = _mm256_set1_epi8(0x0F);
+  // 末尾の 3 バイトが文字の途中で終わっているかを調べるための値
+  auto incomplete_max = _mm256_setr_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    static_cast<char>(0xF0 - 1),
+    static_cast<char>(0xE0 - 1),
+    static_cast<char>(0xC0 - 1));
+  auto prev_input = _mm256_setzero_si256();
+  auto prev_incomplete = _mm256_setzero_si256();
+  // ここより前は正しい文字の並びであることがわかっている位置
+  auto safe = p;
+  while ( end - p >= 32 ) {
+    auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    if ( _mm256_movemask_epi8(input) == 0 ) {
+      // すべて ASCII
+      if ( !_mm256_testz_si256(prev_incomplete, prev_incomplete) ) {
+	break;
+      }
+      prev_input = input;
+      p += 32;
+      safe = p;
+      continue;
+    }
+
+    auto prev1 = prev_bytes<1>(input, prev_input);
+    auto prev1_hi = _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble);
+    auto prev1_lo = _mm256_and_si256(prev1, nibble);
+    auto input_hi = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble);
+    auto byte_1_high = lookup16(
+      prev1_hi,
+      // 0_______ : ASCII
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      // 10______ : 継続バイト
+      TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+      // 1100____ : 2バイト文字の先頭
+      TOO_SHORT | OVERLONG_2,
+      // 1101____ : 2バイト文字の先頭
+      TOO_SHORT,
+      // 1110____ : 3バイト文字の先頭
+      TOO_SHORT | OVERLONG_3 | SURROGATE,
+      // 1111____ : 4バイト文字の先頭
+      TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+    auto byte_1_low = lookup16(
+      prev1_lo,
+      // ____0000
+      CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+      // ____0001
+      CARRY | OVERLONG_2,
+      // ____001_
+      CARRY,
+      CARRY,
+      // ____0100
+      CARRY | TOO_LARGE,
+      // ____0101 以降
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      // ____1101
+      CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000);
+    auto byte_2_high = lookup16(
+      input_hi,
+      // 0_______ : ASCII
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      // 1000____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+      // 1001____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+      // 101_____
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+      // 11______ : 先頭バイト
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+    auto special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low),
+				    byte_2_high);
+
+    // 2バイト前が 3/4 バイト文字の先頭か 3バイト前が 4バイト文字の先頭なら
+    // 継続バイトでなければならない．
+    auto prev2 = prev_bytes<2>(input, prev_input);
+    auto prev3 = prev_bytes<3>(input, prev_input);
+    auto is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    auto is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+    auto must23 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+				   _mm256_set1_epi8(static_cast<char>(0x80)));
+    auto error = _mm256_xor_si256(must23, special);
+    if ( !_mm256_testz_si256(error, error) ) {
+      break;
+    }
+
+    prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+    prev_input = input;
+    p += 32;
+    if ( _mm256_testz_si256(prev_incomplete, prev_incomplete) ) {
+      safe = p;
+    }
+  }
+  // SSE2 版に切り替える前に AVX の状態を戻しておく．
+  _mm256_zeroupper();
+  return validate_utf8_sse2(safe, end);
+}
+
+#endif // JSON_SIMD_X86
+
+// 関数テーブル
+const JsonSimd::FuncTable scalar_table = {
+  JsonSimd::Scalar,
+  skip_blank_scalar,
+  skip_digits_scalar,
+  find_string_special_scalar,
+  find_structural_scalar,
+  validate_utf8_scalar
+};
+
+#if defined(JSON_SIMD_X86)
+const JsonSimd::FuncTable sse2_table = {
+  JsonSimd::Sse2,
+  skip_blank_sse2,
+  skip_digits_sse2,
+  find_string_special_sse2,
+  find_structural_sse2,
+  validate_utf8_sse2
+};
+
+const JsonSimd::FuncTable avx2_table = {
+  JsonSimd::Avx2,
+  skip_blank_avx2,
+  skip_digits_avx2,
+  find_string_special_avx2,
+  find_structural_avx2,
+  validate_utf8_avx2
+};
+#endif
+
+// 指定された種類の関数テーブルを返す．
+// サポートされていない場合は nullptr を返す．
+const JsonSimd::FuncTable*
+find_table(
+  JsonSimd::Mode mode
+)
+{
+  switch ( mode ) {
+  case JsonSimd::Scalar:
+    return &scalar_table;
+
+#if defined(JSON_SIMD_X86)
+  case JsonSimd::Sse2:
+    return &sse2_table;
+
+  case JsonSimd::Avx2:
+    if ( __builtin_cpu_supports("avx2") ) {
+      return &avx2_table;
+    }
+    break;
+#endif
+
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+// CPU が使える最良の関数テーブルを返す．
+const JsonSimd::FuncTable*
+best_table()
+{
+  for ( auto mode: {JsonSimd::Avx2, JsonSimd::Sse2} ) {
+    auto table = find_table(mode);
+    if ( table != nullptr ) {
+      return table;
+    }
+  }
+  return &scalar_table;
+}
+
+END_NONAMESPACE
+
+// @brief 実装の種類を切り替える．
+bool
+JsonSimd::set_mode(
+  Mode mode
+)
+{
+  auto table = find_table(mode);
+  if ( table == nullptr ) {
+    return false;
+  }
+  cur_table().store(table, std::memory_order_relaxed);
+  return true;
+}
+
+// @brief 現在の関数テーブルを格納している変数を返す．
+std::atomic<const JsonSimd::FuncTable*>&
+JsonSimd::cur_table()
+{
+  static std::atomic<const FuncTable*> table{best_table()};
+  return table;
+}
+
+END_NAMESPACE_YM_JSON
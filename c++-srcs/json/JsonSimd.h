@@ -0,0 +1,203 @@
+#ifndef JSONSIMD_H
+#define JSONSIMD_H
+
+/// @file JsonSimd.h
+/// @brief JsonSimd のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonSimd JsonSimd.h "JsonSimd.h"
+/// @brief JsonScanner 用の文字クラス判定をまとめて行う関数群
+///
+/// 16/32 バイト単位で文字を分類して最初に条件を満たさなくなる位置を求める．
+/// 実装は実行時に CPU を調べて以下の中から選ぶ．
+/// - AVX2 (32バイト単位)
+/// - SSE2 (16バイト単位)
+/// - スカラー
+///
+/// 実際には static メンバ関数しか持たないのでクラスではない．
+//////////////////////////////////////////////////////////////////////
+class JsonSimd
+{
+public:
+
+  /// @brief 実装の種類
+  enum Mode {
+    Scalar, ///< スカラー
+    Sse2,   ///< SSE2
+    Avx2    ///< AVX2
+  };
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 実装の関数テーブル
+  ///
+  /// 実装ファイル中でのみ用いられる．
+  struct FuncTable
+  {
+    // 実装の種類
+    Mode mMode;
+
+    // skip_blank() の実体
+    const char* (*mSkipBlank)(const char*, const char*);
+
+    // skip_digits() の実体
+    const char* (*mSkipDigits)(const char*, const char*);
+
+    // find_string_special() の実体
+    const char* (*mFindStringSpecial)(const char*, const char*, char);
+
+    // find_structural() の実体
+    const char* (*mFindStructural)(const char*, const char*);
+
+    // validate_utf8() の実体
+    const char* (*mValidateUtf8)(const char*, const char*);
+  };
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 空白(' ', '\t')でない最初の文字の位置を返す．
+  /// @return 見つからなければ end を返す．
+  static
+  const char*
+  skip_blank(
+    const char* p,  ///< [in] 先頭
+    const char* end ///< [in] 末尾
+  )
+  {
+    return table().mSkipBlank(p, end);
+  }
+
+  /// @brief 数字('0'〜'9')でない最初の文字の位置を返す．
+  /// @return 見つからなければ end を返す．
+  static
+  const char*
+  skip_digits(
+    const char* p,  ///< [in] 先頭
+    const char* end ///< [in] 末尾
+  )
+  {
+    return table().mSkipDigits(p, end);
+  }
+
+  /// @brief 文字列中で特別な処理が必要な最初の文字の位置を返す．
+  /// @return 見つからなければ end を返す．
+  ///
+  /// 対象となるのは以下の文字
+  /// - 終端文字(quote)
+  /// - '\\'
+  /// - 制御文字(0x20 未満と 0x7F)
+  ///
+  /// 0x80 以上の文字は UTF-8 の一部とみなして対象としない．
+  /// 必要ならば validate_utf8() で検査する．
+  static
+  const char*
+  find_string_special(
+    const char* p,   ///< [in] 先頭
+    const char* end, ///< [in] 末尾
+    char quote       ///< [in] 終端文字
+  )
+  {
+    return table().mFindStringSpecial(p, end, quote);
+  }
+
+  /// @brief 配列やオブジェクトを読み飛ばす際に調べる必要がある最初の文字の位置を返す．
+  /// @return 見つからなければ end を返す．
+  ///
+  /// 対象となるのは以下の文字
+  /// - 括弧('{', '}', '[', ']')
+  /// - 引用符('"', '\'')
+  /// - 改行文字('\n', '\r')
+  /// - コメントの開始文字('#', '/')
+  static
+  const char*
+  find_structural(
+    const char* p,  ///< [in] 先頭
+    const char* end ///< [in] 末尾
+  )
+  {
+    return table().mFindStructural(p, end);
+  }
+
+  /// @brief 正しい UTF-8 の並びでなくなる最初の位置を返す．
+  /// @return 全て正しければ end を返す．
+  ///
+  /// p は文字の先頭でなければならない．
+  /// 冗長な符号化，サロゲート，0x10FFFF を超える符号は誤りとする．
+  /// end で途中が切れている文字はその先頭の位置を返す．
+  static
+  const char*
+  validate_utf8(
+    const char* p,  ///< [in] 先頭
+    const char* end ///< [in] 末尾
+  )
+  {
+    return table().mValidateUtf8(p, end);
+  }
+
+  /// @brief 現在の実装の種類を返す．
+  static
+  Mode
+  mode()
+  {
+    return table().mMode;
+  }
+
+  /// @brief 実装の種類を切り替える．
+  /// @return 切り替えられた時 true を返す．
+  ///
+  /// CPU がサポートしていない種類を指定した場合は何もしない．
+  /// テスト用の関数
+  /// 関数テーブルは不可分に切り替えるので他のスレッドが走査中でもよい．
+  /// 走査の途中で実装が切り替わることはあるが，どの実装も結果は同じとなる．
+  static
+  bool
+  set_mode(
+    Mode mode ///< [in] 実装の種類
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の関数テーブルを返す．
+  static
+  const FuncTable&
+  table()
+  {
+    // 関数テーブル自体は定数なので順序の保証は必要ない．
+    return *cur_table().load(std::memory_order_relaxed);
+  }
+
+  /// @brief 現在の関数テーブルを格納している変数を返す．
+  ///
+  /// 最初に呼ばれた時に CPU を調べて初期化する．
+  /// 並列に読み込むスレッドから参照されるので不可分な変数にしておく．
+  static
+  std::atomic<const FuncTable*>&
+  cur_table();
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONSIMD_H
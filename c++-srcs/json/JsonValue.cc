@@ -7,171 +7,140 @@
 /// All rights reserved.
 
 #include "ym/JsonValue.h"
+#include "ym/JsonWriter.h"
+#include "ym/DecompIStream.h"
 #include "JsonObj.h"
 #include "JsonParser.h"
+#include "JsonDocument.h"
+#include "JsonBinEncoder.h"
+#include "JsonBinDecoder.h"
+#include "MappedFile.h"
 
 
 BEGIN_NAMESPACE_YM_JSON
 
-// @brief 空のコンストラクタ
-JsonValue::JsonValue()
-{
-}
+BEGIN_NONAMESPACE
+
+// メモリ上の内容をそのまま読み出す streambuf
+class ViewStreamBuf :
+  public std::streambuf
+{
+public:
+
+  // コンストラクタ
+  explicit
+  ViewStreamBuf(
+    std::string_view data
+  )
+  {
+    // 読み出すだけなので const を外しても書き換えられることはない．
+    auto p = const_cast<char*>(data.data());
+    setg(p, p, p + data.size());
+  }
+
+};
+
+END_NONAMESPACE
 
 // @brief 文字列型のコンストラクタ
 JsonValue::JsonValue(
   const char* value
-) : mPtr{new JsonString{value}}
+) : JsonValue{new JsonString{value}}
 {
 }
 
 // @brief 文字列型のコンストラクタ
 JsonValue::JsonValue(
   const std::string& value
-) : mPtr{new JsonString{value}}
+) : JsonValue{new JsonString{value}}
 {
 }
 
-// @brief 整数型のコンストラクタ
+// @brief 配列型のコンストラクタ
 JsonValue::JsonValue(
-  int value
-) : mPtr{new JsonInt{value}}
+  const std::vector<JsonValue>& value
+) : JsonValue{new JsonArray{value}}
 {
 }
 
-// @brief 浮動小数点型のコンストラクタ
+// @brief 配列型のコンストラクタ(ムーブ版)
 JsonValue::JsonValue(
-  double value
-) : mPtr{new JsonFloat{value}}
+  std::vector<JsonValue>&& value
+) : JsonValue{new JsonArray{std::move(value)}}
 {
 }
 
-BEGIN_NONAMESPACE
-
-inline
-JsonObj*
-new_JsonBool(
-  bool value
-)
+// @brief オブジェクト型のコンストラクタ
+JsonValue::JsonValue(
+  const std::unordered_map<std::string, JsonValue>& value
+) : JsonValue{new JsonDict{value}}
 {
-  if ( value ) {
-    return new JsonTrue;
-  }
-  else {
-    return new JsonFalse;
-  }
 }
 
-END_NONAMESPACE
-
-// @brief ブール型のコンストラクタ
+// @brief オブジェクト型のコンストラクタ(ムーブ版)
 JsonValue::JsonValue(
-  bool value
-) : mPtr{new_JsonBool(value)}
+  std::unordered_map<std::string, JsonValue>&& value
+) : JsonValue{new JsonDict{std::move(value)}}
 {
 }
 
-// @brief 配列型のコンストラクタ
+// @brief オブジェクト型のコンストラクタ(挿入順版)
 JsonValue::JsonValue(
-  const std::vector<JsonValue>& value
-) : mPtr{new JsonArray{value}}
+  const std::vector<std::pair<std::string, JsonValue>>& item_list
+) : JsonValue{new JsonDict{item_list}}
 {
 }
 
-// @brief オブジェクト型のコンストラクタ
+// @brief オブジェクト型のコンストラクタ(挿入順のムーブ版)
 JsonValue::JsonValue(
-  const std::unordered_map<std::string, JsonValue>& value
-) : mPtr{new JsonDict{value}}
+  std::vector<std::pair<std::string, JsonValue>>&& item_list
+) : JsonValue{new JsonDict{std::move(item_list)}}
 {
 }
 
 // @brief 値を指定したコンストラクタ
 JsonValue::JsonValue(
   JsonObj* value
-) : mPtr{std::shared_ptr<JsonObj>{value}}
-{
-}
-
-// @brief デストラクタ
-JsonValue::~JsonValue()
-{
-}
-
-// @brief null型の時 true を返す．
-bool
-JsonValue::is_null() const
-{
-  return mPtr.get() == nullptr;
-}
-
-// @brief 文字列型の時 true を返す．
-bool
-JsonValue::is_string() const
-{
-  if ( is_null() ) {
-    return false;
-  }
-  return mPtr->is_string();
-}
-
-// @brief 数値型の時 true を返す．
-bool
-JsonValue::is_number() const
-{
-  if ( is_null() ) {
-    return false;
-  }
-  return mPtr->is_int() || mPtr->is_float();
-}
-
-// @brief 整数型の時 true を返す．
-bool
-JsonValue::is_int() const
+)
 {
-  if ( is_null() ) {
-    return false;
+  if ( value != nullptr ) {
+    mBody.mObj = value;
+    mType = value->type();
+    _inc_ref();
   }
-  return mPtr->is_int();
 }
 
-// @brief 浮動小数点型の時 true を返す．
-bool
-JsonValue::is_float() const
+// @brief JsonObj を指す値を作る．
+JsonValue
+JsonValue::_from_obj(
+  JsonObj* obj,
+  bool borrowed
+)
 {
-  if ( is_null() ) {
-    return false;
+  if ( !borrowed ) {
+    return JsonValue{obj};
   }
-  return mPtr->is_float();
-}
-
-// @brief ブール型の時 true を返す．
-bool
-JsonValue::is_bool() const
-{
-  if ( is_null() ) {
-    return false;
+  JsonValue ans;
+  if ( obj != nullptr ) {
+    ans.mBody.mObj = obj;
+    ans.mType = obj->type();
+    ans.mBorrowed = true;
   }
-  return mPtr->is_bool();
+  return ans;
 }
 
-// @brief オブジェクト型の時 true を返す．
-bool
-JsonValue::is_object() const
+// @brief JsonObj の参照回数を増やす．
+void
+JsonValue::_inc_ref() const
 {
-  if ( is_null() ) {
-    return false;
-  }
-  return mPtr->is_object();
+  mBody.mObj->inc_ref();
 }
 
-// @brief 配列型の時 true を返す．
-bool
-JsonValue::is_array() const
+// @brief JsonObj の参照回数を減らす．
+void
+JsonValue::_dec_ref() const
 {
-  if ( is_null() ) {
-    return false;
-  }
-  return mPtr->is_array();
+  mBody.mObj->dec_ref();
 }
 
 // @brief 配列の要素数を得る．
@@ -179,7 +148,7 @@ SizeType
 JsonValue::size() const
 {
   _check_object_or_array();
-  return mPtr->size();
+  return mBody.mObj->size();
 }
 
 // @brief オブジェクトがキーを持つか調べる．
@@ -189,7 +158,7 @@ JsonValue::has_key(
 ) const
 {
   _check_object();
-  return mPtr->has_key(key);
+  return mBody.mObj->has_key(key);
 }
 
 // @brief キーのリストを返す．
@@ -197,7 +166,7 @@ std::vector<std::string>
 JsonValue::key_list() const
 {
   _check_object();
-  return mPtr->key_list();
+  return mBody.mObj->key_list();
 }
 
 // @brief キーと値のリストを返す．
@@ -205,7 +174,42 @@ std::vector<std::pair<std::string, JsonValue>>
 JsonValue::item_list() const
 {
   _check_object();
-  return mPtr->item_list();
+  auto item_list = mBody.mObj->item_list();
+  for ( auto& p: item_list ) {
+    p.second = p.second._own();
+  }
+  return item_list;
+}
+
+// @brief 配列の要素をたどる範囲を返す．
+JsonValue::ElemRange
+JsonValue::elements() const
+{
+  _check_array();
+  auto obj = static_cast<const JsonArray*>(mBody.mObj->resolve());
+  auto& array = obj->elements();
+  return ElemRange{*this, array.data(), array.size()};
+}
+
+// @brief オブジェクトのキーをたどる範囲を返す．
+JsonValue::KeyRange
+JsonValue::keys() const
+{
+  static_assert( std::is_same_v<JsonDict::ItemType, JsonKeyConv::ElemType> );
+  _check_object();
+  auto obj = static_cast<const JsonDict*>(mBody.mObj->resolve());
+  auto& item_list = obj->items();
+  return KeyRange{*this, item_list.data(), item_list.size()};
+}
+
+// @brief オブジェクトのキーと値の対をたどる範囲を返す．
+JsonValue::ItemRange
+JsonValue::items() const
+{
+  _check_object();
+  auto obj = static_cast<const JsonDict*>(mBody.mObj->resolve());
+  auto& item_list = obj->items();
+  return ItemRange{*this, item_list.data(), item_list.size()};
 }
 
 // @brief オブジェクトの要素を得る．
@@ -215,7 +219,7 @@ JsonValue::at(
 ) const
 {
   _check_object();
-  return mPtr->get_value(key);
+  return mBody.mObj->get_value(key)._own();
 }
 
 // @brief キーに対応する要素を取り出す．
@@ -238,7 +242,7 @@ JsonValue::at(
 ) const
 {
   _check_array();
-  return mPtr->get_value(pos);
+  return mBody.mObj->get_value(pos)._own();
 }
 
 // @brief 文字列を得る．
@@ -246,61 +250,205 @@ std::string
 JsonValue::get_string() const
 {
   _check_string();
-  return mPtr->get_string();
+  return mBody.mObj->get_string();
+}
+
+// @brief 文字列をコピーせずに得る．
+std::string_view
+JsonValue::get_string_view() const
+{
+  _check_string();
+  return static_cast<const JsonString*>(mBody.mObj)->str();
 }
 
-// @brief 整数値を得る．
-int
-JsonValue::get_int() const
+// @brief オブジェクトの要素を設定する．
+void
+JsonValue::set(
+  const std::string& key,
+  const JsonValue& value
+)
+{
+  _check_object();
+  // value が自身を指している場合にも正しく複製されるように
+  // 先に所有権を持たせておく．
+  auto value1 = value._own();
+  _unshare()->set_value(key, value1);
+}
+
+// @brief 配列の要素を設定する．
+void
+JsonValue::set(
+  SizeType pos,
+  const JsonValue& value
+)
 {
-  _check_int();
-  return mPtr->get_int();
+  _check_array();
+  if ( size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  auto value1 = value._own();
+  _unshare()->set_value(pos, value1);
 }
 
-// @brief 浮動小数点値を得る．
-double
-JsonValue::get_float() const
+// @brief 配列の末尾に要素を追加する．
+void
+JsonValue::push_back(
+  const JsonValue& value
+)
 {
-  _check_float();
-  return mPtr->get_float();
+  _check_array();
+  auto value1 = value._own();
+  _unshare()->push_back(value1);
 }
 
-// @brief ブール値を得る．
+// @brief オブジェクトの要素を削除する．
 bool
-JsonValue::get_bool() const
+JsonValue::erase(
+  const std::string& key
+)
+{
+  _check_object();
+  if ( !mBody.mObj->has_key(key) ) {
+    // 何もしない場合は複製しない．
+    return false;
+  }
+  return _unshare()->erase(key);
+}
+
+// @brief 配列の要素を削除する．
+void
+JsonValue::erase(
+  SizeType pos
+)
 {
-  _check_bool();
-  return mPtr->get_bool();
+  _check_array();
+  if ( size() <= pos ) {
+    throw std::out_of_range("pos is out of range");
+  }
+  _unshare()->erase(pos);
+}
+
+// @brief 書き換えのために JsonObj を他と共有しない形にする．
+JsonObj*
+JsonValue::_unshare()
+{
+  auto obj = mBody.mObj;
+  if ( !mBorrowed && obj->is_unique() ) {
+    return obj;
+  }
+  // 遅延ノードの場合は実体を複製する．
+  auto new_obj = obj->resolve()->clone();
+  new_obj->inc_ref();
+  if ( _is_owner() ) {
+    _dec_ref();
+  }
+  mBody.mObj = new_obj;
+  mBorrowed = false;
+  return new_obj;
 }
 
 // @brief 読み込む．
 JsonValue
 JsonValue::read(
-  const std::string& filename
+  const std::string& filename,
+  bool lazy,
+  bool intern
 )
 {
-  std::ifstream s{filename};
-  if ( !s ) {
-    std::ostringstream buf;
-    buf << filename << ": No such file";
-    throw std::invalid_argument{buf.str()};
+  if ( lazy && intern ) {
+    throw std::invalid_argument("intern cannot be used in lazy mode");
   }
-
-  JsonParser parser{s};
+  if ( lazy ) {
+    // マップしたファイルは JsonDocument が保持する．
+    auto file = std::make_unique<MappedFile>(filename);
+    auto doc = new JsonDocument;
+    doc->set_source(std::move(file));
+    JsonParser parser{doc};
+    return parser.read();
+  }
+  // ファイルは一度だけ開いてメモリ上にマップし，
+  // 先頭のマジックナンバーで圧縮形式を判定する．
+  MappedFile file{filename, false};
+  if ( file.format() != DecompIStream::Format::Plain ) {
+    // 圧縮されたファイルはマップした内容を展開しながら読み込む．
+    ViewStreamBuf buf{file.view()};
+    std::istream src{&buf};
+    DecompIStream s{src};
+    JsonParser parser{s};
+    parser.set_intern(intern);
+    return parser.read();
+  }
+  // マップした内容を直接走査する．
+  JsonParser parser{file.view()};
+  parser.set_intern(intern);
   return parser.read();
 }
 
 // @brief JSON文字列をパースする．
 JsonValue
 JsonValue::parse(
-  const std::string& json_str
+  std::string_view json_str,
+  bool lazy,
+  bool intern
 )
 {
-  std::istringstream s{json_str};
-  JsonParser parser{s};
+  if ( lazy && intern ) {
+    throw std::invalid_argument("intern cannot be used in lazy mode");
+  }
+  if ( lazy ) {
+    auto doc = new JsonDocument;
+    doc->set_source(json_str);
+    JsonParser parser{doc};
+    return parser.read();
+  }
+  JsonParser parser{json_str};
+  parser.set_intern(intern);
   return parser.read();
 }
 
+// @brief 複数のスレッドで読み込む．
+JsonValue
+JsonValue::read_parallel(
+  const std::string& filename,
+  SizeType thread_num,
+  bool intern
+)
+{
+  MappedFile file{filename};
+  return JsonParser::read_parallel(file.view(), thread_num, intern);
+}
+
+// @brief 複数のスレッドで JSON文字列をパースする．
+JsonValue
+JsonValue::parse_parallel(
+  std::string_view json_str,
+  SizeType thread_num,
+  bool intern
+)
+{
+  return JsonParser::read_parallel(json_str, thread_num, intern);
+}
+
+// @brief バイナリ形式で書き出す．
+void
+JsonValue::dump(
+  BinEnc& s
+) const
+{
+  JsonBinEncoder enc{s};
+  enc.write(*this);
+}
+
+// @brief dump() で書き出した内容を読み込む．
+JsonValue
+JsonValue::restore(
+  BinDec& s
+)
+{
+  JsonBinDecoder dec{s};
+  return dec.read();
+}
+
 // @brief 内容を JSON 文字列に変換する．
 std::string
 JsonValue::to_json(
@@ -310,33 +458,75 @@ JsonValue::to_json(
   if ( is_null() ) {
     return std::string{"null"};
   }
-  int indent_val = -1;
-  if ( indent ) {
-    indent_val = 0;
-  }
-  auto ans = mPtr->to_json(indent_val);
-  if ( indent ) {
-    ans += '\n';
+  std::string ans;
+  {
+    JsonWriter writer{ans, indent};
+    writer.write_value(*this);
   }
   return ans;
 }
 
+// @brief 内容を書き出す．
+void
+JsonValue::write(
+  std::ostream& s,
+  bool indent
+) const
+{
+  if ( is_null() ) {
+    s << "null";
+    return;
+  }
+  JsonWriter writer{s, indent};
+  writer.write_value(*this);
+}
+
+// @brief 構造に基づくハッシュ値を返す．
+SizeType
+JsonValue::hash() const
+{
+  switch ( mType ) {
+  case Type::Null:
+    return JsonObj::mix_hash(0);
+  case Type::Bool:
+    return JsonObj::mix_hash(mBody.mBool ? 2 : 1);
+  case Type::Int:
+    return JsonObj::mix_hash(std::hash<std::int64_t>{}(mBody.mInt) * 7 + 3);
+  case Type::Float:
+    {
+      // 0.0 と -0.0 は operator== で等しいので同じ値にする．
+      auto v = mBody.mFloat == 0.0 ? 0.0 : mBody.mFloat;
+      return JsonObj::mix_hash(std::hash<double>{}(v) * 7 + 4);
+    }
+  default:
+    break;
+  }
+  return mBody.mObj->hash();
+}
+
 // @brief 等価比較演算子
 bool
 JsonValue::operator==(
   const JsonValue& right
 ) const
 {
-  if ( mPtr != nullptr ) {
-    if (  right.mPtr != nullptr ) {
-      return mPtr->is_eq(right.mPtr.get());
-    }
+  if ( mType != right.mType ) {
     return false;
   }
-  if ( right.mPtr == nullptr ) {
+  switch ( mType ) {
+  case Type::Null:   return true;
+  case Type::Bool:   return mBody.mBool == right.mBody.mBool;
+  case Type::Int:    return mBody.mInt == right.mBody.mInt;
+  case Type::Float:  return mBody.mFloat == right.mBody.mFloat;
+  default: break;
+  }
+  auto obj1 = mBody.mObj->resolve();
+  auto obj2 = right.mBody.mObj->resolve();
+  if ( obj1 == obj2 ) {
+    // 共有されている部分木は比較する必要がない．
     return true;
   }
-  return false;
+  return obj1->is_eq(obj2);
 }
 
 // @brief ストリーム入力演算子
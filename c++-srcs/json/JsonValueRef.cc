@@ -0,0 +1,84 @@
+
+/// @file JsonValueRef.cc
+/// @brief JsonValueRef の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonValueRef.h"
+#include "JsonObj.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonValueRef
+//////////////////////////////////////////////////////////////////////
+
+// @brief 配列の要素をたどる範囲を返す．
+JsonValueRef::ElemRange
+JsonValueRef::elements() const
+{
+  mValue._check_array();
+  auto obj = static_cast<const JsonArray*>(mValue.mBody.mObj->resolve());
+  auto& array = obj->elements();
+  // mValue は所有権を持たないので範囲も参照回数を操作しない．
+  return ElemRange{mValue, array.data(), array.size()};
+}
+
+// @brief オブジェクトのキーをたどる範囲を返す．
+JsonValueRef::KeyRange
+JsonValueRef::keys() const
+{
+  mValue._check_object();
+  auto obj = static_cast<const JsonDict*>(mValue.mBody.mObj->resolve());
+  auto& item_list = obj->items();
+  return KeyRange{mValue, item_list.data(), item_list.size()};
+}
+
+// @brief オブジェクトのキーと値の対をたどる範囲を返す．
+JsonValueRef::ItemRange
+JsonValueRef::items() const
+{
+  mValue._check_object();
+  auto obj = static_cast<const JsonDict*>(mValue.mBody.mObj->resolve());
+  auto& item_list = obj->items();
+  return ItemRange{mValue, item_list.data(), item_list.size()};
+}
+
+// @brief オブジェクトの要素を得る．
+JsonValueRef
+JsonValueRef::at(
+  const std::string& key
+) const
+{
+  mValue._check_object();
+  // get_value() は所有権を持たない形で値を返す．
+  return _from_borrowed(mValue.mBody.mObj->get_value(key));
+}
+
+// @brief キーに対応する要素を取り出す．
+JsonValueRef
+JsonValueRef::get(
+  const std::string& key
+) const
+{
+  mValue._check_object();
+  if ( mValue.mBody.mObj->has_key(key) ) {
+    return at(key);
+  }
+  return JsonValueRef{};
+}
+
+// @brief 配列の要素を得る．
+JsonValueRef
+JsonValueRef::at(
+  SizeType pos
+) const
+{
+  mValue._check_array();
+  return _from_borrowed(mValue.mBody.mObj->get_value(pos));
+}
+
+END_NAMESPACE_YM_JSON
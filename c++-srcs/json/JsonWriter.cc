@@ -0,0 +1,330 @@
+
+/// @file JsonWriter.cc
+/// @brief JsonWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/JsonWriter.h"
+#include "ym/JsonValue.h"
+#include "JsonObj.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief 出力ストリームを指定したコンストラクタ
+JsonWriter::JsonWriter(
+  std::ostream& s,
+  bool indent
+) : mS{&s},
+    mOut{&mBuff},
+    mIndent{indent}
+{
+  mBuff.reserve(FLUSH_SIZE + 1024);
+}
+
+// @brief 出力先の文字列を指定したコンストラクタ
+JsonWriter::JsonWriter(
+  std::string& buff,
+  bool indent
+) : mOut{&buff},
+    mIndent{indent}
+{
+}
+
+// @brief デストラクタ
+JsonWriter::~JsonWriter()
+{
+  flush();
+}
+
+// @brief オブジェクトの開始
+void
+JsonWriter::object_begin()
+{
+  value_begin();
+  *mOut += '{';
+  if ( mIndent ) {
+    *mOut += '\n';
+  }
+  mStack.push_back({true, true});
+}
+
+// @brief オブジェクトの終了
+void
+JsonWriter::object_end()
+{
+  if ( mStack.empty() || !mStack.back().mIsObject || mAfterKey ) {
+    error("object_end() without matching object_begin()");
+  }
+  mStack.pop_back();
+  if ( mIndent ) {
+    *mOut += '\n';
+    write_tab(mStack.size());
+  }
+  *mOut += '}';
+  value_end();
+}
+
+// @brief 配列の開始
+void
+JsonWriter::array_begin()
+{
+  value_begin();
+  *mOut += '[';
+  if ( mIndent ) {
+    *mOut += '\n';
+  }
+  mStack.push_back({false, true});
+}
+
+// @brief 配列の終了
+void
+JsonWriter::array_end()
+{
+  if ( mStack.empty() || mStack.back().mIsObject ) {
+    error("array_end() without matching array_begin()");
+  }
+  mStack.pop_back();
+  if ( mIndent ) {
+    *mOut += '\n';
+    write_tab(mStack.size());
+  }
+  *mOut += ']';
+  value_end();
+}
+
+// @brief オブジェクトのキーを出力する．
+void
+JsonWriter::write_key(
+  std::string_view key
+)
+{
+  if ( mStack.empty() || !mStack.back().mIsObject || mAfterKey ) {
+    error("write_key() outside of an object");
+  }
+  write_sep();
+  write_quoted(key);
+  *mOut += ':';
+  mAfterKey = true;
+}
+
+// @brief null を出力する．
+void
+JsonWriter::write_null()
+{
+  value_begin();
+  *mOut += "null";
+  value_end();
+}
+
+// @brief ブール値を出力する．
+void
+JsonWriter::write_bool(
+  bool value
+)
+{
+  value_begin();
+  *mOut += value ? "true" : "false";
+  value_end();
+}
+
+// @brief 整数値を出力する．
+void
+JsonWriter::write_int(
+  std::int64_t value
+)
+{
+  value_begin();
+  char buf[24];
+  auto res = std::to_chars(buf, buf + sizeof(buf), value);
+  mOut->append(buf, res.ptr - buf);
+  value_end();
+}
+
+// @brief 浮動小数点値を出力する．
+void
+JsonWriter::write_float(
+  double value
+)
+{
+  if ( !std::isfinite(value) ) {
+    // JSON には無限大と NaN の表記がないので読み戻せない．
+    error("non-finite float value");
+  }
+  value_begin();
+  char buf[32];
+  auto res = std::to_chars(buf, buf + sizeof(buf), value);
+  mOut->append(buf, res.ptr - buf);
+  if ( std::find_if(buf, res.ptr,
+		    [](char c) { return c == '.' || c == 'e'; }) == res.ptr ) {
+    // 整数と同じ表記になっている．
+    *mOut += ".0";
+  }
+  value_end();
+}
+
+// @brief 文字列を出力する．
+void
+JsonWriter::write_string(
+  std::string_view value
+)
+{
+  value_begin();
+  write_quoted(value);
+  value_end();
+}
+
+// @brief JsonValue の内容を出力する．
+void
+JsonWriter::write_value(
+  const JsonValue& value
+)
+{
+  switch ( value.mType ) {
+  case JsonValue::Type::Null:
+    write_null();
+    break;
+
+  case JsonValue::Type::Bool:
+    write_bool(value.mBody.mBool);
+    break;
+
+  case JsonValue::Type::Int:
+    write_int(value.mBody.mInt);
+    break;
+
+  case JsonValue::Type::Float:
+    write_float(value.mBody.mFloat);
+    break;
+
+  default:
+    value.mBody.mObj->write(*this);
+    break;
+  }
+}
+
+// @brief バッファの内容を書き出す．
+void
+JsonWriter::flush()
+{
+  if ( mS != nullptr && !mBuff.empty() ) {
+    mS->write(mBuff.data(), mBuff.size());
+    mBuff.clear();
+  }
+}
+
+// @brief 値を出力する前の処理を行う．
+void
+JsonWriter::value_begin()
+{
+  if ( mStack.empty() ) {
+    return;
+  }
+  if ( mStack.back().mIsObject ) {
+    if ( !mAfterKey ) {
+      error("value without a key in an object");
+    }
+    mAfterKey = false;
+  }
+  else {
+    write_sep();
+  }
+}
+
+// @brief 値を出力した後の処理を行う．
+void
+JsonWriter::value_end()
+{
+  if ( mStack.empty() && mIndent ) {
+    // トップレベルの値の終わり
+    *mOut += '\n';
+  }
+  check_flush();
+}
+
+// @brief 要素の区切りとインデントを出力する．
+void
+JsonWriter::write_sep()
+{
+  auto& frame = mStack.back();
+  if ( frame.mFirst ) {
+    frame.mFirst = false;
+  }
+  else {
+    *mOut += ',';
+    if ( mIndent ) {
+      *mOut += '\n';
+    }
+  }
+  if ( mIndent ) {
+    write_tab(mStack.size());
+  }
+}
+
+// @brief インデントを出力する．
+void
+JsonWriter::write_tab(
+  SizeType n
+)
+{
+  mOut->append(n * 4, ' ');
+}
+
+// @brief 文字列をクオートして出力する．
+void
+JsonWriter::write_quoted(
+  std::string_view str
+)
+{
+  // JsonScanner の復号の逆を行う．
+  // 常に double-quote を用い，そのままでは読み込めない文字をエスケープする．
+  static const char HEX[] = "0123456789abcdef";
+  *mOut += '"';
+  auto start = str.begin();
+  for ( auto p = str.begin(); p != str.end(); ++ p ) {
+    auto c = static_cast<unsigned char>(*p);
+    if ( c >= 0x20 && c != '"' && c != '\\' && c != 0x7F ) {
+      continue;
+    }
+    // エスケープの必要のない部分はまとめて出力する．
+    mOut->append(start, p);
+    start = p + 1;
+    *mOut += '\\';
+    switch ( c ) {
+    case '"':  *mOut += '"'; break;
+    case '\\': *mOut += '\\'; break;
+    case '\b': *mOut += 'b'; break;
+    case '\f': *mOut += 'f'; break;
+    case '\n': *mOut += 'n'; break;
+    case '\r': *mOut += 'r'; break;
+    case '\t': *mOut += 't'; break;
+    default:
+      *mOut += "u00";
+      *mOut += HEX[c >> 4];
+      *mOut += HEX[c & 0xF];
+      break;
+    }
+  }
+  mOut->append(start, str.end());
+  *mOut += '"';
+}
+
+// @brief エラーを送出する．
+void
+JsonWriter::error(
+  const char* msg
+)
+{
+  throw std::invalid_argument{std::string{"JsonWriter: "} + msg};
+}
+
+END_NAMESPACE_YM_JSON
@@ -38,15 +38,15 @@ public:
     int column ///< [in] コラム番号
   )
   {
-    if ( line < 1 || line >= 0x100000 ) {
+    if ( line < 1 ) {
       throw std::invalid_argument{"Loc(line, column): line is out of range"};
     }
-    if ( column < 1 || column >= 0x1000 ) {
+    if ( column < 1 ) {
       throw std::invalid_argument{"Loc(line, column): column is out of range"};
     }
 
-    mLineColumn = (static_cast<std::uint32_t>(line) << 12) |
-      (static_cast<std::uint32_t>(column) & 0xFFFU);
+    mLine = static_cast<std::uint32_t>(line);
+    mColumn = static_cast<std::uint32_t>(column);
   }
 
   /// @brief デストラクタ
@@ -62,18 +62,18 @@ public:
   bool
   is_valid() const
   {
-    return mLineColumn != 0;
+    return mLine != 0;
   }
 
   /// @brief 行番号の取得
   /// @return 行番号
   int
-  line() const { return static_cast<int>(mLineColumn >> 12); }
+  line() const { return static_cast<int>(mLine); }
 
   /// @brief コラム位置の取得
   /// @return コラム位置
   int
-  column() const { return static_cast<int>(mLineColumn & 0xFFFU); }
+  column() const { return static_cast<int>(mColumn); }
 
   /// @brief 等価比較演算子
   /// @retval true 等しい
@@ -83,7 +83,7 @@ public:
     const Loc& right ///< [in] 右のオペランド
   )
   {
-    return mLineColumn == right.mLineColumn;
+    return mLine == right.mLine && mColumn == right.mColumn;
   }
 
   /// @brief 非等価比較演算子
@@ -103,10 +103,14 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 行番号とコラム位置をパックしたもの
-  // 上位 20 ビットが行番号
-  // 下位 12 ビットがコラム位置
-  std::uint32_t mLineColumn{0};
+  // 行番号
+  //
+  // 大きなファイルでも溢れないように
+  // コラム位置とは別に 32 ビットで持つ．
+  std::uint32_t mLine{0};
+
+  // コラム位置
+  std::uint32_t mColumn{0};
 
 };
 
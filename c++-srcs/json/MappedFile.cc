@@ -0,0 +1,128 @@
+
+/// @file MappedFile.cc
+/// @brief MappedFile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MappedFile.h"
+
+#if !defined(YM_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+BEGIN_NONAMESPACE
+
+// ファイルが開けなかった時の例外を送出する．
+void
+open_error(
+  const std::string& filename
+)
+{
+  std::ostringstream buf;
+  buf << filename << ": No such file";
+  throw std::invalid_argument{buf.str()};
+}
+
+END_NONAMESPACE
+
+// @brief コンストラクタ
+MappedFile::MappedFile(
+  const std::string& filename,
+  bool decompress
+)
+{
+  open(filename);
+  mFormat = DecompIStream::detect(view());
+  if ( mFormat != DecompIStream::Format::Plain && decompress ) {
+    // 圧縮されたファイルは展開した内容をバッファに保持する．
+    // コンストラクタが例外で抜けるとデストラクタは呼ばれないので
+    // 展開に失敗した場合はここで解放する．
+    std::string buff;
+    try {
+      buff = DecompIStream::decompress(view());
+    }
+    catch ( ... ) {
+      release();
+      throw;
+    }
+    release();
+    mBuff = std::move(buff);
+    mData = mBuff.data();
+    mSize = mBuff.size();
+  }
+}
+
+// @brief デストラクタ
+MappedFile::~MappedFile()
+{
+  release();
+}
+
+// @brief ファイルを開く．
+void
+MappedFile::open(
+  const std::string& filename
+)
+{
+#if !defined(YM_WIN32)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    open_error(filename);
+  }
+  struct stat st;
+  if ( fstat(fd, &st) == 0 && S_ISREG(st.st_mode) ) {
+    mSize = st.st_size;
+    if ( mSize == 0 ) {
+      // 空のファイルは mmap() できない．
+      close(fd);
+      return;
+    }
+    auto p = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( p != MAP_FAILED ) {
+      // 先頭から順に読むことを伝えておく．
+      madvise(p, mSize, MADV_SEQUENTIAL);
+      close(fd);
+      mData = static_cast<const char*>(p);
+      mMapped = true;
+      return;
+    }
+  }
+  close(fd);
+#endif
+
+  // mmap() が使えない場合は全体を読み込む．
+  std::ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    open_error(filename);
+  }
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  mBuff = buf.str();
+  mData = mBuff.data();
+  mSize = mBuff.size();
+}
+
+// @brief マップした領域を解放する．
+void
+MappedFile::release()
+{
+#if !defined(YM_WIN32)
+  if ( mMapped ) {
+    munmap(const_cast<char*>(mData), mSize);
+    mMapped = false;
+  }
+#endif
+  mBuff.clear();
+  mData = nullptr;
+  mSize = 0;
+}
+
+END_NAMESPACE_YM_JSON
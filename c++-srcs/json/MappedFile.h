@@ -0,0 +1,118 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/// @file MappedFile.h
+/// @brief MappedFile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/DecompIStream.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class MappedFile MappedFile.h "MappedFile.h"
+/// @brief ファイルの内容をメモリ上の連続領域として参照するクラス
+///
+/// 可能な場合には mmap() でファイルをマップする．
+/// mmap() が使えない環境では全体をバッファに読み込む．
+/// gzip や zstd で圧縮されたファイルの場合は展開した内容をバッファに保持する．
+/// 内容はこのオブジェクトが存在する間有効となる．
+//////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ファイルが開けなかった場合や展開に失敗した場合には
+  /// std::invalid_argument 例外を送出する．
+  /// decompress が false の場合は圧縮されたファイルでも展開せずに
+  /// そのままの内容を参照する．
+  /// 圧縮形式は format() で得られる．
+  MappedFile(
+    const std::string& filename, ///< [in] ファイル名
+    bool decompress = true       ///< [in] 展開する時 true
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  MappedFile(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief 代入演算子も禁止
+  MappedFile&
+  operator=(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~MappedFile();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を返す．
+  std::string_view
+  view() const
+  {
+    return std::string_view{mData, mSize};
+  }
+
+  /// @brief ファイルの圧縮形式を返す．
+  DecompIStream::Format
+  format() const
+  {
+    return mFormat;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く．
+  void
+  open(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+  /// @brief マップした領域を解放する．
+  void
+  release();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 先頭のアドレス
+  const char* mData{nullptr};
+
+  // サイズ
+  SizeType mSize{0};
+
+  // mmap() を使わなかった場合のバッファ
+  std::string mBuff;
+
+  // mmap() した時 true にするフラグ
+  bool mMapped{false};
+
+  // ファイルの圧縮形式
+  DecompIStream::Format mFormat{DecompIStream::Format::Plain};
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // MAPPEDFILE_H
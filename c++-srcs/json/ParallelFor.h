@@ -0,0 +1,71 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+/// @file ParallelFor.h
+/// @brief parallel_for() のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+/// @brief スレッド数の指定を解釈する．
+///
+/// 0 の時はハードウェアのスレッド数を返す．
+inline
+SizeType
+resolve_thread_num(
+  SizeType thread_num ///< [in] スレッド数
+)
+{
+  if ( thread_num == 0 ) {
+    thread_num = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  return thread_num;
+}
+
+/// @brief 複数のスレッドで task(i) (0 <= i < n) を実行する．
+///
+/// 各スレッドは i の小さい順に一つずつ取り出して実行する．
+/// 呼び出し元のスレッドも用いる．
+/// task は例外を送出してはいけない．
+template<class Task>
+void
+parallel_for(
+  SizeType thread_num, ///< [in] スレッド数
+  SizeType n,          ///< [in] 実行回数
+  Task task            ///< [in] 実行する関数
+)
+{
+  std::atomic<SizeType> next{0};
+  auto worker = [&]() {
+    for ( ; ; ) {
+      auto i = next ++;
+      if ( i >= n ) {
+	break;
+      }
+      task(i);
+    }
+  };
+  thread_num = std::min(thread_num, n);
+  std::vector<std::thread> thread_list;
+  for ( SizeType i = 1; i < thread_num; ++ i ) {
+    thread_list.emplace_back(worker);
+  }
+  worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+}
+
+END_NAMESPACE_YM_JSON
+
+#endif // PARALLELFOR_H
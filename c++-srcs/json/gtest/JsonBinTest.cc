@@ -0,0 +1,137 @@
+
+/// @file JsonBinTest.cc
+/// @brief JsonValue::dump()/restore() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonValue.h"
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// dump() した内容を返す．
+std::string
+dump_str(
+  const JsonValue& value
+)
+{
+  std::ostringstream s;
+  BinEnc enc{s};
+  value.dump(enc);
+  return s.str();
+}
+
+// 文字列から restore() する．
+JsonValue
+restore_str(
+  const std::string& str
+)
+{
+  std::istringstream s{str};
+  BinDec dec{s};
+  return JsonValue::restore(dec);
+}
+
+END_NONAMESPACE
+
+TEST(JsonBinTest, scalar)
+{
+  for ( auto& value: {JsonValue{},
+		      JsonValue{true},
+		      JsonValue{false},
+		      JsonValue{0},
+		      JsonValue{-1},
+		      JsonValue{std::numeric_limits<std::int64_t>::max()},
+		      JsonValue{std::numeric_limits<std::int64_t>::min()},
+		      JsonValue{0.1},
+		      JsonValue{-HUGE_VAL},
+		      JsonValue{""},
+		      JsonValue{"abc\n\"def\""},
+		      JsonValue{std::string{"a\0b", 3}}} ) {
+    auto value2 = restore_str(dump_str(value));
+    EXPECT_EQ( value, value2 );
+    // 無限大はバイナリ形式では表せるが JSON 文字列にはできない．
+    if ( !value.is_float() || std::isfinite(value.get_float()) ) {
+      EXPECT_EQ( value.to_json(), value2.to_json() );
+    }
+  }
+}
+
+TEST(JsonBinTest, read)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+  auto value = JsonValue::read(path);
+
+  auto value2 = restore_str(dump_str(value));
+  EXPECT_EQ( value, value2 );
+  EXPECT_EQ( value.to_json(), value2.to_json() );
+
+  // 遅延モードの値も全体が書き出される．
+  auto value3 = JsonValue::read(path, true);
+  EXPECT_EQ( dump_str(value), dump_str(value3) );
+}
+
+TEST(JsonBinTest, key_dict)
+{
+  // 同じキーを持つレコードの配列
+  std::vector<JsonValue> rec_list;
+  for ( int i = 0; i < 100; ++ i ) {
+    std::unordered_map<std::string, JsonValue> dict{
+      {"name", JsonValue{"n" + std::to_string(i)}},
+      {"a_very_long_key_name", JsonValue{i}},
+      {"", JsonValue{}}
+    };
+    rec_list.push_back(JsonValue{dict});
+  }
+  rec_list.push_back(JsonValue{std::vector<JsonValue>{}});
+  rec_list.push_back(JsonValue{std::unordered_map<std::string, JsonValue>{}});
+  JsonValue value{rec_list};
+
+  auto str = dump_str(value);
+  // キーの本体は一度しか書き出されない．
+  auto pos = str.find("a_very_long_key_name");
+  ASSERT_NE( std::string::npos, pos );
+  EXPECT_EQ( std::string::npos, str.find("a_very_long_key_name", pos + 1) );
+  EXPECT_LT( str.size(), value.to_json().size() / 2 );
+
+  auto value2 = restore_str(str);
+  EXPECT_EQ( value, value2 );
+  for ( int i = 0; i < 100; ++ i ) {
+    EXPECT_EQ( i, value2[i]["a_very_long_key_name"].get_int() );
+    EXPECT_TRUE( value2[i][""].is_null() );
+    EXPECT_FALSE( value2[i].has_key("undefined") );
+  }
+}
+
+TEST(JsonBinTest, bad)
+{
+  auto str = dump_str(JsonValue::parse("{\"a\": [1, 2], \"b\": {\"a\": 3}}"));
+
+  // シグネチャが異なる．
+  auto str1 = str;
+  str1[0] = 'x';
+  EXPECT_THROW( restore_str(str1), std::invalid_argument );
+
+  // 途中で終わっている．
+  auto str2 = str.substr(0, str.size() - 1);
+  EXPECT_THROW( restore_str(str2), std::ios_base::failure );
+  // シグネチャの途中で終わっている．
+  EXPECT_THROW( restore_str(str.substr(0, 3)), std::ios_base::failure );
+  EXPECT_THROW( restore_str(std::string{}), std::ios_base::failure );
+
+  // 不正なタグ(最後の値は 1バイトのタグと 1バイトの整数)
+  auto str3 = str;
+  str3[str3.size() - 2] = '\x7f';
+  EXPECT_THROW( restore_str(str3), std::invalid_argument );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,161 @@
+
+/// @file JsonBindTest.cc
+/// @brief JsonBind のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonBind.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+struct Point
+{
+  int x{0};
+  int y{0};
+};
+
+struct Record
+{
+  std::string name;
+  double value{0.0};
+  bool flag{false};
+  std::vector<Point> points;
+  std::optional<std::int64_t> opt;
+  std::unordered_map<std::string, int> attr;
+  JsonValue extra;
+};
+
+template<>
+struct JsonFields<Point>
+{
+  static constexpr auto list = std::make_tuple(
+    json_field("x", &Point::x),
+    json_field("y", &Point::y)
+  );
+};
+
+template<>
+struct JsonFields<Record>
+{
+  static constexpr auto list = std::make_tuple(
+    json_field("name", &Record::name),
+    json_field("value", &Record::value),
+    json_field("flag", &Record::flag),
+    json_field("points", &Record::points),
+    json_field("opt", &Record::opt),
+    json_field("attr", &Record::attr),
+    json_field("extra", &Record::extra)
+  );
+};
+
+TEST(JsonBindTest, read)
+{
+  std::string json_str{
+    "[{\"name\": \"a\", \"value\": 1.5, \"flag\": true,"
+    "  \"points\": [{\"x\": 1, \"y\": 2}, {\"y\": 4, \"x\": 3}],"
+    "  \"opt\": 10, \"attr\": {\"p\": 1, \"q\": 2},"
+    "  \"extra\": {\"k\": [null, \"s\"]},"
+    "  \"unknown\": {\"z\": [1, 2, {}]}},"
+    " {\"name\": \"b\", \"value\": 2, \"opt\": null}]"
+  };
+  auto list = parse_json<std::vector<Record>>(json_str);
+  ASSERT_EQ( 2, list.size() );
+
+  auto& rec0 = list[0];
+  EXPECT_EQ( "a", rec0.name );
+  EXPECT_EQ( 1.5, rec0.value );
+  EXPECT_TRUE( rec0.flag );
+  ASSERT_EQ( 2, rec0.points.size() );
+  EXPECT_EQ( 1, rec0.points[0].x );
+  EXPECT_EQ( 2, rec0.points[0].y );
+  EXPECT_EQ( 3, rec0.points[1].x );
+  EXPECT_EQ( 4, rec0.points[1].y );
+  ASSERT_TRUE( rec0.opt.has_value() );
+  EXPECT_EQ( 10, *rec0.opt );
+  EXPECT_EQ( 1, rec0.attr.at("p") );
+  EXPECT_EQ( 2, rec0.attr.at("q") );
+  EXPECT_EQ( JsonValue::parse("{\"k\": [null, \"s\"]}"), rec0.extra );
+  // JsonValue のオブジェクトは入力中の順番を保つ．
+  EXPECT_EQ( R"({"b":1,"a":2})",
+	     parse_json<JsonValue>("{\"b\": 1, \"a\": 2}").to_json() );
+
+  // 入力にないメンバは初期値のまま
+  auto& rec1 = list[1];
+  EXPECT_EQ( "b", rec1.name );
+  EXPECT_EQ( 2.0, rec1.value );
+  EXPECT_FALSE( rec1.flag );
+  EXPECT_TRUE( rec1.points.empty() );
+  EXPECT_FALSE( rec1.opt.has_value() );
+  EXPECT_TRUE( rec1.extra.is_null() );
+}
+
+TEST(JsonBindTest, write)
+{
+  Record rec;
+  rec.name = "a b";
+  rec.value = 0.5;
+  rec.points = {Point{1, 2}};
+  rec.attr = {{"p", 1}};
+  rec.extra = JsonValue{std::vector<JsonValue>{JsonValue{1}}};
+
+  auto str = to_json(rec);
+  EXPECT_EQ( "{\"name\":\"a b\",\"value\":0.5,\"flag\":false,"
+	     "\"points\":[{\"x\":1,\"y\":2}],\"opt\":null,"
+	     "\"attr\":{\"p\":1},\"extra\":[1]}", str );
+  // 読み戻す．
+  auto rec2 = parse_json<Record>(str);
+  EXPECT_EQ( str, to_json(rec2) );
+  EXPECT_EQ( JsonValue::parse(str), JsonValue::parse(to_json(rec, true)) );
+
+  // JsonReader から配列の要素を順に読み込む．
+  std::istringstream s{"[{\"x\": 1, \"y\": 2}, {\"x\": 3}]"};
+  JsonReader reader{s};
+  EXPECT_EQ( JsonEvent::StartArray, reader.next() );
+  Point p;
+  read_json(reader, p);
+  EXPECT_EQ( 1, p.x );
+  read_json(reader, p);
+  EXPECT_EQ( 3, p.x );
+  EXPECT_EQ( 2, p.y );
+  EXPECT_EQ( JsonEvent::EndArray, reader.next() );
+}
+
+TEST(JsonBindTest, bad)
+{
+  // 型が異なる．
+  EXPECT_THROW( parse_json<Point>("{\"x\": \"1\"}"), std::invalid_argument );
+  EXPECT_THROW( parse_json<Point>("[1, 2]"), std::invalid_argument );
+  EXPECT_THROW( parse_json<std::vector<int>>("[1, 2.5]"),
+		std::invalid_argument );
+  EXPECT_THROW( parse_json<std::string>("null"), std::invalid_argument );
+
+  // 範囲外
+  EXPECT_THROW( parse_json<std::int8_t>("128"), std::invalid_argument );
+  EXPECT_THROW( parse_json<std::uint32_t>("-1"), std::invalid_argument );
+  EXPECT_EQ( 255, parse_json<std::uint8_t>("255") );
+  // 無限大と NaN は書き出せない．
+  EXPECT_THROW( to_json(std::numeric_limits<double>::infinity()),
+		std::invalid_argument );
+  EXPECT_THROW( to_json(std::vector<double>{1.0, std::numeric_limits<double>::quiet_NaN()}),
+		std::invalid_argument );
+
+  // 余分な入力がある．
+  EXPECT_THROW( parse_json<int>("1 2"), std::invalid_argument );
+  EXPECT_THROW( parse_json<int>(""), std::invalid_argument );
+
+  // エラーメッセージは位置情報を含む．
+  try {
+    parse_json<Record>("{\"name\": \"a\",\n \"flag\": 1}");
+    FAIL();
+  }
+  catch ( const std::invalid_argument& err ) {
+    EXPECT_NE( std::string::npos, std::string{err.what()}.find("bool value is expected") );
+    EXPECT_NE( std::string::npos, std::string{err.what()}.find("2") );
+  }
+}
+
+END_NAMESPACE_YM_JSON
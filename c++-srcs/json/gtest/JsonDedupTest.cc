@@ -0,0 +1,75 @@
+
+/// @file JsonDedupTest.cc
+/// @brief JsonDedup のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonDedup.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(JsonDedupTest, simple)
+{
+  JsonDedup dedup;
+
+  auto src1 = JsonValue::parse("{\"a\": [1, 2], \"b\": \"x\", \"c\": [1, 2]}");
+  auto value1 = dedup.add(src1);
+  EXPECT_EQ( src1, value1 );
+  EXPECT_EQ( src1.to_json(), value1.to_json() );
+  // "x", [1, 2], 全体
+  EXPECT_EQ( 3, dedup.node_num() );
+
+  // 同じ内容の値は新しいノードを作らない．
+  auto src2 = JsonValue::parse("{\"a\": [1, 2], \"b\": \"x\", \"c\": [1, 2]}");
+  auto value2 = dedup.add(src2);
+  EXPECT_EQ( value1, value2 );
+  EXPECT_EQ( 3, dedup.node_num() );
+
+  // 一部が異なる値は異なる部分のみ新しいノードを作る．
+  auto src3 = JsonValue::parse("{\"a\": [1, 2], \"b\": \"y\", \"c\": [1, 2]}");
+  auto value3 = dedup.add(src3);
+  EXPECT_EQ( src3, value3 );
+  EXPECT_NE( value1, value3 );
+  EXPECT_EQ( 5, dedup.node_num() );
+
+  // 作られた値を登録しても何も作らない．
+  auto value4 = dedup.add(value3);
+  EXPECT_EQ( value3, value4 );
+  EXPECT_EQ( 5, dedup.node_num() );
+
+  // 0.0 と -0.0 は区別される．
+  auto value5 = dedup.add(JsonValue::parse("[0.0]"));
+  auto value6 = dedup.add(JsonValue::parse("[-0.0]"));
+  EXPECT_EQ( "[0.0]", value5.to_json() );
+  EXPECT_EQ( "[-0.0]", value6.to_json() );
+  EXPECT_EQ( 7, dedup.node_num() );
+}
+
+TEST(JsonDedupTest, read)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+
+  JsonValue value1;
+  JsonValue value2;
+  SizeType n;
+  {
+    JsonDedup dedup;
+    value1 = dedup.add(JsonValue::read(path));
+    n = dedup.node_num();
+    // 遅延モードの値も同じ内容になる．
+    value2 = dedup.add(JsonValue::read(path, true));
+    EXPECT_EQ( n, dedup.node_num() );
+  }
+  // dedup を破棄しても値は残る．
+  auto src = JsonValue::read(path);
+  EXPECT_EQ( src, value1 );
+  EXPECT_EQ( src, value2 );
+  EXPECT_EQ( src.to_json(), value1.to_json() );
+}
+
+END_NAMESPACE_YM
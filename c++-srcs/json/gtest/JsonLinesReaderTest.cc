@@ -0,0 +1,154 @@
+
+/// @file JsonLinesReaderTest.cc
+/// @brief JsonLinesReaderTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonLinesReader.h"
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+// n 行の入力を作る．
+std::string
+make_lines(
+  SizeType n
+)
+{
+  std::string buff;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    buff += "{\"id\": " + std::to_string(i) + ", \"name\": \"n"
+      + std::to_string(i) + "\"}\n";
+  }
+  return buff;
+}
+
+TEST(JsonLinesReaderTest, simple)
+{
+  // 空白のみの行は読み飛ばす．
+  // CR LF の改行と最後の行の改行の省略も受け付ける．
+  std::string buff{"{\"a\": 1}\n  \n[true, null]\r\n\n\"xyz\"\n 2.5"};
+
+  for ( SizeType thread_num: {1, 4} ) {
+    JsonLinesReader reader{buff, thread_num};
+    EXPECT_EQ( thread_num, reader.thread_num() );
+    auto value_list = reader.read_all();
+    ASSERT_EQ( 4, value_list.size() );
+    EXPECT_EQ( 1, value_list[0]["a"].get_int() );
+    EXPECT_TRUE( value_list[1][0].get_bool() );
+    EXPECT_EQ( "xyz", value_list[2].get_string() );
+    EXPECT_EQ( 2.5, value_list[3].get_float() );
+
+    std::vector<SizeType> line_list;
+    reader.read([&](SizeType line, const JsonValue& value) {
+      line_list.push_back(line);
+    });
+    EXPECT_EQ( (std::vector<SizeType>{1, 3, 5, 6}), line_list );
+  }
+
+  JsonLinesReader reader{""};
+  EXPECT_TRUE( reader.read_all().empty() );
+}
+
+TEST(JsonLinesReaderTest, large)
+{
+  // 複数のブロックに分割される大きさ
+  const SizeType n = 100000;
+  auto buff = make_lines(n);
+
+  JsonLinesReader reader{buff, 4};
+  auto value_list = reader.read_all();
+  ASSERT_EQ( n, value_list.size() );
+  for ( SizeType i = 0; i < n; ++ i ) {
+    ASSERT_EQ( i, value_list[i]["id"].get_int() );
+  }
+
+  // 順不同
+  std::mutex mtx;
+  std::vector<bool> mark(n, false);
+  SizeType count = 0;
+  reader.read([&](SizeType line, const JsonValue& value) {
+    std::lock_guard<std::mutex> lock{mtx};
+    auto id = value["id"].get_int();
+    EXPECT_EQ( id + 1, line );
+    mark[id] = true;
+    ++ count;
+  }, false);
+  EXPECT_EQ( n, count );
+  EXPECT_EQ( n, std::count(mark.begin(), mark.end(), true) );
+}
+
+TEST(JsonLinesReaderTest, error)
+{
+  const SizeType n = 100000;
+  auto buff = make_lines(n);
+  // 70000 行目を壊す．
+  auto pos = buff.find("{\"id\": 69999,");
+  buff[pos + 5] = ',';
+
+  for ( SizeType thread_num: {1, 4} ) {
+    for ( bool ordered: {true, false} ) {
+      JsonLinesReader reader{buff, thread_num};
+      std::vector<bool> mark(n, false);
+      std::mutex mtx;
+      std::string msg;
+      try {
+	reader.read([&](SizeType line, const JsonValue& value) {
+	  std::lock_guard<std::mutex> lock{mtx};
+	  mark[value["id"].get_int()] = true;
+	}, ordered);
+      }
+      catch ( std::invalid_argument& err ) {
+	msg = err.what();
+      }
+      EXPECT_EQ( "line 70000, column = 6: ':' is expected", msg );
+      // エラーより前の行はすべて渡されている．
+      EXPECT_EQ( 69999, std::count(mark.begin(), mark.begin() + 69999, true) );
+      EXPECT_FALSE( mark[69999] );
+    }
+  }
+}
+
+TEST(JsonLinesReaderTest, callback_error)
+{
+  const SizeType n = 100000;
+  auto buff = make_lines(n);
+
+  // callback の例外はそのまま送出される．
+  JsonLinesReader reader{buff, 4};
+  SizeType count = 0;
+  EXPECT_THROW( reader.read([&](SizeType line, const JsonValue& value) {
+    if ( line == 50000 ) {
+      throw std::out_of_range{"stop"};
+    }
+    ++ count;
+  }), std::out_of_range );
+  EXPECT_EQ( 49999, count );
+}
+
+TEST(JsonLinesReaderTest, read)
+{
+  std::string filename{"test.jsonl"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+
+  auto reader = JsonLinesReader::open(path);
+  auto value_list = reader.read_all();
+  ASSERT_EQ( 4, value_list.size() );
+  EXPECT_EQ( "beta", value_list[1]["name"].get_string() );
+  EXPECT_EQ( 3, value_list[2].size() );
+  EXPECT_EQ( "gamma", value_list[3].get_string() );
+
+  EXPECT_THROW( JsonLinesReader::open("not_exist.jsonl"), std::invalid_argument );
+
+#ifdef HAS_ZLIB
+  // 圧縮されたファイル
+  auto reader2 = JsonLinesReader::open(path + ".gz");
+  EXPECT_EQ( value_list, reader2.read_all() );
+#endif
+}
+
+END_NAMESPACE_YM_JSON
@@ -18,9 +18,6 @@ TEST(JsonObjTest, string1)
   auto json_obj = new JsonString{value};
 
   EXPECT_TRUE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
   EXPECT_FALSE( json_obj->is_object() );
   EXPECT_FALSE( json_obj->is_array() );
 
@@ -33,73 +30,12 @@ TEST(JsonObjTest, string2)
   auto json_obj = new JsonString{value};
 
   EXPECT_TRUE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
   EXPECT_FALSE( json_obj->is_object() );
   EXPECT_FALSE( json_obj->is_array() );
 
   EXPECT_EQ( value, json_obj->get_string() );
 }
 
-TEST(JsonObjTest, int)
-{
-  int value = 99;
-  auto json_obj = new JsonInt{value};
-
-  EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_TRUE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
-  EXPECT_FALSE( json_obj->is_object() );
-  EXPECT_FALSE( json_obj->is_array() );
-
-  EXPECT_EQ( value, json_obj->get_int() );
-}
-
-TEST(JsonObjTest, float)
-{
-  double value = 1.2345;
-  auto json_obj = new JsonFloat{value};
-
-  EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_TRUE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
-  EXPECT_FALSE( json_obj->is_object() );
-  EXPECT_FALSE( json_obj->is_array() );
-
-  EXPECT_EQ( value, json_obj->get_float() );
-}
-
-TEST(JsonObjTest, bool_true)
-{
-  auto json_obj = new JsonTrue;
-
-  EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_TRUE( json_obj->is_bool() );
-  EXPECT_FALSE( json_obj->is_object() );
-  EXPECT_FALSE( json_obj->is_array() );
-
-  EXPECT_EQ( true, json_obj->get_bool() );
-}
-
-TEST(JsonObjTest, bool_false)
-{
-  auto json_obj = new JsonFalse;
-
-  EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_TRUE( json_obj->is_bool() );
-  EXPECT_FALSE( json_obj->is_object() );
-  EXPECT_FALSE( json_obj->is_array() );
-
-  EXPECT_EQ( false, json_obj->get_bool() );
-}
-
 TEST(JsonObjTest, array1)
 {
   std::string value1 = "xyz";
@@ -115,9 +51,6 @@ TEST(JsonObjTest, array1)
   auto json_obj = new JsonArray{value};
 
   EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
   EXPECT_FALSE( json_obj->is_object() );
   EXPECT_TRUE( json_obj->is_array() );
 
@@ -146,9 +79,6 @@ TEST(JsonObjTest, object1)
   auto json_obj = new JsonDict{value};
 
   EXPECT_FALSE( json_obj->is_string() );
-  EXPECT_FALSE( json_obj->is_int() );
-  EXPECT_FALSE( json_obj->is_float() );
-  EXPECT_FALSE( json_obj->is_bool() );
   EXPECT_TRUE( json_obj->is_object() );
   EXPECT_FALSE( json_obj->is_array() );
 
@@ -161,4 +91,27 @@ TEST(JsonObjTest, object1)
   EXPECT_EQ( json3, json_obj->get_value("key3") );
 }
 
+TEST(JsonObjTest, object_index)
+{
+  // 索引を作る大きさのオブジェクト
+  std::unordered_map<std::string, JsonValue> value;
+  SizeType n = JsonDict::INDEX_THRESHOLD * 4;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    value.emplace("key" + std::to_string(i), JsonValue{static_cast<int>(i)});
+  }
+  JsonDict json_obj{value};
+
+  EXPECT_EQ( n, json_obj.size() );
+  // キーの順に並ぶ．
+  auto key_list = json_obj.key_list();
+  EXPECT_TRUE( std::is_sorted(key_list.begin(), key_list.end()) );
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto key = "key" + std::to_string(i);
+    auto value_p = json_obj.find(key);
+    ASSERT_TRUE( value_p != nullptr );
+    EXPECT_EQ( i, value_p->get_int() );
+  }
+  EXPECT_EQ( nullptr, json_obj.find("abc") );
+}
+
 END_NAMESPACE_YM_JSON
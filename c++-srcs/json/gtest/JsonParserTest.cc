@@ -235,4 +235,150 @@ TEST(JsonParserTest, array_bad2)
   );
 }
 
+TEST(JsonParserTest, table)
+{
+  // 同じキーを同じ順に持つオブジェクトの配列は表形式で読み込まれるが，
+  // 通常の配列と同じように振る舞う．
+  std::string json_str{"["};
+  std::vector<JsonValue> expected_array;
+  const int n = 20;
+  for ( int i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ",";
+    }
+    auto name = "n" + std::to_string(i);
+    // "v" の列は途中から浮動小数点数が混ざる．
+    auto v = i < 10 ? JsonValue{i} : JsonValue{i * 0.5};
+    json_str += "{\"id\":" + std::to_string(i)
+      + ",\"x\":" + std::to_string(i) + ".5"
+      + ",\"name\":\"" + name + "\""
+      + ",\"v\":" + v.to_json()
+      + ",\"sub\":[" + std::to_string(i) + "]}";
+    expected_array.push_back(JsonValue{std::unordered_map<std::string, JsonValue>{
+	  {"id", JsonValue{i}},
+	  {"x", JsonValue{i + 0.5}},
+	  {"name", JsonValue{name}},
+	  {"v", v},
+	  {"sub", JsonValue{std::vector<JsonValue>{JsonValue{i}}}}}});
+  }
+  json_str += "]";
+  auto expected = JsonValue{expected_array};
+
+  auto value = JsonValue::parse(json_str);
+  ASSERT_TRUE( value.is_array() );
+  ASSERT_EQ( n, value.size() );
+  for ( int i = 0; i < n; ++ i ) {
+    auto row = value[i];
+    EXPECT_TRUE( row.is_object() );
+    EXPECT_EQ( 5, row.size() );
+    EXPECT_EQ( i, row["id"].get_int() );
+    EXPECT_EQ( i + 0.5, row["x"].get_float() );
+    EXPECT_EQ( "n" + std::to_string(i), row["name"].get_string() );
+    EXPECT_TRUE( row.has_key("sub") );
+    EXPECT_FALSE( row.has_key("xyz") );
+    EXPECT_THROW( row["xyz"], std::invalid_argument );
+  }
+  EXPECT_EQ( (std::vector<std::string>{"id", "x", "name", "v", "sub"}),
+	     value[0].key_list() );
+  EXPECT_THROW( value[n], std::out_of_range );
+
+  // 出力は入力と同じ順番になる．
+  EXPECT_EQ( json_str, value.to_json() );
+  EXPECT_EQ( expected, value );
+  EXPECT_EQ( value, expected );
+  EXPECT_EQ( expected.hash(), value.hash() );
+  EXPECT_EQ( expected[3], value[3] );
+  EXPECT_EQ( expected[3].hash(), value[3].hash() );
+
+  // 要素と要素の要素をたどる．
+  int i = 0;
+  for ( auto row: value.elements() ) {
+    SizeType count = 0;
+    for ( auto p: row.items() ) {
+      EXPECT_EQ( expected[i][std::string{p.first}], p.second );
+      ++ count;
+    }
+    EXPECT_EQ( 5, count );
+    ++ i;
+  }
+  EXPECT_EQ( n, i );
+
+  // 書き換えは複製に対して行われる．
+  auto value2 = value;
+  auto row = value2[2];
+  row.set("id", JsonValue{100});
+  value2.set(2, row);
+  EXPECT_EQ( 100, value2[2]["id"].get_int() );
+  EXPECT_EQ( 2, value[2]["id"].get_int() );
+  EXPECT_NE( value, value2 );
+
+  // バイナリ形式
+  std::ostringstream obuf;
+  BinEnc enc{obuf};
+  value.dump(enc);
+  std::istringstream ibuf{obuf.str()};
+  BinDec dec{ibuf};
+  EXPECT_EQ( expected, JsonValue::restore(dec) );
+}
+
+TEST(JsonParserTest, table_fallback)
+{
+  // 途中で形の異なる要素が現れた場合はそれまでの要素も含めて
+  // 通常の配列として読み込まれる．
+  std::string head;
+  for ( SizeType i = 0; i < 10; ++ i ) {
+    head += "{\"a\":" + std::to_string(i) + ",\"b\":true},";
+  }
+  for ( auto tail: {"{\"a\":1}",
+		    "{\"a\":1,\"b\":true,\"c\":2}",
+		    "{\"b\":true,\"a\":1}",
+		    "{\"a\":1,\"c\":true}",
+		    "{\"a\":1,\"b\":true,\"a\":3}",
+		    "{}",
+		    "3",
+		    "[{\"a\":1,\"b\":true}]"} ) {
+    std::string json_str = "[" + head + tail + "," + head + "null]";
+    auto value = JsonValue::parse(json_str);
+    ASSERT_EQ( 22, value.size() );
+    EXPECT_EQ( JsonValue::parse(tail), value[10] );
+    EXPECT_EQ( 9, value[9]["a"].get_int() );
+    EXPECT_EQ( 9, value[20]["a"].get_int() );
+    EXPECT_TRUE( value[21].is_null() );
+    auto tail_str = JsonValue::parse(tail).to_json();
+    EXPECT_EQ( "[" + head + tail_str + "," + head + "null]", value.to_json() );
+  }
+
+  // 重複したキーは最初のものが残る．
+  std::string json_str = "[";
+  for ( SizeType i = 0; i < 10; ++ i ) {
+    json_str += "{\"a\":" + std::to_string(i) + ",\"a\":0},";
+  }
+  json_str += "{\"a\":10}]";
+  auto value = JsonValue::parse(json_str);
+  EXPECT_EQ( 1, value[3].size() );
+  EXPECT_EQ( 3, value[3]["a"].get_int() );
+
+  // 行数が少ない場合
+  auto value2 = JsonValue::parse("[{\"a\":1},{\"a\":2}]");
+  EXPECT_EQ( 2, value2[1]["a"].get_int() );
+  EXPECT_EQ( "[{\"a\":1},{\"a\":2}]", value2.to_json() );
+}
+
+TEST(JsonParserTest, table_bad)
+{
+  std::string head;
+  for ( SizeType i = 0; i < 10; ++ i ) {
+    head += "{\"a\":" + std::to_string(i) + ",\"b\":true},";
+  }
+  for ( auto tail: {"{\"a\":1 \"b\":true}]",
+		    "{\"a\" 1,\"b\":true}]",
+		    "{\"a\":1,\"b\":true} {}]",
+		    "{\"a\":1,\"b\":true},]",
+		    "{\"a\":1,",
+		    "{\"a\":1,\"b\":true}"} ) {
+    std::string json_str = "[" + head + tail;
+    EXPECT_THROW( JsonValue::parse(json_str), std::invalid_argument );
+  }
+}
+
 END_NAMESPACE_YM_JSON
@@ -0,0 +1,124 @@
+
+/// @file JsonPointerTest.cc
+/// @brief JsonPointerTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "gtest/gtest.h"
+#include "ym/JsonPointer.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM
+
+// RFC 6901 の例
+static const char* json_str =
+  "{\n"
+  "  \"foo\": [\"bar\", \"baz\"],\n"
+  "  \"\": 0,\n"
+  "  \"a/b\": 1,\n"
+  "  \"c%d\": 2,\n"
+  "  \"e^f\": 3,\n"
+  "  \"g|h\": 4,\n"
+  "  \"i\\\\j\": 5,\n"
+  "  \"k\\\"l\": 6,\n"
+  "  \" \": 7,\n"
+  "  \"m~n\": 8\n"
+  "}";
+
+TEST(JsonPointerTest, compile)
+{
+  JsonPointer ptr{"/cells/17/pins"};
+  EXPECT_EQ( "/cells/17/pins", ptr.str() );
+  ASSERT_EQ( 3, ptr.size() );
+  EXPECT_EQ( "cells", ptr.key(0) );
+  EXPECT_EQ( JsonPointer::NOT_INDEX, ptr.index(0) );
+  EXPECT_EQ( "17", ptr.key(1) );
+  EXPECT_EQ( 17, ptr.index(1) );
+  EXPECT_EQ( "pins", ptr.key(2) );
+
+  JsonPointer ptr2{"/a~1b/~0/01/"};
+  ASSERT_EQ( 4, ptr2.size() );
+  EXPECT_EQ( "a/b", ptr2.key(0) );
+  EXPECT_EQ( "~", ptr2.key(1) );
+  EXPECT_EQ( "01", ptr2.key(2) );
+  EXPECT_EQ( JsonPointer::NOT_INDEX, ptr2.index(2) );
+  EXPECT_EQ( "", ptr2.key(3) );
+
+  EXPECT_EQ( 0, JsonPointer{""}.size() );
+}
+
+TEST(JsonPointerTest, bad)
+{
+  EXPECT_THROW( JsonPointer{"foo"}, std::invalid_argument );
+  EXPECT_THROW( JsonPointer{"/foo~2"}, std::invalid_argument );
+  EXPECT_THROW( JsonPointer{"/foo~"}, std::invalid_argument );
+}
+
+TEST(JsonPointerTest, get)
+{
+  std::vector<std::pair<std::string, std::string>> exp_list{
+    {"", ""},
+    {"/foo", "[\"bar\",\"baz\"]"},
+    {"/foo/0", "\"bar\""},
+    {"/", "0"},
+    {"/a~1b", "1"},
+    {"/c%d", "2"},
+    {"/e^f", "3"},
+    {"/g|h", "4"},
+    {"/i\\j", "5"},
+    {"/k\"l", "6"},
+    {"/ ", "7"},
+    {"/m~0n", "8"}
+  };
+
+  auto value = JsonValue::parse(json_str);
+  for ( bool lazy: {false, true} ) {
+    auto value2 = JsonValue::parse(json_str, lazy);
+    for ( auto& p: exp_list ) {
+      JsonPointer ptr{p.first};
+      auto exp_value = p.second == "" ? value : JsonValue::parse(p.second);
+      EXPECT_EQ( exp_value, ptr.get(value2) ) << p.first;
+      EXPECT_EQ( exp_value, ptr.parse(json_str) ) << p.first;
+    }
+  }
+}
+
+TEST(JsonPointerTest, not_found)
+{
+  auto value = JsonValue::parse(json_str, true);
+  for ( auto path: {"/bar", "/foo/2", "/foo/-", "/foo/01", "/foo/0/x", "/ /x"} ) {
+    JsonPointer ptr{path};
+    EXPECT_TRUE( ptr.get(value).is_null() ) << path;
+    EXPECT_TRUE( ptr.parse(json_str).is_null() ) << path;
+  }
+}
+
+TEST(JsonPointerTest, skip)
+{
+  // 経路上にない値は中身を解釈しない．
+  // 経路の指す値より後ろも読まない．
+  std::string str{"[ { \"x\": [ 1 2 }, \"a\" ], [ \"b\", @ ] ] xyz"};
+
+  JsonPointer ptr{"/1/0"};
+  EXPECT_EQ( "b", ptr.parse(str).get_string() );
+
+  // 経路上のエラーは検出する．
+  JsonPointer ptr2{"/0/x"};
+  EXPECT_THROW( ptr2.parse(str), std::invalid_argument );
+}
+
+TEST(JsonPointerTest, read)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+
+  JsonPointer ptr{"/object_key/sub_key2"};
+  EXPECT_EQ( 1, ptr.read(path).get_int() );
+  JsonPointer ptr2{"/array_key"};
+  EXPECT_EQ( JsonValue::read(path)["array_key"], ptr2.read(path) );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,117 @@
+
+/// @file JsonPushParserTest.cc
+/// @brief JsonPushParser のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonPushParser.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+TEST(JsonPushParserTest, simple)
+{
+  std::string buff{
+    "{\"a\": [1, \"]}\\\"\"], // c ]\n \"b\": 'x}'}\n"
+    "  [true, null]\r\n"
+    "# comment\n"
+    "\"xyz\" 2.5 /* c */ -3\n"
+    "{}"
+  };
+  auto expected = std::vector<JsonValue>{
+    JsonValue::parse("{\"a\": [1, \"]}\\\"\"], \"b\": \"x}\"}"),
+    JsonValue::parse("[true, null]"),
+    JsonValue{"xyz"},
+    JsonValue{2.5},
+    JsonValue{-3},
+    JsonValue::parse("{}")
+  };
+  auto expected_line = std::vector<SizeType>{1, 3, 5, 5, 5, 6};
+
+  // 全ての分割位置で同じ結果になることを確かめる．
+  for ( SizeType chunk: {1, 2, 3, 5, 7, 100} ) {
+    std::vector<JsonValue> value_list;
+    std::vector<SizeType> line_list;
+    JsonPushParser parser{[&](SizeType line, const JsonValue& value) {
+      line_list.push_back(line);
+      value_list.push_back(value);
+    }};
+    for ( SizeType pos = 0; pos < buff.size(); pos += chunk ) {
+      auto n = std::min(chunk, buff.size() - pos);
+      parser.feed(buff.data() + pos, n);
+    }
+    // 最後の "{}" は閉じているので finish() の前に読み込まれる．
+    EXPECT_EQ( expected.size(), value_list.size() );
+    parser.finish();
+    EXPECT_EQ( expected, value_list );
+    EXPECT_EQ( expected_line, line_list );
+    EXPECT_EQ( 0, parser.buffered_size() );
+  }
+}
+
+TEST(JsonPushParserTest, incremental)
+{
+  std::vector<JsonValue> value_list;
+  JsonPushParser parser{[&](SizeType, const JsonValue& value) {
+    value_list.push_back(value);
+  }};
+
+  parser.feed("{\"id\": 1, \"v\": [1,");
+  EXPECT_TRUE( value_list.empty() );
+  parser.feed(" 2]}\n{\"id\": 2");
+  ASSERT_EQ( 1, value_list.size() );
+  EXPECT_EQ( 1, value_list[0]["id"].get_int() );
+  // 読み終わった部分はバッファから取り除かれる．
+  EXPECT_EQ( std::string{"{\"id\": 2"}.size(), parser.buffered_size() );
+
+  // 数値は区切りが来るまで完結しない．
+  parser.feed("}\n12");
+  EXPECT_EQ( 2, value_list.size() );
+  parser.feed("3");
+  EXPECT_EQ( 2, value_list.size() );
+  parser.finish();
+  ASSERT_EQ( 3, value_list.size() );
+  EXPECT_EQ( 123, value_list[2].get_int() );
+
+  // finish() の後は初期状態から読み込む．
+  parser.feed("[4]");
+  EXPECT_EQ( 4, value_list.size() );
+}
+
+TEST(JsonPushParserTest, error)
+{
+  std::vector<JsonValue> value_list;
+  JsonPushParser parser{[&](SizeType, const JsonValue& value) {
+    value_list.push_back(value);
+  }};
+
+  // エラーの位置は入力全体でのものとなる．
+  parser.feed("[1]\n");
+  try {
+    parser.feed("{\"a\": 1,\n \"b\" 2}\n[");
+    FAIL();
+  }
+  catch ( const std::invalid_argument& err ) {
+    EXPECT_NE( std::string::npos, std::string{err.what()}.find("3") );
+  }
+  // エラーとなった値を読み捨てて次の値から再開する．
+  parser.feed("2]");
+  ASSERT_EQ( 2, value_list.size() );
+  EXPECT_EQ( 2, value_list[1][0].get_int() );
+
+  // 完結していない値
+  parser.feed("{\"a\": [");
+  EXPECT_THROW( parser.finish(), std::invalid_argument );
+  parser.finish();
+  EXPECT_EQ( 0, parser.buffered_size() );
+
+  // 値の先頭になり得ない文字
+  EXPECT_THROW( parser.feed("] "), std::invalid_argument );
+  EXPECT_THROW( parser.feed("1, "), std::invalid_argument );
+  EXPECT_EQ( 3, value_list.size() );
+}
+
+END_NAMESPACE_YM_JSON
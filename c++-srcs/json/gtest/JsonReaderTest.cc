@@ -0,0 +1,145 @@
+
+/// @file JsonReaderTest.cc
+/// @brief JsonReaderTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonReader.h"
+#include "ym/JsonHandler.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+TEST(JsonReaderTest, events)
+{
+  std::string json_str{"{\"a\": [1, 2.5, true, null], \"b\": {}, \"c\": \"xyz\"}"};
+  JsonReader reader{json_str};
+
+  EXPECT_EQ( JsonEvent::StartObject, reader.next() );
+  EXPECT_EQ( 1, reader.depth() );
+  EXPECT_EQ( JsonEvent::Key, reader.next() );
+  EXPECT_EQ( "a", reader.key() );
+  EXPECT_EQ( JsonEvent::StartArray, reader.next() );
+  EXPECT_EQ( 2, reader.depth() );
+  EXPECT_EQ( JsonEvent::Int, reader.next() );
+  EXPECT_EQ( 1, reader.int_value() );
+  EXPECT_EQ( JsonEvent::Float, reader.next() );
+  EXPECT_EQ( 2.5, reader.float_value() );
+  EXPECT_EQ( JsonEvent::Bool, reader.next() );
+  EXPECT_TRUE( reader.bool_value() );
+  EXPECT_EQ( JsonEvent::Null, reader.next() );
+  EXPECT_EQ( JsonEvent::EndArray, reader.next() );
+  EXPECT_EQ( JsonEvent::Key, reader.next() );
+  EXPECT_EQ( "b", reader.key() );
+  EXPECT_EQ( JsonEvent::StartObject, reader.next() );
+  EXPECT_EQ( JsonEvent::EndObject, reader.next() );
+  EXPECT_EQ( JsonEvent::Key, reader.next() );
+  EXPECT_EQ( "c", reader.key() );
+  EXPECT_EQ( JsonEvent::String, reader.next() );
+  EXPECT_EQ( "xyz", reader.string_value() );
+  EXPECT_EQ( JsonEvent::EndObject, reader.next() );
+  EXPECT_EQ( 0, reader.depth() );
+  EXPECT_EQ( JsonEvent::End, reader.next() );
+  EXPECT_EQ( JsonEvent::End, reader.next() );
+}
+
+TEST(JsonReaderTest, skip)
+{
+  std::string json_str{"[{\"a\": [1, [2, {}]], \"b\": 3}, 4]"};
+  std::istringstream s{json_str};
+  JsonReader reader{s};
+
+  EXPECT_EQ( JsonEvent::StartArray, reader.next() );
+  EXPECT_EQ( JsonEvent::StartObject, reader.next() );
+  reader.skip();
+  EXPECT_EQ( 1, reader.depth() );
+  EXPECT_EQ( JsonEvent::Int, reader.next() );
+  EXPECT_EQ( 4, reader.int_value() );
+  EXPECT_EQ( JsonEvent::EndArray, reader.next() );
+  EXPECT_EQ( JsonEvent::End, reader.next() );
+}
+
+// イベントから JSON 文字列を再構成するハンドラ
+class EchoHandler :
+  public JsonHandler
+{
+public:
+
+  void on_start_object() override { sep(); mStr += '{'; mFirst = true; }
+  void on_end_object() override { mStr += '}'; mFirst = false; }
+  void on_start_array() override { sep(); mStr += '['; mFirst = true; }
+  void on_end_array() override { mStr += ']'; mFirst = false; }
+  void on_key(std::string_view key) override
+  {
+    sep();
+    mStr += '"';
+    mStr += key;
+    mStr += "\":";
+    mFirst = true;
+  }
+  void on_null() override { sep(); mStr += "null"; }
+  void on_bool(bool value) override { sep(); mStr += value ? "true" : "false"; }
+  void on_int(std::int64_t value) override { sep(); mStr += std::to_string(value); }
+  void on_float(double value) override { sep(); mStr += JsonValue{value}.to_json(); }
+  void on_string(std::string_view value) override
+  {
+    sep();
+    mStr += '"';
+    mStr += value;
+    mStr += '"';
+  }
+
+  void sep() { if ( !mFirst ) { mStr += ','; } mFirst = false; }
+
+  std::string mStr;
+  bool mFirst{true};
+};
+
+TEST(JsonReaderTest, parse)
+{
+  std::string json_str{"{\"a\": [1, 2.5, true, null], \"b\": {}, \"c\": \"xyz\"}"};
+  JsonReader reader{json_str};
+  EchoHandler handler;
+  reader.parse(handler);
+  EXPECT_EQ( JsonValue::parse(json_str).to_json(), handler.mStr );
+}
+
+TEST(JsonReaderTest, error_loc)
+{
+  // JsonValue::parse() と同じメッセージになる．
+  std::vector<std::string> src_list{
+    "{\n  \"key1\": 1,\n  \"key2\" 2\n}",
+    "[1, 2 3]",
+    "{\"a\": 1 \"b\"}",
+    "{1: 2}",
+    "[1, }",
+    "[",
+    "1 2",
+  };
+  for ( auto& src: src_list ) {
+    std::string msg1;
+    try {
+      JsonValue::parse(src);
+    }
+    catch ( std::invalid_argument& err ) {
+      msg1 = err.what();
+    }
+    std::string msg2;
+    try {
+      JsonReader reader{src};
+      JsonHandler handler;
+      reader.parse(handler);
+    }
+    catch ( std::invalid_argument& err ) {
+      msg2 = err.what();
+    }
+    EXPECT_FALSE( msg1.empty() );
+    EXPECT_EQ( msg1, msg2 );
+  }
+}
+
+END_NAMESPACE_YM_JSON
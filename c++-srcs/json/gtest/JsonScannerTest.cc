@@ -8,6 +8,7 @@
 
 #include "gtest/gtest.h"
 #include "JsonScanner.h"
+#include <cmath>
 
 
 BEGIN_NAMESPACE_YM_JSON
@@ -182,6 +183,26 @@ TEST(JsonScannerTest, Int4)
   EXPECT_EQ( -123, scanner.cur_int() );
 }
 
+TEST(JsonScannerTest, Int5)
+{
+  std::istringstream s{"9223372036854775807 -9223372036854775808 9223372036854775808"};
+
+  JsonScanner scanner{s};
+
+  auto tk = scanner.read_token();
+  EXPECT_EQ( JsonToken::Int, tk );
+  EXPECT_EQ( INT64_MAX, scanner.cur_int() );
+
+  tk = scanner.read_token();
+  EXPECT_EQ( JsonToken::Int, tk );
+  EXPECT_EQ( INT64_MIN, scanner.cur_int() );
+
+  // 64ビット整数に収まらない整数は浮動小数点数になる．
+  tk = scanner.read_token();
+  EXPECT_EQ( JsonToken::Float, tk );
+  EXPECT_EQ( 9223372036854775808.0, scanner.cur_float() );
+}
+
 TEST(JsonScannerTest, Float1)
 {
   std::istringstream s{"0."};
@@ -242,6 +263,63 @@ TEST(JsonScannerTest, Float5)
   EXPECT_EQ( 1.0e9, scanner.cur_float() );
 }
 
+TEST(JsonScannerTest, Float6)
+{
+  std::istringstream s{"1e400 -1e400 1e-400"};
+
+  JsonScanner scanner{s};
+
+  // 範囲外の値は strtod() と同じになる．
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( HUGE_VAL, scanner.cur_float() );
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( -HUGE_VAL, scanner.cur_float() );
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( 0.0, scanner.cur_float() );
+}
+
+TEST(JsonScannerTest, number_buffer)
+{
+  // 入力バッファから直接読む場合も結果は同じになる．
+  std::string buff{"[0, -12, 3.5e-2, 7E+1, 0.,\n.5, 1e, 01, 1.5.2, 2e3e4, -9]"};
+
+  std::istringstream s{buff};
+  JsonScanner scanner1{s};
+  JsonScanner scanner2{buff};
+  for ( ; ; ) {
+    auto tk = scanner1.read_token();
+    ASSERT_EQ( tk, scanner2.read_token() );
+    EXPECT_EQ( scanner1.cur_string(), scanner2.cur_string() );
+    EXPECT_EQ( scanner1.cur_loc().start_column(),
+	       scanner2.cur_loc().start_column() );
+    EXPECT_EQ( scanner1.cur_loc().end_column(),
+	       scanner2.cur_loc().end_column() );
+    if ( tk == JsonToken::Int ) {
+      EXPECT_EQ( scanner1.cur_int(), scanner2.cur_int() );
+    }
+    if ( tk == JsonToken::Float ) {
+      EXPECT_EQ( scanner1.cur_float(), scanner2.cur_float() );
+    }
+    if ( tk == JsonToken::End ) {
+      break;
+    }
+  }
+
+  JsonScanner scanner3{buff};
+  EXPECT_EQ( JsonToken::LBK, scanner3.read_token() );
+  EXPECT_EQ( JsonToken::Int, scanner3.read_token() );
+  EXPECT_EQ( JsonToken::Comma, scanner3.read_token() );
+  EXPECT_EQ( JsonToken::Int, scanner3.read_token() );
+  EXPECT_EQ( -12, scanner3.cur_int() );
+  EXPECT_EQ( "-12", scanner3.cur_string() );
+  EXPECT_EQ( JsonToken::Comma, scanner3.read_token() );
+  EXPECT_EQ( JsonToken::Float, scanner3.read_token() );
+  EXPECT_EQ( 3.5e-2, scanner3.cur_float() );
+  EXPECT_EQ( 1, scanner3.cur_loc().start_line() );
+  EXPECT_EQ( 10, scanner3.cur_loc().start_column() );
+  EXPECT_EQ( 15, scanner3.cur_loc().end_column() );
+}
+
 TEST(JsonScannerTest, True_bad1)
 {
   std::istringstream s{"tue"};
@@ -500,4 +578,191 @@ TEST(JsonScannerTest, ustring)
   EXPECT_EQ( "あ", scanner.cur_string() );
 }
 
+TEST(JsonScannerTest, utf8)
+{
+  std::string buff{"[\"設計データ\", '名前\\u3042', \"\\ud83d\\ude00x\","
+		   " \"\\u00e9\\u0041\"]"};
+
+  std::istringstream s{buff};
+  JsonScanner scanner1{s};
+  JsonScanner scanner2{buff};
+  for ( auto scanner: {&scanner1, &scanner2} ) {
+    EXPECT_EQ( JsonToken::LBK, scanner->read_token() );
+    EXPECT_EQ( JsonToken::String, scanner->read_token() );
+    EXPECT_EQ( "設計データ", scanner->cur_string() );
+    EXPECT_EQ( JsonToken::Comma, scanner->read_token() );
+    // 単一引用符の文字列でも \u を使える．
+    EXPECT_EQ( JsonToken::String, scanner->read_token() );
+    EXPECT_EQ( "名前あ", scanner->cur_string() );
+    EXPECT_EQ( JsonToken::Comma, scanner->read_token() );
+    // サロゲートペア
+    EXPECT_EQ( JsonToken::String, scanner->read_token() );
+    EXPECT_EQ( "\U0001F600x", scanner->cur_string() );
+    EXPECT_EQ( JsonToken::Comma, scanner->read_token() );
+    EXPECT_EQ( JsonToken::String, scanner->read_token() );
+    EXPECT_EQ( "\u00e9A", scanner->cur_string() );
+    EXPECT_EQ( JsonToken::RBK, scanner->read_token() );
+    EXPECT_EQ( JsonToken::End, scanner->read_token() );
+  }
+}
+
+TEST(JsonScannerTest, utf8_chunk_boundary)
+{
+  // ストリームの読み込み単位の境界に UTF-8 の文字がまたがるようにする．
+  std::string str(64 * 1024 - 2, 'x');
+  str += "あいう";
+  auto buff = "\"" + str + "\"";
+
+  std::istringstream s{buff};
+  JsonScanner scanner{s};
+  EXPECT_EQ( JsonToken::String, scanner.read_token() );
+  EXPECT_EQ( str, scanner.cur_string() );
+  EXPECT_EQ( JsonToken::End, scanner.read_token() );
+}
+
+TEST(JsonScannerTest, utf8_bad)
+{
+  for ( std::string bad: {"\"\xe3\x81\"",         // 継続バイトが足りない
+			  "\"\xc0\xaf\"",         // 冗長な符号化
+			  "\"\xed\xa0\x80\"",     // サロゲート
+			  "\"\xff\"",
+			  "\"\\ud83d\"",          // 下位サロゲートがない
+			  "\"\\ud83dx\"",
+			  "\"\\ud83d\\u0041\"",
+			  "\"\\ude00\"",          // 上位サロゲートがない
+			  "\"\\u12g4\""} ) {
+    std::istringstream s{bad};
+    JsonScanner scanner1{s};
+    EXPECT_THROW( scanner1.read_token(), std::invalid_argument ) << bad;
+    JsonScanner scanner2{bad};
+    EXPECT_THROW( scanner2.read_token(), std::invalid_argument ) << bad;
+  }
+}
+
+
+TEST(JsonScannerTest, buffer)
+{
+  std::string buff{"{ \"key\" : [ 123, -4.5e1, true ] }"};
+
+  JsonScanner scanner{buff};
+
+  EXPECT_EQ( JsonToken::LCB, scanner.read_token() );
+  EXPECT_EQ( JsonToken::String, scanner.read_token() );
+  EXPECT_EQ( "key", scanner.cur_string() );
+  EXPECT_EQ( JsonToken::Colon, scanner.read_token() );
+  EXPECT_EQ( JsonToken::LBK, scanner.read_token() );
+  EXPECT_EQ( JsonToken::Int, scanner.read_token() );
+  EXPECT_EQ( 123, scanner.cur_int() );
+  EXPECT_EQ( JsonToken::Comma, scanner.read_token() );
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( -45.0, scanner.cur_float() );
+  EXPECT_EQ( JsonToken::Comma, scanner.read_token() );
+  EXPECT_EQ( JsonToken::True, scanner.read_token() );
+  EXPECT_EQ( JsonToken::RBK, scanner.read_token() );
+  EXPECT_EQ( JsonToken::RCB, scanner.read_token() );
+  EXPECT_EQ( JsonToken::End, scanner.read_token() );
+}
+
+TEST(JsonScannerTest, loc)
+{
+  std::string buff{"{\r\n  \"abc\" :\r  12,\n\t'xy'}"};
+
+  std::istringstream s{buff};
+  JsonScanner scanner1{s};
+  JsonScanner scanner2{buff};
+
+  std::vector<std::pair<int, int>> exp_list{
+    {1, 1}, {2, 3}, {2, 9}, {3, 3}, {3, 5}, {4, 2}, {4, 6}
+  };
+  for ( auto& p: exp_list ) {
+    auto tk1 = scanner1.read_token();
+    auto tk2 = scanner2.read_token();
+    EXPECT_EQ( tk1, tk2 );
+    auto loc1 = scanner1.cur_loc();
+    auto loc2 = scanner2.cur_loc();
+    EXPECT_EQ( p.first, loc1.start_line() );
+    EXPECT_EQ( p.second, loc1.start_column() );
+    EXPECT_EQ( loc1.start_line(), loc2.start_line() );
+    EXPECT_EQ( loc1.start_column(), loc2.start_column() );
+    EXPECT_EQ( loc1.end_line(), loc2.end_line() );
+    EXPECT_EQ( loc1.end_column(), loc2.end_column() );
+  }
+  auto loc = scanner2.cur_loc();
+  EXPECT_EQ( 4, loc.end_line() );
+  EXPECT_EQ( 6, loc.end_column() );
+}
+
+TEST(JsonScannerTest, chunk_boundary)
+{
+  // ストリームの読み込み単位の境界に "\r\n" がまたがるようにする．
+  std::string buff(64 * 1024 - 1, ' ');
+  buff += "\r\n\"x\"";
+
+  std::istringstream s{buff};
+  JsonScanner scanner1{s};
+  JsonScanner scanner2{buff};
+
+  EXPECT_EQ( JsonToken::String, scanner1.read_token() );
+  EXPECT_EQ( "x", scanner1.cur_string() );
+  EXPECT_EQ( 2, scanner1.cur_loc().start_line() );
+  EXPECT_EQ( 1, scanner1.cur_loc().start_column() );
+  EXPECT_EQ( JsonToken::End, scanner1.read_token() );
+
+  EXPECT_EQ( JsonToken::String, scanner2.read_token() );
+  EXPECT_EQ( 2, scanner2.cur_loc().start_line() );
+  EXPECT_EQ( 1, scanner2.cur_loc().start_column() );
+  EXPECT_EQ( JsonToken::End, scanner2.read_token() );
+}
+
+TEST(JsonScannerTest, long_line)
+{
+  std::string buff(10000, ' ');
+  buff += "\"long\"";
+
+  JsonScanner scanner{buff};
+
+  EXPECT_EQ( JsonToken::String, scanner.read_token() );
+  EXPECT_EQ( 10001, scanner.cur_loc().start_column() );
+  EXPECT_EQ( 10006, scanner.cur_loc().end_column() );
+}
+
+TEST(JsonScannerTest, skip_container)
+{
+  // 文字列中の括弧とコメント中の括弧は数えない．
+  std::string buff{"{ \"a]\" : [ '}', \"\\\"[\" ],\r\n"
+		   "  # ]\n"
+		   "  /* } */ \"b\" : { // {\n"
+		   "  } } 123"};
+
+  JsonScanner scanner{buff};
+
+  EXPECT_EQ( JsonToken::LCB, scanner.read_token() );
+  auto pos = scanner.cur_pos();
+  EXPECT_TRUE( scanner.skip_container() );
+  EXPECT_EQ( JsonToken::Int, scanner.read_token() );
+  EXPECT_EQ( 4, scanner.cur_loc().start_line() );
+  EXPECT_EQ( 7, scanner.cur_loc().start_column() );
+
+  // 途中から読み直す．
+  JsonScanner scanner2{buff, pos};
+  EXPECT_EQ( JsonToken::String, scanner2.read_token() );
+  EXPECT_EQ( "a]", scanner2.cur_string() );
+  EXPECT_EQ( 1, scanner2.cur_loc().start_line() );
+  EXPECT_EQ( 3, scanner2.cur_loc().start_column() );
+  EXPECT_EQ( JsonToken::Colon, scanner2.read_token() );
+  EXPECT_EQ( JsonToken::LBK, scanner2.read_token() );
+  EXPECT_TRUE( scanner2.skip_container() );
+  EXPECT_EQ( JsonToken::Comma, scanner2.read_token() );
+  EXPECT_EQ( JsonToken::String, scanner2.read_token() );
+  EXPECT_EQ( "b", scanner2.cur_string() );
+  EXPECT_EQ( 3, scanner2.cur_loc().start_line() );
+  EXPECT_EQ( 11, scanner2.cur_loc().start_column() );
+
+  // 閉じ括弧が足りない．
+  JsonScanner scanner3{std::string_view{"[ [ 1, 2 ]"}};
+  EXPECT_EQ( JsonToken::LBK, scanner3.read_token() );
+  EXPECT_FALSE( scanner3.skip_container() );
+  EXPECT_EQ( JsonToken::End, scanner3.read_token() );
+}
+
 END_NAMESPACE_YM_JSON
@@ -0,0 +1,205 @@
+
+/// @file JsonSimdTest.cc
+/// @brief JsonSimdTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "JsonSimd.h"
+#include "JsonScanner.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+class JsonSimdTest :
+  public ::testing::TestWithParam<JsonSimd::Mode>
+{
+public:
+
+  void
+  SetUp() override
+  {
+    mOldMode = JsonSimd::mode();
+    if ( !JsonSimd::set_mode(GetParam()) ) {
+      GTEST_SKIP() << "not supported on this CPU";
+    }
+  }
+
+  void
+  TearDown() override
+  {
+    JsonSimd::set_mode(mOldMode);
+  }
+
+  // str 中の pos の位置に c を置いた文字列を作る．
+  static
+  std::string
+  make_str(
+    SizeType n,
+    char fill,
+    SizeType pos,
+    char c
+  )
+  {
+    std::string str(n, fill);
+    if ( pos < n ) {
+      str[pos] = c;
+    }
+    return str;
+  }
+
+
+private:
+
+  JsonSimd::Mode mOldMode;
+
+};
+
+TEST_P(JsonSimdTest, skip_blank)
+{
+  for ( SizeType n: {0, 1, 15, 16, 17, 31, 32, 33, 100} ) {
+    for ( SizeType pos = 0; pos <= n; ++ pos ) {
+      auto str = make_str(n, ' ', pos, 'x');
+      if ( pos > 0 ) {
+	str[0] = '\t';
+      }
+      auto p = JsonSimd::skip_blank(str.data(), str.data() + n);
+      EXPECT_EQ( pos, p - str.data() );
+    }
+  }
+}
+
+TEST_P(JsonSimdTest, skip_digits)
+{
+  for ( SizeType n: {0, 1, 15, 16, 17, 31, 32, 33, 100} ) {
+    for ( SizeType pos = 0; pos <= n; ++ pos ) {
+      for ( char c: {'/', ':', 'e', '.', '\x80', '\xff'} ) {
+	auto str = make_str(n, '7', pos, c);
+	auto p = JsonSimd::skip_digits(str.data(), str.data() + n);
+	EXPECT_EQ( pos, p - str.data() );
+      }
+    }
+  }
+}
+
+TEST_P(JsonSimdTest, find_string_special)
+{
+  for ( SizeType n: {0, 1, 15, 16, 17, 31, 32, 33, 100} ) {
+    for ( SizeType pos = 0; pos <= n; ++ pos ) {
+      for ( char c: {'"', '\\', '\n', '\x1f', '\x7f'} ) {
+	auto str = make_str(n, 'a', pos, c);
+	auto p = JsonSimd::find_string_special(str.data(), str.data() + n, '"');
+	EXPECT_EQ( pos, p - str.data() );
+      }
+      // 終端文字でない方の引用符と 0x80 以上の文字は対象外
+      for ( char c: {'\'', '\x80', '\xe3', '\xff'} ) {
+	auto str = make_str(n, 'a', pos, c);
+	auto p = JsonSimd::find_string_special(str.data(), str.data() + n, '"');
+	EXPECT_EQ( n, p - str.data() );
+      }
+    }
+  }
+}
+
+TEST_P(JsonSimdTest, find_structural)
+{
+  for ( SizeType n: {0, 1, 15, 16, 17, 31, 32, 33, 100} ) {
+    for ( SizeType pos = 0; pos <= n; ++ pos ) {
+      for ( char c: {'{', '}', '[', ']', '"', '\'', '\n', '\r', '#', '/'} ) {
+	auto str = make_str(n, 'a', pos, c);
+	auto p = JsonSimd::find_structural(str.data(), str.data() + n);
+	EXPECT_EQ( pos, p - str.data() );
+      }
+      // 括弧と 0x20 や 0x80 のビットだけ異なる文字は対象外
+      for ( char c: {';', '=', ',', ':', '\xfb', '\xdd'} ) {
+	auto str = make_str(n, 'a', pos, c);
+	auto p = JsonSimd::find_structural(str.data(), str.data() + n);
+	EXPECT_EQ( n, p - str.data() );
+      }
+    }
+  }
+}
+
+TEST_P(JsonSimdTest, validate_utf8)
+{
+  // 正しい文字の並び
+  // 1〜4バイトの文字がブロックの境界をまたぐように並べる．
+  std::string good;
+  for ( SizeType i = 0; i < 20; ++ i ) {
+    good += "a\u00e9\u3042\U0001F600\u07ff\uffff\U0010FFFF";
+  }
+  for ( SizeType n = 0; n <= good.size(); ++ n ) {
+    auto p = JsonSimd::validate_utf8(good.data(), good.data() + n);
+    // 末尾で切れた文字はその先頭の位置となる．
+    auto exp = n;
+    while ( exp > 0 && (good[exp] & 0xC0) == 0x80 ) {
+      -- exp;
+    }
+    EXPECT_EQ( exp, p - good.data() );
+  }
+
+  // 正しくない並び
+  for ( std::string bad: {"\x80",             // 先頭の継続バイト
+			  "\xc3",             // 継続バイトがない
+			  "\xc3(",
+			  "\xe3\x81",          // 継続バイトが足りない
+			  "\xc0\xaf",          // 冗長な符号化
+			  "\xe0\x80\xaf",
+			  "\xf0\x80\x80\xaf",
+			  "\xed\xa0\x80",      // サロゲート
+			  "\xf4\x90\x80\x80",  // 0x10FFFF を超える
+			  "\xf8\x88\x80\x80\x80",
+			  "\xff"} ) {
+    for ( SizeType pos: {0, 1, 15, 16, 30, 31, 32, 33, 62, 63, 64, 100} ) {
+      // 文字の区切りに挿入する．
+      while ( (good[pos] & 0xC0) == 0x80 ) {
+	++ pos;
+      }
+      auto str = good;
+      str.insert(pos, bad);
+      auto p = JsonSimd::validate_utf8(str.data(), str.data() + str.size());
+      EXPECT_EQ( pos, p - str.data() );
+    }
+  }
+}
+
+TEST_P(JsonSimdTest, scanner)
+{
+  std::string buff{"{\n    \"key_with_a_long_name_0123456789\" :"
+		   "                                    "
+		   "[ 12345678901234567890123456789012345, 1.25, 'abc\\n' ]\n}"};
+
+  JsonScanner scanner{buff};
+
+  EXPECT_EQ( JsonToken::LCB, scanner.read_token() );
+  EXPECT_EQ( JsonToken::String, scanner.read_token() );
+  EXPECT_EQ( "key_with_a_long_name_0123456789", scanner.cur_string() );
+  EXPECT_EQ( 2, scanner.cur_loc().start_line() );
+  EXPECT_EQ( 5, scanner.cur_loc().start_column() );
+  EXPECT_EQ( 37, scanner.cur_loc().end_column() );
+  EXPECT_EQ( JsonToken::Colon, scanner.read_token() );
+  EXPECT_EQ( JsonToken::LBK, scanner.read_token() );
+  EXPECT_EQ( 76, scanner.cur_loc().start_column() );
+  // 64ビット整数に収まらない整数は浮動小数点数になる．
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( "12345678901234567890123456789012345", scanner.cur_string() );
+  EXPECT_EQ( JsonToken::Comma, scanner.read_token() );
+  EXPECT_EQ( JsonToken::Float, scanner.read_token() );
+  EXPECT_EQ( 1.25, scanner.cur_float() );
+  EXPECT_EQ( JsonToken::Comma, scanner.read_token() );
+  EXPECT_EQ( JsonToken::String, scanner.read_token() );
+  EXPECT_EQ( "abc\n", scanner.cur_string() );
+  EXPECT_EQ( JsonToken::RBK, scanner.read_token() );
+  EXPECT_EQ( JsonToken::RCB, scanner.read_token() );
+  EXPECT_EQ( 3, scanner.cur_loc().start_line() );
+  EXPECT_EQ( JsonToken::End, scanner.read_token() );
+}
+
+INSTANTIATE_TEST_SUITE_P(JsonSimdTest, JsonSimdTest,
+			 ::testing::Values(JsonSimd::Scalar,
+					   JsonSimd::Sse2,
+					   JsonSimd::Avx2));
+
+END_NAMESPACE_YM_JSON
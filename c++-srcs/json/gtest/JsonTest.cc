@@ -8,6 +8,7 @@
 
 #include "gtest/gtest.h"
 #include "ym/JsonValue.h"
+#include "ym/JsonPointer.h"
 
 
 BEGIN_NAMESPACE_YM
@@ -158,22 +159,23 @@ TEST(JsonTest, parse)
   auto value6 = value["array_key"];
   EXPECT_TRUE( value6.is_array() );
 
+  // キーは入力の順に出力される．
   std::string exp_str;
   exp_str += "{\n";
-  exp_str += "    \"array_key\":[\n";
-  exp_str += "        0,\n";
-  exp_str += "        1,\n";
-  exp_str += "        2,\n";
-  exp_str += "        3\n";
-  exp_str += "    ],\n";
-  exp_str += "    \"bool_key\":true,\n";
-  exp_str += "    \"float_key\":0.15,\n";
+  exp_str += "    \"str_key\":\"abcd\",\n";
   exp_str += "    \"int_key\":4,\n";
+  exp_str += "    \"float_key\":0.15,\n";
+  exp_str += "    \"bool_key\":true,\n";
   exp_str += "    \"object_key\":{\n";
   exp_str += "        \"sub_key1\":0,\n";
   exp_str += "        \"sub_key2\":1\n";
   exp_str += "    },\n";
-  exp_str += "    \"str_key\":\"abcd\"\n";
+  exp_str += "    \"array_key\":[\n";
+  exp_str += "        0,\n";
+  exp_str += "        1,\n";
+  exp_str += "        2,\n";
+  exp_str += "        3\n";
+  exp_str += "    ]\n";
   exp_str += "}\n";
 
   std::ostringstream os;
@@ -186,4 +188,456 @@ TEST(JsonTest, parse)
   EXPECT_EQ( parsed_value, value );
 }
 
+
+TEST(JsonTest, read_parse)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+
+  auto value1 = JsonValue::read(path);
+
+  std::ifstream s{path};
+  ASSERT_TRUE( s );
+  auto value2 = JsonValue{};
+  s >> value2;
+  EXPECT_EQ( value1, value2 );
+
+  std::ostringstream buf;
+  buf << std::ifstream{path}.rdbuf();
+  auto value3 = JsonValue::parse(buf.str());
+  EXPECT_EQ( value1, value3 );
+}
+
+TEST(JsonTest, read_bad)
+{
+  EXPECT_THROW(
+    JsonValue::read("/no/such/file.json"),
+    std::invalid_argument
+  );
+}
+
+TEST(JsonTest, error_loc)
+{
+  std::string json_str{"{\n  \"key1\": 1,\n  \"key2\" 2\n}"};
+
+  std::string msg1;
+  try {
+    JsonValue::parse(json_str);
+  }
+  catch ( std::invalid_argument& err ) {
+    msg1 = err.what();
+  }
+  std::string msg2;
+  try {
+    std::istringstream s{json_str};
+    JsonValue value;
+    s >> value;
+  }
+  catch ( std::invalid_argument& err ) {
+    msg2 = err.what();
+  }
+  EXPECT_EQ( "line 3, column = 10: ':' is expected", msg1 );
+  EXPECT_EQ( msg1, msg2 );
+}
+
+TEST(JsonTest, element_lifetime)
+{
+  std::string json_str{"{ \"key\" : [ \"abc\", { \"x\" : 1 } ] }"};
+
+  JsonValue array;
+  JsonValue dict;
+  {
+    auto value = JsonValue::parse(json_str);
+    array = value["key"];
+    for ( auto& p: value.item_list() ) {
+      dict = p.second[1];
+    }
+  }
+  // 親が破棄されても要素は有効
+  ASSERT_TRUE( array.is_array() );
+  EXPECT_EQ( "abc", array[0].get_string() );
+  ASSERT_TRUE( dict.is_object() );
+  EXPECT_EQ( 1, dict["x"].get_int() );
+  EXPECT_EQ( dict, array[1] );
+
+  // アリーナの要素を含む値を組み立てる．
+  auto value2 = JsonValue{std::vector<JsonValue>{array, dict}};
+  array = JsonValue{};
+  dict = JsonValue{};
+  EXPECT_EQ( "abc", value2[0][0].get_string() );
+  EXPECT_EQ( 1, value2[1]["x"].get_int() );
+}
+
+TEST(JsonTest, object_order)
+{
+  // 索引を作る大きさのオブジェクト
+  const int n = 100;
+  std::string json_str{"{"};
+  for ( int i = n - 1; i >= 0; -- i ) {
+    json_str += "\"key" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+  }
+  // 重複したキーは最初のものが残る．
+  json_str += "\"key0\":-1}";
+
+  auto value = JsonValue::parse(json_str);
+  ASSERT_TRUE( value.is_object() );
+  EXPECT_EQ( n, value.size() );
+  auto key_list = value.key_list();
+  ASSERT_EQ( n, key_list.size() );
+  for ( int i = 0; i < n; ++ i ) {
+    auto key = "key" + std::to_string(i);
+    EXPECT_EQ( key, key_list[n - i - 1] );
+    ASSERT_TRUE( value.has_key(key) );
+    EXPECT_EQ( i, value[key].get_int() );
+  }
+  EXPECT_FALSE( value.has_key("key100") );
+  EXPECT_TRUE( value.get("key100").is_null() );
+
+  // 順番が異なっても等価
+  auto value2 = JsonValue::parse("{\"a\":1, \"b\":2, \"a\":3}");
+  auto value3 = JsonValue::parse("{\"b\":2, \"a\":1}");
+  EXPECT_EQ( 2, value2.size() );
+  EXPECT_EQ( value2, value3 );
+  EXPECT_EQ( "{\"a\":1,\"b\":2}", value2.to_json() );
+  EXPECT_EQ( "{\"b\":2,\"a\":1}", value3.to_json() );
+}
+
+TEST(JsonTest, lazy)
+{
+  std::string json_str{"{ \"a\" : [ 1, { \"x\" : \"abc\" }, [] ],\n"
+		       "  \"b\" : { \"y\" : [ true ] }, \"c\" : 2.5 }"};
+
+  auto value = JsonValue::parse(json_str, true);
+  ASSERT_TRUE( value.is_object() );
+  auto a = value["a"];
+  ASSERT_TRUE( a.is_array() );
+  EXPECT_EQ( 1, a[0].get_int() );
+  EXPECT_EQ( "abc", a[1]["x"].get_string() );
+  EXPECT_TRUE( a[2].is_array() );
+  EXPECT_EQ( 0, a[2].size() );
+  EXPECT_THROW( a[3], std::out_of_range );
+  EXPECT_EQ( 2.5, value["c"].get_float() );
+  EXPECT_FALSE( value.has_key("d") );
+  EXPECT_TRUE( value.get("d").is_null() );
+  EXPECT_THROW( value["d"], std::invalid_argument );
+  EXPECT_EQ( 3, value.size() );
+
+  // 通常の読み込み結果と同じになる．
+  auto value2 = JsonValue::parse(json_str);
+  EXPECT_EQ( value2, value );
+  EXPECT_EQ( value2.to_json(true), JsonValue::parse(json_str, true).to_json(true) );
+
+  // 元の文字列はコピーされている．
+  JsonValue b;
+  {
+    std::string tmp_str{json_str};
+    b = JsonValue::parse(tmp_str, true)["b"];
+  }
+  EXPECT_EQ( true, b["y"][0].get_bool() );
+
+  // 途中まで読んだ要素の後ろの要素
+  auto value3 = JsonValue::parse(json_str, true);
+  EXPECT_EQ( "abc", value3["a"][1]["x"].get_string() );
+  EXPECT_EQ( 2.5, value3["c"].get_float() );
+  EXPECT_EQ( 0, value3["a"][2].size() );
+  EXPECT_EQ( value2, value3 );
+
+  // 根が配列でもオブジェクトでもない場合
+  EXPECT_EQ( "xyz", JsonValue::parse("\"xyz\"", true).get_string() );
+  EXPECT_EQ( 3, JsonValue::parse(" 3 ", true).get_int() );
+}
+
+TEST(JsonTest, lazy_large)
+{
+  // 索引を作る大きさのオブジェクトと配列
+  const int n = 100;
+  std::string json_str{"{"};
+  for ( int i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ",";
+    }
+    json_str += "\"key" + std::to_string(i) + "\": [" + std::to_string(i) + "]";
+  }
+  json_str += ",\"key0\": null}";
+
+  auto value = JsonValue::parse(json_str, true);
+  EXPECT_EQ( 5, value["key5"][0].get_int() );
+  for ( int i = n - 1; i >= 0; -- i ) {
+    auto key = "key" + std::to_string(i);
+    ASSERT_TRUE( value.has_key(key) );
+    EXPECT_EQ( i, value[key][0].get_int() );
+  }
+  EXPECT_EQ( n, value.size() );
+  EXPECT_EQ( JsonValue::parse(json_str), value );
+}
+
+TEST(JsonTest, lazy_error)
+{
+  // 読み飛ばした部分のエラーは参照した時に検出される．
+  std::string json_str{"{\n  \"a\": 1,\n  \"b\": [ 1 2 ]\n}"};
+
+  auto value = JsonValue::parse(json_str, true);
+  EXPECT_EQ( 1, value["a"].get_int() );
+  auto b = value["b"];
+  std::string msg;
+  try {
+    b[0];
+    b[1];
+  }
+  catch ( std::invalid_argument& err ) {
+    msg = err.what();
+  }
+  EXPECT_EQ( "line 3, column = 12: 2: illegal token, ',' is expected", msg );
+
+  // 閉じ括弧が足りない．
+  // "a" の中身は "a" の全体を読む時まで読み飛ばさない．
+  auto value2 = JsonValue::parse("{ \"a\": { \"b\": [ 1 }", true);
+  auto a = value2["a"];
+  EXPECT_EQ( 1, a["b"][0].get_int() );
+  EXPECT_THROW( a.size(), std::invalid_argument );
+
+  // 根の後ろに余分な内容がある．
+  // 根を最後まで読み込んだ時に検出される．
+  EXPECT_THROW( JsonValue::parse("{\"a\":1} }", false), std::invalid_argument );
+  auto value3 = JsonValue::parse("{\"a\":1} }", true);
+  EXPECT_EQ( 1, value3["a"].get_int() );
+  EXPECT_THROW( value3.size(), std::invalid_argument );
+  EXPECT_THROW( value3.size(), std::invalid_argument );
+  EXPECT_THROW( value3.to_json(), std::invalid_argument );
+  auto value4 = JsonValue::parse("[1, [2]] 3", true);
+  EXPECT_THROW( value4.size(), std::invalid_argument );
+  EXPECT_EQ( 2, JsonValue::parse("[1, [2]] ", true).size() );
+}
+
+TEST(JsonTest, lazy_read)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+
+  auto value = JsonValue::read(path, true);
+  EXPECT_EQ( 1, value["object_key"]["sub_key2"].get_int() );
+  EXPECT_EQ( 3, value["array_key"][3].get_int() );
+  EXPECT_EQ( JsonValue::read(path), value );
+}
+
+TEST(JsonTest, read_compressed)
+{
+  std::string filename{"test.json"};
+  auto path = std::string{TESTDATA_DIR} + "/" + filename;
+  auto value = JsonValue::read(path);
+
+#ifdef HAS_ZLIB
+  EXPECT_EQ( value, JsonValue::read(path + ".gz") );
+  EXPECT_EQ( value, JsonValue::read(path + ".gz", true) );
+  EXPECT_EQ( value, JsonValue::read_parallel(path + ".gz", 2) );
+  EXPECT_EQ( 1, JsonPointer{"/object_key/sub_key2"}.read(path + ".gz").get_int() );
+#else
+  EXPECT_THROW( JsonValue::read(path + ".gz"), std::invalid_argument );
+#endif
+
+#ifdef HAS_ZSTD
+  EXPECT_EQ( value, JsonValue::read(path + ".zst") );
+  EXPECT_EQ( value, JsonValue::read(path + ".zst", true) );
+  EXPECT_EQ( value, JsonValue::read(path + ".zst", false, true) );
+#else
+  EXPECT_THROW( JsonValue::read(path + ".zst"), std::invalid_argument );
+#endif
+}
+
+TEST(JsonTest, read_broken_compressed)
+{
+  // broken.json.gz は test.json.gz の末尾を切り取ったもの
+  auto path = std::string{TESTDATA_DIR} + "/broken.json.gz";
+  for ( int i = 0; i < 5; ++ i ) {
+    EXPECT_THROW( JsonValue::read(path), std::invalid_argument );
+    EXPECT_THROW( JsonValue::read(path, true), std::invalid_argument );
+    EXPECT_THROW( JsonValue::read_parallel(path, 2), std::invalid_argument );
+  }
+
+#if defined(__linux__)
+  // 展開に失敗してもファイルのマップは解放されている．
+  std::ifstream maps{"/proc/self/maps"};
+  std::string line;
+  while ( std::getline(maps, line) ) {
+    EXPECT_EQ( std::string::npos, line.find("broken.json.gz") );
+  }
+#endif
+}
+
+TEST(JsonTest, parse_parallel)
+{
+  // 複数の範囲に分割される大きさの配列
+  const int n = 100000;
+  std::string json_str{"[\n"};
+  for ( int i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ",\n";
+    }
+    json_str += "{\"id\": " + std::to_string(i)
+      + ", \"tags\": [\"a,b\", \"]\"], \"v\": " + std::to_string(i * 0.5)
+      + "}";
+  }
+  json_str += "\n]\n";
+
+  auto value = JsonValue::parse_parallel(json_str, 4);
+  ASSERT_TRUE( value.is_array() );
+  ASSERT_EQ( n, value.size() );
+  for ( int i: {0, 1, n / 3, n - 1} ) {
+    EXPECT_EQ( i, value[i]["id"].get_int() );
+    EXPECT_EQ( "a,b", value[i]["tags"][0].get_string() );
+  }
+  EXPECT_EQ( JsonValue::parse(json_str), value );
+  EXPECT_EQ( value, JsonValue::parse_parallel(json_str, 4, true) );
+
+  // 根の要素は元のドキュメントが無くなっても有効
+  auto elem = value[n - 1];
+  value = JsonValue{};
+  EXPECT_EQ( n - 1, elem["id"].get_int() );
+
+  // 根が配列でない場合と小さい場合
+  EXPECT_EQ( JsonValue::parse("[1, 2, 3]"),
+	     JsonValue::parse_parallel("[1, 2, 3]", 4) );
+  auto obj_str = "{\"a\": " + json_str + "}";
+  EXPECT_EQ( JsonValue::parse(obj_str), JsonValue::parse_parallel(obj_str, 4) );
+  EXPECT_EQ( 0, JsonValue::parse_parallel("[]", 4).size() );
+}
+
+TEST(JsonTest, parse_parallel_error)
+{
+  const int n = 100000;
+  std::string json_str{"["};
+  for ( int i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ",\n";
+    }
+    json_str += "[" + std::to_string(i) + ", \"" + std::string(20, 'x') + "\"]";
+  }
+  json_str += "]";
+
+  // エラーメッセージは逐次に読み込んだ場合と同じ
+  for ( auto bad: {json_str.find(',', json_str.size() * 2 / 3),
+		   json_str.size() - 1} ) {
+    auto str = json_str;
+    str[bad] = '}';
+    std::string msg1;
+    try {
+      JsonValue::parse(str);
+    }
+    catch ( std::invalid_argument& err ) {
+      msg1 = err.what();
+    }
+    std::string msg2;
+    try {
+      JsonValue::parse_parallel(str, 4);
+    }
+    catch ( std::invalid_argument& err ) {
+      msg2 = err.what();
+    }
+    EXPECT_NE( "", msg1 );
+    EXPECT_EQ( msg1, msg2 );
+  }
+}
+
+TEST(JsonTest, intern)
+{
+  // 同じキーを持つレコードの配列と索引を作る大きさのオブジェクト
+  std::string json_str{"[\n"};
+  for ( int i = 0; i < 100; ++ i ) {
+    json_str += "{\"name\": \"n" + std::to_string(i) + "\", \"type\": "
+      + std::to_string(i % 3) + ", \"\": true},\n";
+  }
+  json_str += "{";
+  for ( int i = 0; i < 40; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ", ";
+    }
+    json_str += "\"key" + std::to_string(i) + "\": " + std::to_string(i);
+  }
+  json_str += ", \"key3\": null}\n]";
+
+  auto value = JsonValue::parse(json_str, false, true);
+  ASSERT_EQ( 101, value.size() );
+  for ( int i = 0; i < 100; ++ i ) {
+    auto rec = value[i];
+    EXPECT_EQ( "n" + std::to_string(i), rec["name"].get_string() );
+    EXPECT_EQ( i % 3, rec["type"].get_int() );
+    EXPECT_TRUE( rec[""].get_bool() );
+    EXPECT_FALSE( rec.has_key("key1") );
+    EXPECT_FALSE( rec.has_key("nam") );
+  }
+  auto dict = value[100];
+  EXPECT_EQ( 40, dict.size() );
+  for ( int i = 0; i < 40; ++ i ) {
+    auto key = "key" + std::to_string(i);
+    ASSERT_TRUE( dict.has_key(key) );
+    EXPECT_EQ( i, dict[key].get_int() );
+  }
+  EXPECT_FALSE( dict.has_key("name") );
+  EXPECT_FALSE( dict.has_key("key40") );
+  EXPECT_THROW( dict["undefined"], std::invalid_argument );
+
+  // 登録しない場合と同じ内容になる．
+  auto value2 = JsonValue::parse(json_str);
+  EXPECT_EQ( value2, value );
+  EXPECT_EQ( value, value2 );
+  EXPECT_EQ( value2.to_json(), value.to_json() );
+
+  // 遅延モードでは指定できない．
+  EXPECT_THROW( JsonValue::parse(json_str, true, true), std::invalid_argument );
+  auto path = std::string{TESTDATA_DIR} + "/test.json";
+  EXPECT_THROW( JsonValue::read(path, true, true), std::invalid_argument );
+}
+
+TEST(JsonTest, modify)
+{
+  std::string json_str{"{\"a\": {\"b\": [1, 2], \"c\": \"x\"}, \"d\": [true]}"};
+
+  for ( auto lazy: {false, true} ) {
+    auto value = JsonValue::parse(json_str, lazy);
+    auto orig = value;
+
+    // 根までの経路上のノードのみを複製する．
+    auto a = value["a"];
+    auto b = a["b"];
+    b.set(1, JsonValue{20});
+    a.set("b", b);
+    a.erase("c");
+    value.set("a", a);
+    value.set("e", JsonValue{"y"});
+    EXPECT_EQ( "{\"a\":{\"b\":[1,20]},\"d\":[true],\"e\":\"y\"}",
+	       value.to_json() );
+    EXPECT_EQ( orig["d"], value["d"] );
+
+    // 元のドキュメントは変わらない．
+    EXPECT_EQ( JsonValue::parse(json_str), orig );
+  }
+}
+
+TEST(JsonTest, range)
+{
+  std::string json_str{"{\"a\": [1, \"x\", [2]], \"b\": {\"c\": null}}"};
+
+  for ( auto lazy: {false, true} ) {
+    // 一時的な値に対する範囲
+    std::string keys;
+    for ( auto [key, value]: JsonValue::parse(json_str, lazy).items() ) {
+      keys += key;
+      EXPECT_EQ( key == "a", value.is_array() );
+    }
+    EXPECT_EQ( "ab", keys );
+
+    auto value = JsonValue::parse(json_str, lazy);
+    SizeType n = 0;
+    for ( auto elem: value["a"].elements() ) {
+      EXPECT_EQ( value["a"][n], elem );
+      ++ n;
+    }
+    EXPECT_EQ( 3, n );
+    EXPECT_EQ( "x", value["a"][1].get_string_view() );
+    for ( auto key: value["b"].keys() ) {
+      EXPECT_EQ( "c", key );
+    }
+  }
+}
+
 END_NAMESPACE_YM
@@ -0,0 +1,139 @@
+
+/// @file JsonValueRefTest.cc
+/// @brief JsonValueRef のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonValueRef.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+TEST(JsonValueRefTest, read)
+{
+  auto value = JsonValue::parse(
+    "{\"a\": [1, 2.5, \"x\", true, null],"
+    " \"b\": {\"c\": {\"d\": 4}}}"
+  );
+  JsonValueRef ref{value};
+  EXPECT_TRUE( ref.is_object() );
+  EXPECT_EQ( 2, ref.size() );
+  EXPECT_TRUE( ref.has_key("a") );
+  EXPECT_FALSE( ref.has_key("z") );
+
+  auto a = ref["a"];
+  ASSERT_TRUE( a.is_array() );
+  EXPECT_EQ( 5, a.size() );
+  EXPECT_EQ( 1, a[0].get_int() );
+  EXPECT_EQ( 2.5, a[1].get_float() );
+  EXPECT_EQ( "x", a[2].get_string_view() );
+  EXPECT_TRUE( a[3].get_bool() );
+  EXPECT_TRUE( a[4].is_null() );
+  EXPECT_EQ( 4, ref["b"]["c"]["d"].get_int() );
+  EXPECT_TRUE( ref.get("z").is_null() );
+  EXPECT_EQ( value["b"], ref["b"].value() );
+  EXPECT_EQ( value["a"].to_json(), a.to_json() );
+
+  // エラーは JsonValue と同じ
+  EXPECT_THROW( ref["z"], std::invalid_argument );
+  EXPECT_THROW( ref[0], std::invalid_argument );
+  EXPECT_THROW( a[5], std::out_of_range );
+  EXPECT_THROW( a[0].get_string(), std::invalid_argument );
+
+  // 要素をたどる．
+  std::vector<std::string> elem_list;
+  for ( auto elem: a.elements() ) {
+    elem_list.push_back(elem.to_json());
+  }
+  EXPECT_EQ( (std::vector<std::string>{"1", "2.5", "\"x\"", "true", "null"}),
+	     elem_list );
+  std::vector<std::string> key_list;
+  for ( auto key: ref.keys() ) {
+    key_list.push_back(std::string{key});
+  }
+  EXPECT_EQ( (std::vector<std::string>{"a", "b"}), key_list );
+  SizeType n = 0;
+  for ( auto p: ref.items() ) {
+    EXPECT_EQ( value[std::string{p.first}], p.second.value() );
+    ++ n;
+  }
+  EXPECT_EQ( 2, n );
+}
+
+TEST(JsonValueRefTest, ctor)
+{
+  // 一時オブジェクトからは作れない．
+  static_assert( !std::is_constructible_v<JsonValueRef, JsonValue&&> );
+  static_assert( std::is_constructible_v<JsonValueRef, const JsonValue&> );
+  // 暗黙の変換は行わない．
+  static_assert( !std::is_convertible_v<const JsonValue&, JsonValueRef> );
+
+  JsonValueRef ref;
+  EXPECT_TRUE( ref.is_null() );
+}
+
+TEST(JsonValueRefTest, heap)
+{
+  // ヒープ上に作った値も参照できる．
+  auto value = JsonValue{std::vector<JsonValue>{
+      JsonValue{1},
+      JsonValue{std::unordered_map<std::string, JsonValue>{
+	  {"k", JsonValue{"v"}}}}}};
+  JsonValueRef ref{value};
+  EXPECT_EQ( 1, ref[0].get_int() );
+  EXPECT_EQ( "v", ref[1]["k"].get_string() );
+
+  // value() で所有権を持つ値にすると元の値が破棄されても有効
+  JsonValue elem;
+  {
+    auto tmp = JsonValue::parse("[{\"k\": \"w\"}]");
+    elem = JsonValueRef{tmp}[0].value();
+  }
+  EXPECT_EQ( "w", elem["k"].get_string() );
+
+  // 元の値を書き換えても参照先の内容は変わらない．
+  auto value2 = value;
+  auto row = value2[1];
+  row.set("k", JsonValue{"x"});
+  value2.set(1, row);
+  EXPECT_EQ( "v", ref[1]["k"].get_string() );
+  EXPECT_EQ( "x", JsonValueRef{value2}[1]["k"].get_string() );
+}
+
+TEST(JsonValueRefTest, table)
+{
+  // 表形式の配列と遅延モードの値
+  std::string json_str{"["};
+  for ( int i = 0; i < 20; ++ i ) {
+    if ( i > 0 ) {
+      json_str += ",";
+    }
+    json_str += "{\"id\":" + std::to_string(i) + ",\"s\":\"s" +
+      std::to_string(i) + "\"}";
+  }
+  json_str += "]";
+  for ( bool lazy: {false, true} ) {
+    auto value = JsonValue::parse(json_str, lazy);
+    JsonValueRef ref{value};
+    std::int64_t sum = 0;
+    for ( SizeType i = 0; i < ref.size(); ++ i ) {
+      sum += ref[i]["id"].get_int();
+    }
+    EXPECT_EQ( 190, sum );
+    sum = 0;
+    for ( auto row: ref.elements() ) {
+      for ( auto p: row.items() ) {
+	if ( p.first == "id" ) {
+	  sum += p.second.get_int();
+	}
+      }
+    }
+    EXPECT_EQ( 190, sum );
+    EXPECT_EQ( "s7", ref[7]["s"].get_string_view() );
+  }
+}
+
+END_NAMESPACE_YM_JSON
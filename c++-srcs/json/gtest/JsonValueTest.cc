@@ -202,8 +202,8 @@ TEST(JsonValueTest, string_dq)
 
   EXPECT_EQ( value, json_obj.get_string() );
   // double-quote を含む文字列を表す json 文字列は
-  // single-quote を用いる．
-  EXPECT_EQ( "'\"abcde\"'", json_obj.to_json() );
+  // double-quote をエスケープする．
+  EXPECT_EQ( R"("\"abcde\"")", json_obj.to_json() );
 }
 
 TEST(JsonValueTest, string_sq)
@@ -241,8 +241,7 @@ TEST(JsonValueTest, string_dqsq)
   EXPECT_FALSE( json_obj.is_array() );
 
   EXPECT_EQ( value, json_obj.get_string() );
-  // single-quote と double-quote を含む文字列を表す json 文字列は
-  // double-quote を用い，double-quote をエスケープする．
+  // single-quote はエスケープしない．
   EXPECT_EQ( R"("\"'abcde'\"")", json_obj.to_json() );
 }
 
@@ -291,6 +290,46 @@ TEST(JsonValueTest, int)
   EXPECT_TRUE( str_obj != json_obj );
 }
 
+TEST(JsonValueTest, int64)
+{
+  std::int64_t value = 1234567890123456789;
+  JsonValue json_obj{value};
+
+  EXPECT_TRUE( json_obj.is_int() );
+  EXPECT_EQ( value, json_obj.get_int() );
+  EXPECT_EQ( "1234567890123456789", json_obj.to_json() );
+  auto copy_obj = JsonValue::parse("[-1234567890123456789]");
+  EXPECT_EQ( -value, copy_obj[0].get_int() );
+}
+
+TEST(JsonValueTest, int_types)
+{
+  // int 以外の整数型もそのまま受け付ける．
+  JsonValue ll_obj{1234567890123LL};
+  EXPECT_TRUE( ll_obj.is_int() );
+  EXPECT_EQ( 1234567890123, ll_obj.get_int() );
+
+  JsonValue l_obj{-5L};
+  EXPECT_EQ( -5, l_obj.get_int() );
+
+  JsonValue u_obj{4000000000u};
+  EXPECT_TRUE( u_obj.is_int() );
+  EXPECT_EQ( 4000000000, u_obj.get_int() );
+
+  std::size_t size = 42;
+  JsonValue size_obj{size};
+  EXPECT_EQ( JsonValue{42}, size_obj );
+
+  std::uint64_t u64 = std::numeric_limits<std::int64_t>::max();
+  EXPECT_EQ( std::numeric_limits<std::int64_t>::max(),
+	     JsonValue{u64}.get_int() );
+  ++ u64;
+  EXPECT_THROW( JsonValue{u64}, std::invalid_argument );
+
+  // bool はブール型のままとなる．
+  EXPECT_TRUE( JsonValue{true}.is_bool() );
+}
+
 TEST(JsonValueTest, float)
 {
   double value = 1.2345;
@@ -430,7 +469,7 @@ TEST(JsonValueTest, array1)
   int value2 = 2;
   JsonValue json2{value2};
 
-  float value3 = 0.99;
+  double value3 = 0.99;
   JsonValue json3{value3};
 
   std::vector<JsonValue> value{json1, json2, json3};
@@ -489,7 +528,7 @@ TEST(JsonValueTest, object1)
   int value2 = 2;
   JsonValue json2{value2};
 
-  float value3 = 0.99;
+  double value3 = 0.99;
   JsonValue json3{value3};
 
   std::unordered_map<std::string, JsonValue> value{
@@ -553,4 +592,209 @@ TEST(JsonValueTest, object1)
   EXPECT_TRUE( str_obj != json_obj );
 }
 
+TEST(JsonValueTest, object_order)
+{
+  // キーと値の対のリストから作った場合はその順番になる．
+  std::vector<std::pair<std::string, JsonValue>> item_list{
+    {"b", JsonValue{1}},
+    {"a", JsonValue{2}},
+    {"c", JsonValue{3}},
+    {"a", JsonValue{4}}
+  };
+  JsonValue json_obj{item_list};
+  EXPECT_EQ( R"({"b":1,"a":2,"c":3})", json_obj.to_json() );
+  // 重複したキーは最初のものが残る．
+  EXPECT_EQ( 3, json_obj.size() );
+  EXPECT_EQ( 2, json_obj["a"].get_int() );
+
+  JsonValue json_obj2{std::move(item_list)};
+  EXPECT_EQ( json_obj, json_obj2 );
+  EXPECT_EQ( json_obj.to_json(), json_obj2.to_json() );
+}
+
+TEST(JsonValueTest, inline_scalar)
+{
+  // スカラー値は JsonValue 自身に格納される．
+  EXPECT_EQ( 16, sizeof(JsonValue) );
+
+  auto value = JsonValue::parse("[1, 2.5, true, null, \"abc\"]");
+  ASSERT_TRUE( value.is_array() );
+  EXPECT_EQ( 5, value.size() );
+  EXPECT_EQ( JsonValue{1}, value[0] );
+  EXPECT_EQ( JsonValue{2.5}, value[1] );
+  EXPECT_EQ( JsonValue{true}, value[2] );
+  EXPECT_TRUE( value[3].is_null() );
+  EXPECT_EQ( JsonValue{"abc"}, value[4] );
+  EXPECT_EQ( "[1,2.5,true,null,\"abc\"]", value.to_json() );
+
+  // コピーとムーブ
+  auto str = value[4];
+  JsonValue copy{str};
+  JsonValue moved{std::move(str)};
+  EXPECT_TRUE( str.is_null() );
+  EXPECT_EQ( copy, moved );
+  value = JsonValue{};
+  copy = copy;
+  EXPECT_EQ( "abc", copy.get_string() );
+  moved = JsonValue{3};
+  EXPECT_EQ( 3, moved.get_int() );
+}
+
+TEST(JsonValueTest, move_ctor)
+{
+  JsonValue elem{"xyz"};
+  std::vector<JsonValue> array{elem, JsonValue{1}};
+  std::unordered_map<std::string, JsonValue> dict{
+    {"key1", elem},
+    {"key2", JsonValue{2.0}}
+  };
+  JsonValue array_copy{array};
+  JsonValue dict_copy{dict};
+
+  JsonValue array_obj{std::move(array)};
+  JsonValue dict_obj{std::move(dict)};
+  EXPECT_EQ( array_copy, array_obj );
+  EXPECT_EQ( dict_copy, dict_obj );
+  EXPECT_EQ( "xyz", array_obj[0].get_string() );
+  EXPECT_EQ( "xyz", dict_obj["key1"].get_string() );
+}
+
+TEST(JsonValueTest, hash)
+{
+  // 等しい値は同じハッシュ値を持つ．
+  auto value1 = JsonValue::parse("{\"a\": [1, 2.5, \"x\"], \"b\": {\"c\": null}}");
+  auto value2 = JsonValue::parse("{\"b\": {\"c\": null}, \"a\": [1, 2.5, \"x\"]}");
+  EXPECT_EQ( value1, value2 );
+  EXPECT_EQ( value1.hash(), value2.hash() );
+  EXPECT_EQ( value1.hash(), std::hash<JsonValue>{}(value2) );
+  EXPECT_EQ( JsonValue{0.0}.hash(), JsonValue{-0.0}.hash() );
+
+  // 配列の順番は影響する．
+  auto value3 = JsonValue::parse("[1, 2]");
+  auto value4 = JsonValue::parse("[2, 1]");
+  EXPECT_NE( value3.hash(), value4.hash() );
+  EXPECT_NE( value3, value4 );
+
+  // ハッシュ値を求めた後でも比較結果は変わらない．
+  auto value5 = JsonValue::parse("{\"a\": [1, 2.5, \"y\"], \"b\": {\"c\": null}}");
+  EXPECT_NE( value1.hash(), value5.hash() );
+  EXPECT_NE( value1, value5 );
+  EXPECT_EQ( value1, JsonValue::parse(value1.to_json(), true) );
+}
+
+TEST(JsonValueTest, modify_object)
+{
+  std::unordered_map<std::string, JsonValue> dict{
+    {"a", JsonValue{1}},
+    {"b", JsonValue{"x"}}
+  };
+  JsonValue value{dict};
+  auto copy = value;
+
+  value.set("a", JsonValue{2});
+  value.set("c", JsonValue{true});
+  EXPECT_EQ( 3, value.size() );
+  EXPECT_EQ( 2, value["a"].get_int() );
+  EXPECT_TRUE( value["c"].get_bool() );
+  EXPECT_EQ( "{\"a\":2,\"b\":\"x\",\"c\":true}", value.to_json() );
+
+  // コピー元は変わらない．
+  EXPECT_EQ( "{\"a\":1,\"b\":\"x\"}", copy.to_json() );
+
+  EXPECT_TRUE( value.erase("b") );
+  EXPECT_FALSE( value.erase("b") );
+  EXPECT_FALSE( value.has_key("b") );
+  EXPECT_EQ( "{\"a\":2,\"c\":true}", value.to_json() );
+
+  // 索引を作る大きさを超えて追加する．
+  auto h = value.hash();
+  for ( int i = 0; i < 100; ++ i ) {
+    value.set("key" + std::to_string(i), JsonValue{i});
+  }
+  EXPECT_NE( h, value.hash() );
+  EXPECT_EQ( 102, value.size() );
+  for ( int i = 0; i < 100; i += 2 ) {
+    EXPECT_TRUE( value.erase("key" + std::to_string(i)) );
+  }
+  EXPECT_EQ( 52, value.size() );
+  for ( int i = 0; i < 100; ++ i ) {
+    auto key = "key" + std::to_string(i);
+    EXPECT_EQ( i % 2 == 1, value.has_key(key) );
+  }
+  EXPECT_EQ( 99, value["key99"].get_int() );
+
+  // 自身を要素にする．
+  auto value2 = copy;
+  value2.set("self", value2);
+  EXPECT_EQ( copy, value2["self"] );
+
+  EXPECT_THROW( value.push_back(JsonValue{}), std::invalid_argument );
+  EXPECT_THROW( JsonValue{1}.set("a", JsonValue{}), std::invalid_argument );
+}
+
+TEST(JsonValueTest, modify_array)
+{
+  JsonValue value{std::vector<JsonValue>{JsonValue{1}, JsonValue{"x"}}};
+  auto copy = value;
+
+  value.set(0, JsonValue{2.5});
+  value.push_back(JsonValue{});
+  EXPECT_EQ( "[2.5,\"x\",null]", value.to_json() );
+  EXPECT_EQ( "[1,\"x\"]", copy.to_json() );
+
+  value.erase(1);
+  EXPECT_EQ( "[2.5,null]", value.to_json() );
+  EXPECT_THROW( value.erase(2), std::out_of_range );
+  EXPECT_THROW( value.set(2, JsonValue{}), std::out_of_range );
+  EXPECT_THROW( value.erase("a"), std::invalid_argument );
+
+  // 入れ子の要素を書き換える．
+  JsonValue outer{std::vector<JsonValue>{copy, copy}};
+  auto outer_copy = outer;
+  auto elem = outer[1];
+  elem.push_back(JsonValue{3});
+  outer.set(1, elem);
+  EXPECT_EQ( "[[1,\"x\"],[1,\"x\",3]]", outer.to_json() );
+  EXPECT_EQ( "[[1,\"x\"],[1,\"x\"]]", outer_copy.to_json() );
+  EXPECT_EQ( copy, outer[0] );
+}
+
+TEST(JsonValueTest, range)
+{
+  JsonValue array{std::vector<JsonValue>{JsonValue{1}, JsonValue{"x"}}};
+  std::vector<JsonValue> elem_list;
+  for ( auto elem: array.elements() ) {
+    elem_list.push_back(elem);
+  }
+  ASSERT_EQ( 2, elem_list.size() );
+  EXPECT_EQ( JsonValue{1}, elem_list[0] );
+  EXPECT_EQ( "x", elem_list[1].get_string_view() );
+  EXPECT_EQ( 2, array.elements().size() );
+
+  std::unordered_map<std::string, JsonValue> dict{
+    {"a", JsonValue{1}},
+    {"b", JsonValue{"x"}}
+  };
+  JsonValue obj{dict};
+  std::vector<std::string_view> key_list;
+  for ( auto key: obj.keys() ) {
+    key_list.push_back(key);
+  }
+  EXPECT_EQ( (std::vector<std::string_view>{"a", "b"}), key_list );
+  auto range = obj.items();
+  // 範囲を作った後で書き換えても範囲の内容は変わらない．
+  obj.set("a", JsonValue{2});
+  SizeType n = 0;
+  for ( auto [key, value]: range ) {
+    EXPECT_EQ( dict.at(std::string{key}), value );
+    ++ n;
+  }
+  EXPECT_EQ( 2, n );
+
+  EXPECT_TRUE( JsonValue{std::vector<JsonValue>{}}.elements().empty() );
+  EXPECT_THROW( array.keys(), std::invalid_argument );
+  EXPECT_THROW( obj.elements(), std::invalid_argument );
+  EXPECT_THROW( obj.get_string_view(), std::invalid_argument );
+}
+
 END_NAMESPACE_YM
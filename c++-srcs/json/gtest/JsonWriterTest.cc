@@ -0,0 +1,188 @@
+
+/// @file JsonWriterTest.cc
+/// @brief JsonWriterTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonWriter.h"
+#include "ym/JsonValue.h"
+#include <cmath>
+#include <limits>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+TEST(JsonWriterTest, events)
+{
+  std::string buff;
+  {
+    JsonWriter writer{buff};
+    writer.object_begin();
+    writer.write_key("a");
+    writer.write_int(1);
+    writer.write_key("b");
+    writer.array_begin();
+    writer.write_float(0.5);
+    writer.write_bool(true);
+    writer.write_null();
+    writer.write_string("x'y");
+    writer.write_string("x\"y");
+    writer.array_end();
+    writer.write_key("c");
+    writer.object_begin();
+    writer.object_end();
+    writer.object_end();
+  }
+  EXPECT_EQ( R"({"a":1,"b":[0.5,true,null,"x'y","x\"y"],"c":{}})", buff );
+}
+
+TEST(JsonWriterTest, indent)
+{
+  std::string buff;
+  {
+    JsonWriter writer{buff, true};
+    writer.object_begin();
+    writer.write_key("a");
+    writer.write_int(1);
+    writer.write_key("b");
+    writer.array_begin();
+    writer.write_int(2);
+    writer.write_int(3);
+    writer.array_end();
+    writer.object_end();
+  }
+  std::string exp_str;
+  exp_str += "{\n";
+  exp_str += "    \"a\":1,\n";
+  exp_str += "    \"b\":[\n";
+  exp_str += "        2,\n";
+  exp_str += "        3\n";
+  exp_str += "    ]\n";
+  exp_str += "}\n";
+  EXPECT_EQ( exp_str, buff );
+}
+
+TEST(JsonWriterTest, value)
+{
+  std::string json_str{"{\"key1\": [1, 2.5, {\"x\": \"abc\"}], \"key2\": false}"};
+  auto value = JsonValue::parse(json_str);
+
+  for ( bool indent: {false, true} ) {
+    std::ostringstream s;
+    {
+      JsonWriter writer{s, indent};
+      writer.write_value(value);
+    }
+    EXPECT_EQ( value.to_json(indent), s.str() );
+    EXPECT_EQ( value, JsonValue::parse(s.str()) );
+  }
+}
+
+TEST(JsonWriterTest, float)
+{
+  // 読み戻して同じ値になる最短の表記
+  for ( auto p: std::initializer_list<std::pair<double, const char*>>{
+      {0.1, "0.1"},
+      {1.0, "1.0"},
+      {-2.0, "-2.0"},
+      {0.1 + 0.2, "0.30000000000000004"},
+      {1e300, "1e+300"},
+      {123456.75, "123456.75"}} ) {
+    std::string buff;
+    {
+      JsonWriter writer{buff};
+      writer.write_float(p.first);
+    }
+    EXPECT_EQ( p.second, buff );
+    auto value = JsonValue::parse(buff);
+    EXPECT_TRUE( value.is_float() );
+    EXPECT_EQ( p.first, value.get_float() );
+  }
+}
+
+TEST(JsonWriterTest, non_finite)
+{
+  // 無限大と NaN は JSON で表せない．
+  for ( auto v: {std::numeric_limits<double>::infinity(),
+		 -std::numeric_limits<double>::infinity(),
+		 std::numeric_limits<double>::quiet_NaN()} ) {
+    std::string buff;
+    JsonWriter writer{buff};
+    writer.array_begin();
+    EXPECT_THROW( writer.write_float(v), std::invalid_argument );
+    // 何も書き出さないので続けて書ける．
+    writer.write_float(1.5);
+    writer.array_end();
+    EXPECT_EQ( "[1.5]", buff );
+  }
+
+  // 範囲を超える値は無限大として読み込まれるが書き出せない．
+  auto value = JsonValue::parse("[1e400]");
+  EXPECT_TRUE( std::isinf(value[0].get_float()) );
+  EXPECT_THROW( value.to_json(), std::invalid_argument );
+}
+
+TEST(JsonWriterTest, escape)
+{
+  // 読み込んだ文字列を書き出して読み戻すと同じ値になる．
+  for ( auto p: std::initializer_list<std::pair<const char*, const char*>>{
+      {R"(["c\\d"])", "c\\d"},
+      {R"(["x\ny"])", "x\ny"},
+      {R"(["\u0001"])", "\x01"},
+      {R"(["a\"b"])", "a\"b"},
+      {R"(["\b\f\r\t"])", "\b\f\r\t"},
+      {R"(["\u007f\/'"])", "\x7f/'"},
+      {R"(["あ"])", "\xe3\x81\x82"}} ) {
+    auto value = JsonValue::parse(p.first);
+    ASSERT_EQ( p.second, value[0].get_string() );
+    auto json_str = value.to_json();
+    auto value2 = JsonValue::parse(json_str);
+    EXPECT_EQ( value, value2 );
+    EXPECT_EQ( p.second, value2[0].get_string() );
+  }
+
+  // オブジェクトのキーも同様
+  auto value = JsonValue::parse(R"({"k\"\\\n": 1})");
+  EXPECT_EQ( R"({"k\"\\\n":1})", value.to_json() );
+
+  // 出力の表記
+  EXPECT_EQ( R"(["a\"b","\\","\n\t","\u0001\u001f\u007f","'"])",
+	     JsonValue::parse(R"(["a\"b", "\\", "\n\t", "\u0001\u001f\u007f", "'"])").to_json() );
+}
+
+TEST(JsonWriterTest, stream)
+{
+  // バッファサイズを超える出力
+  const int n = 100000;
+  std::ostringstream s;
+  {
+    JsonWriter writer{s};
+    writer.array_begin();
+    for ( int i = 0; i < n; ++ i ) {
+      writer.write_int(i);
+    }
+    writer.array_end();
+  }
+  auto value = JsonValue::parse(s.str());
+  ASSERT_TRUE( value.is_array() );
+  ASSERT_EQ( n, value.size() );
+  EXPECT_EQ( n - 1, value[n - 1].get_int() );
+}
+
+TEST(JsonWriterTest, bad_sequence)
+{
+  std::string buff;
+  JsonWriter writer{buff};
+  EXPECT_THROW( writer.write_key("a"), std::invalid_argument );
+  EXPECT_THROW( writer.object_end(), std::invalid_argument );
+  writer.object_begin();
+  EXPECT_THROW( writer.write_int(1), std::invalid_argument );
+  EXPECT_THROW( writer.array_end(), std::invalid_argument );
+  writer.write_key("a");
+  EXPECT_THROW( writer.write_key("b"), std::invalid_argument );
+}
+
+END_NAMESPACE_YM_JSON
@@ -0,0 +1,485 @@
+
+/// @file DecompIStream.cc
+/// @brief DecompIStream の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/DecompIStream.h"
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAS_ZSTD
+#include <zstd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 入出力のバッファサイズ
+const SizeType BUFF_SIZE = 64 * 1024;
+
+// マジックナンバーの最大長
+const SizeType MAGIC_SIZE = 4;
+
+// 形式名を返す．
+const char*
+format_name(
+  DecompIStream::Format format
+)
+{
+  switch ( format ) {
+  case DecompIStream::Format::Plain: return "plain";
+  case DecompIStream::Format::Gzip:  return "gzip";
+  case DecompIStream::Format::Zstd:  return "zstd";
+  }
+  return "";
+}
+
+// 展開中のエラーを表す例外を送出する．
+void
+decomp_error(
+  DecompIStream::Format format,
+  const std::string& msg
+)
+{
+  std::ostringstream buf;
+  buf << format_name(format) << ": " << msg;
+  throw std::invalid_argument{buf.str()};
+}
+
+//////////////////////////////////////////////////////////////////////
+// メモリ上の領域を読み出す streambuf
+//////////////////////////////////////////////////////////////////////
+class MemStreamBuf :
+  public std::streambuf
+{
+public:
+
+  // コンストラクタ
+  MemStreamBuf(
+    std::string_view data
+  )
+  {
+    // 書き換えることはないので const を外してもよい．
+    auto p = const_cast<char*>(data.data());
+    setg(p, p, p + data.size());
+  }
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class DecompStreamBuf
+/// @brief DecompIStream の展開を行う streambuf
+///
+/// 入力元から BUFF_SIZE ずつ読み込んで，展開した結果を
+/// 出力用のバッファに置く．
+//////////////////////////////////////////////////////////////////////
+class DecompStreamBuf :
+  public std::streambuf
+{
+public:
+
+  /// @brief コンストラクタ
+  DecompStreamBuf(
+    std::streambuf* src ///< [in] 入力元
+  );
+
+  /// @brief デストラクタ
+  ~DecompStreamBuf();
+
+  /// @brief 圧縮形式を返す．
+  DecompIStream::Format
+  format() const
+  {
+    return mFormat;
+  }
+
+  /// @brief 残りの内容を全て展開して末尾に追加する．
+  void
+  read_all(
+    std::string& buf ///< [out] 結果を追加する文字列
+  );
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // std::streambuf の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み出し用のバッファが空になった時に呼ばれる．
+  int_type
+  underflow() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力用のバッファが空の時に入力元から読み込む．
+  ///
+  /// 入力の末尾に達していたら false を返す．
+  bool
+  fill_input();
+
+  /// @brief 展開した結果を出力用のバッファに置く．
+  ///
+  /// 入力の末尾に達していたら 0 を返す．
+  SizeType
+  decode();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力元
+  std::streambuf* mSrc;
+
+  // 圧縮形式
+  DecompIStream::Format mFormat{DecompIStream::Format::Plain};
+
+  // 入力用のバッファ
+  std::vector<char> mIn;
+
+  // mIn 中の次に読み出す位置
+  SizeType mInPos{0};
+
+  // mIn 中の有効なデータの末尾
+  SizeType mInEnd{0};
+
+  // 出力用のバッファ
+  std::vector<char> mOut;
+
+  // 出力用のバッファが一杯になって展開器に出力が残っている時 true
+  bool mPending{false};
+
+  // 圧縮データの区切り(gzip のメンバ，zstd のフレーム)の末尾にいる時 true
+  bool mStreamEnd{false};
+
+#ifdef HAS_ZLIB
+  // zlib の展開器
+  z_stream mZ{};
+#endif
+
+#ifdef HAS_ZSTD
+  // libzstd の展開器
+  ZSTD_DStream* mZstd{nullptr};
+#endif
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DecompStreamBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+DecompStreamBuf::DecompStreamBuf(
+  std::streambuf* src
+) : mSrc{src},
+    mIn(BUFF_SIZE)
+{
+  // 先頭のマジックナンバーだけを読み込んで形式を判定する．
+  while ( mInEnd < MAGIC_SIZE ) {
+    auto n = mSrc->sgetn(mIn.data() + mInEnd, MAGIC_SIZE - mInEnd);
+    if ( n <= 0 ) {
+      break;
+    }
+    mInEnd += n;
+  }
+  mFormat = DecompIStream::detect(std::string_view{mIn.data(), mInEnd});
+  if ( !DecompIStream::is_supported(mFormat) ) {
+    decomp_error(mFormat, "compressed input is not supported in this build");
+  }
+  switch ( mFormat ) {
+  case DecompIStream::Format::Plain:
+    // 入力用のバッファをそのまま読み出す．
+    return;
+
+  case DecompIStream::Format::Gzip:
+#ifdef HAS_ZLIB
+    // 15 + 16 で gzip のヘッダを扱う．
+    if ( inflateInit2(&mZ, 15 + 16) != Z_OK ) {
+      decomp_error(mFormat, "cannot initialize the decoder");
+    }
+#endif
+    break;
+
+  case DecompIStream::Format::Zstd:
+#ifdef HAS_ZSTD
+    mZstd = ZSTD_createDStream();
+    if ( mZstd == nullptr ) {
+      decomp_error(mFormat, "cannot initialize the decoder");
+    }
+#endif
+    break;
+  }
+  mOut.resize(BUFF_SIZE);
+}
+
+// @brief デストラクタ
+DecompStreamBuf::~DecompStreamBuf()
+{
+#ifdef HAS_ZLIB
+  if ( mFormat == DecompIStream::Format::Gzip ) {
+    inflateEnd(&mZ);
+  }
+#endif
+#ifdef HAS_ZSTD
+  ZSTD_freeDStream(mZstd);
+#endif
+}
+
+// @brief 読み出し用のバッファが空になった時に呼ばれる．
+DecompStreamBuf::int_type
+DecompStreamBuf::underflow()
+{
+  if ( gptr() < egptr() ) {
+    return traits_type::to_int_type(*gptr());
+  }
+  if ( mFormat == DecompIStream::Format::Plain ) {
+    if ( mInPos == mInEnd && !fill_input() ) {
+      return traits_type::eof();
+    }
+    auto p = mIn.data();
+    setg(p + mInPos, p + mInPos, p + mInEnd);
+    mInPos = mInEnd;
+  }
+  else {
+    auto n = decode();
+    if ( n == 0 ) {
+      return traits_type::eof();
+    }
+    auto p = mOut.data();
+    setg(p, p, p + n);
+  }
+  return traits_type::to_int_type(*gptr());
+}
+
+// @brief 残りの内容を全て展開して末尾に追加する．
+void
+DecompStreamBuf::read_all(
+  std::string& buf
+)
+{
+  buf.append(gptr(), egptr() - gptr());
+  setg(eback(), egptr(), egptr());
+  while ( underflow() != traits_type::eof() ) {
+    buf.append(gptr(), egptr() - gptr());
+    setg(eback(), egptr(), egptr());
+  }
+}
+
+// @brief 入力用のバッファが空の時に入力元から読み込む．
+bool
+DecompStreamBuf::fill_input()
+{
+  if ( mInPos < mInEnd ) {
+    return true;
+  }
+  auto n = mSrc->sgetn(mIn.data(), mIn.size());
+  mInPos = 0;
+  mInEnd = n > 0 ? n : 0;
+  return mInEnd > 0;
+}
+
+// @brief 展開した結果を出力用のバッファに置く．
+SizeType
+DecompStreamBuf::decode()
+{
+  for ( ; ; ) {
+    if ( !mPending && !fill_input() ) {
+      if ( !mStreamEnd ) {
+	decomp_error(mFormat, "unexpected end of compressed data");
+      }
+      return 0;
+    }
+    SizeType n = 0;
+#ifdef HAS_ZLIB
+    if ( mFormat == DecompIStream::Format::Gzip ) {
+      if ( mStreamEnd ) {
+	// 続けて次のメンバがある．
+	inflateReset(&mZ);
+	mStreamEnd = false;
+      }
+      mZ.next_in = reinterpret_cast<Bytef*>(mIn.data() + mInPos);
+      mZ.avail_in = mInEnd - mInPos;
+      mZ.next_out = reinterpret_cast<Bytef*>(mOut.data());
+      mZ.avail_out = mOut.size();
+      auto ret = inflate(&mZ, Z_NO_FLUSH);
+      if ( ret == Z_STREAM_END ) {
+	mStreamEnd = true;
+      }
+      else if ( ret != Z_OK && ret != Z_BUF_ERROR ) {
+	decomp_error(mFormat, mZ.msg != nullptr ? mZ.msg : "corrupted data");
+      }
+      mInPos = mInEnd - mZ.avail_in;
+      n = mOut.size() - mZ.avail_out;
+      mPending = !mStreamEnd && mZ.avail_out == 0;
+    }
+#endif
+#ifdef HAS_ZSTD
+    if ( mFormat == DecompIStream::Format::Zstd ) {
+      ZSTD_inBuffer in{mIn.data() + mInPos, mInEnd - mInPos, 0};
+      ZSTD_outBuffer out{mOut.data(), mOut.size(), 0};
+      auto ret = ZSTD_decompressStream(mZstd, &out, &in);
+      if ( ZSTD_isError(ret) ) {
+	decomp_error(mFormat, ZSTD_getErrorName(ret));
+      }
+      // 次のフレームは同じ展開器でそのまま扱える．
+      mStreamEnd = ret == 0;
+      mInPos += in.pos;
+      n = out.pos;
+      mPending = out.pos == out.size;
+    }
+#endif
+    if ( n > 0 ) {
+      return n;
+    }
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DecompIStream
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力ストリームを指定したコンストラクタ
+DecompIStream::DecompIStream(
+  std::istream& s
+) : std::istream{nullptr},
+    mBuf{new DecompStreamBuf{s.rdbuf()}}
+{
+  rdbuf(mBuf.get());
+  // 展開中のエラーを例外のまま呼び出し側に伝える．
+  exceptions(std::ios::badbit);
+}
+
+// @brief ファイル名を指定したコンストラクタ
+DecompIStream::DecompIStream(
+  const std::string& filename
+) : std::istream{nullptr},
+    mFile{new std::ifstream{filename, std::ios::binary}}
+{
+  if ( !*mFile ) {
+    std::ostringstream buf;
+    buf << filename << ": No such file";
+    throw std::invalid_argument{buf.str()};
+  }
+  mBuf = std::make_unique<DecompStreamBuf>(mFile->rdbuf());
+  rdbuf(mBuf.get());
+  exceptions(std::ios::badbit);
+}
+
+// @brief デストラクタ
+DecompIStream::~DecompIStream()
+{
+}
+
+// @brief 入力の圧縮形式を返す．
+DecompIStream::Format
+DecompIStream::format() const
+{
+  return mBuf->format();
+}
+
+// @brief 先頭の内容から圧縮形式を判定する．
+DecompIStream::Format
+DecompIStream::detect(
+  std::string_view head
+)
+{
+  auto match = [&](std::string_view magic) {
+    return head.substr(0, magic.size()) == magic;
+  };
+  if ( match(std::string_view{"\x1f\x8b", 2}) ) {
+    return Format::Gzip;
+  }
+  if ( match(std::string_view{"\x28\xb5\x2f\xfd", 4}) ) {
+    return Format::Zstd;
+  }
+  return Format::Plain;
+}
+
+// @brief 指定された圧縮形式を展開できる時 true を返す．
+bool
+DecompIStream::is_supported(
+  Format format
+)
+{
+  switch ( format ) {
+  case Format::Plain:
+    return true;
+
+  case Format::Gzip:
+#ifdef HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+
+  case Format::Zstd:
+#ifdef HAS_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+// @brief メモリ上の圧縮データをまとめて展開する．
+std::string
+DecompIStream::decompress(
+  std::string_view data
+)
+{
+  MemStreamBuf src{data};
+  DecompStreamBuf buf{&src};
+  std::string ans;
+  // 展開後のサイズがわかる場合は領域を確保しておく．
+  switch ( buf.format() ) {
+  case Format::Plain:
+    return std::string{data};
+
+  case Format::Gzip:
+    if ( data.size() >= 18 ) {
+      // 末尾の 4 バイトに展開後のサイズの下位 32 ビットが入っている．
+      auto p = reinterpret_cast<const unsigned char*>(data.data() + data.size() - 4);
+      SizeType size = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<SizeType>(p[3]) << 24);
+      // 壊れたデータで過大な領域を確保しないように deflate の
+      // 最大の圧縮率を超える値は無視する．
+      if ( size <= data.size() * 1032 ) {
+	ans.reserve(size);
+      }
+    }
+    break;
+
+  case Format::Zstd:
+#ifdef HAS_ZSTD
+    {
+      auto size = ZSTD_getFrameContentSize(data.data(), data.size());
+      // フレームのヘッダに書かれたサイズは信用できないので
+      // gzip と同様に圧縮率から見て過大な値は無視する．
+      if ( size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR &&
+	   size <= data.size() * 1032 ) {
+	ans.reserve(size);
+      }
+    }
+#endif
+    break;
+  }
+  buf.read_all(ans);
+  return ans;
+}
+
+END_NAMESPACE_YM
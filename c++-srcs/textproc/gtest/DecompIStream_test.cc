@@ -0,0 +1,170 @@
+
+/// @file DecompIStream_test.cc
+/// @brief DecompIStream_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/DecompIStream.h"
+#include "ym/Scanner.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ファイルの内容をそのまま読み込む．
+std::string
+read_file(
+  const std::string& path
+)
+{
+  std::ifstream s{path, std::ios::binary};
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  return buf.str();
+}
+
+// ストリームの内容を全て読み込む．
+std::string
+read_all(
+  std::istream& s
+)
+{
+  std::string ans;
+  char c;
+  while ( s.get(c) ) {
+    ans += c;
+  }
+  return ans;
+}
+
+END_NONAMESPACE
+
+TEST(DecompIStreamTest, plain)
+{
+  auto path = std::string{DATAPATH} + "text_unix.txt";
+  auto expected = read_file(path);
+
+  DecompIStream s{path};
+  EXPECT_EQ( DecompIStream::Format::Plain, s.format() );
+  EXPECT_EQ( expected, read_all(s) );
+
+  // マジックナンバーより短い入力
+  std::istringstream s2{"ab"};
+  DecompIStream ds2{s2};
+  EXPECT_EQ( "ab", read_all(ds2) );
+  EXPECT_EQ( "", DecompIStream::decompress("") );
+
+  EXPECT_THROW( DecompIStream{"/no/such/file"}, std::invalid_argument );
+}
+
+TEST(DecompIStreamTest, detect)
+{
+  EXPECT_EQ( DecompIStream::Format::Gzip,
+	     DecompIStream::detect(std::string_view{"\x1f\x8b\x08", 3}) );
+  EXPECT_EQ( DecompIStream::Format::Zstd,
+	     DecompIStream::detect(std::string_view{"\x28\xb5\x2f\xfd\x00", 5}) );
+  EXPECT_EQ( DecompIStream::Format::Plain,
+	     DecompIStream::detect(std::string_view{"\x1f", 1}) );
+  EXPECT_EQ( DecompIStream::Format::Plain, DecompIStream::detect("{}") );
+}
+
+TEST(DecompIStreamTest, gzip)
+{
+  auto path = std::string{DATAPATH} + "text_unix.txt";
+  auto expected = read_file(path);
+  auto data = read_file(path + ".gz");
+
+#ifdef HAS_ZLIB
+  DecompIStream s{path + ".gz"};
+  EXPECT_EQ( DecompIStream::Format::Gzip, s.format() );
+  EXPECT_EQ( expected, read_all(s) );
+
+  // Scanner で読み込む．
+  DecompIStream s2{path + ".gz"};
+  Scanner scan{s2, FileInfo{path}};
+  EXPECT_EQ( 'a', scan.get() );
+  EXPECT_EQ( 'b', scan.peek() );
+
+  // 複数のメンバを連結したもの
+  EXPECT_EQ( expected + expected, DecompIStream::decompress(data + data) );
+
+  // 途中で切れたもの
+  EXPECT_THROW( DecompIStream::decompress(data.substr(0, data.size() - 5)),
+		std::invalid_argument );
+  std::istringstream s3{data.substr(0, data.size() - 5)};
+  DecompIStream ds3{s3};
+  EXPECT_THROW( read_all(ds3), std::invalid_argument );
+
+  // 壊れたもの
+  auto bad = data;
+  bad[10] = ~bad[10];
+  EXPECT_THROW( DecompIStream::decompress(bad), std::invalid_argument );
+#else
+  EXPECT_FALSE( DecompIStream::is_supported(DecompIStream::Format::Gzip) );
+  EXPECT_THROW( DecompIStream{path + ".gz"}, std::invalid_argument );
+#endif
+}
+
+TEST(DecompIStreamTest, zstd)
+{
+  auto path = std::string{DATAPATH} + "text_unix.txt";
+  auto expected = read_file(path);
+  auto data = read_file(path + ".zst");
+
+#ifdef HAS_ZSTD
+  DecompIStream s{path + ".zst"};
+  EXPECT_EQ( DecompIStream::Format::Zstd, s.format() );
+  EXPECT_EQ( expected, read_all(s) );
+
+  // 複数のフレームを連結したもの
+  EXPECT_EQ( expected + expected, DecompIStream::decompress(data + data) );
+
+  // 途中で切れたもの
+  EXPECT_THROW( DecompIStream::decompress(data.substr(0, data.size() - 3)),
+		std::invalid_argument );
+
+  // ヘッダに過大な展開後のサイズを持つもの
+  std::string forged{"\x28\xb5\x2f\xfd"      // マジックナンバー
+		     "\xe0"                  // 8 バイトのサイズを持つ単一セグメント
+		     "\xff\xff\xff\xff\xff\xff\x00\x00" // 展開後のサイズ
+		     "\x81\x00\x00"          // 16 バイトの最後の非圧縮ブロック
+		     "0123456789abcdef", 32};
+  EXPECT_THROW( DecompIStream::decompress(forged), std::invalid_argument );
+#else
+  EXPECT_FALSE( DecompIStream::is_supported(DecompIStream::Format::Zstd) );
+  EXPECT_THROW( DecompIStream{path + ".zst"}, std::invalid_argument );
+#endif
+}
+
+TEST(DecompIStreamTest, large)
+{
+  // バッファの大きさを超える内容
+  // lines.txt.* は "000000" から "000999" までの行を 200 回繰り返したもの
+  std::string expected;
+  for ( int i = 0; i < 200000; ++ i ) {
+    auto str = std::to_string(i % 1000);
+    expected += std::string(6 - str.size(), '0') + str + "\n";
+  }
+
+  std::istringstream s{expected};
+  DecompIStream ds{s};
+  EXPECT_EQ( expected, read_all(ds) );
+
+  auto path = std::string{DATAPATH} + "lines.txt";
+#ifdef HAS_ZLIB
+  DecompIStream s1{path + ".gz"};
+  EXPECT_EQ( expected, read_all(s1) );
+  EXPECT_EQ( expected, DecompIStream::decompress(read_file(path + ".gz")) );
+#endif
+#ifdef HAS_ZSTD
+  DecompIStream s2{path + ".zst"};
+  EXPECT_EQ( expected, read_all(s2) );
+  EXPECT_EQ( expected, DecompIStream::decompress(read_file(path + ".zst")) );
+#endif
+}
+
+END_NAMESPACE_YM
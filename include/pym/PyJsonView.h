@@ -0,0 +1,87 @@
+#ifndef PYJSONVIEW_H
+#define PYJSONVIEW_H
+
+/// @file PyJsonView.h
+/// @brief PyJsonView のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "ym_config.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class PyJsonView PyJsonView.h "PyJsonView.h"
+/// @brief JsonValue を Python の Mapping/Sequence として見せる拡張
+///
+/// オブジェクト型の JsonValue は JsonObjectView (Mapping) に，
+/// 配列型の JsonValue は JsonArrayView (Sequence) になる．
+/// どちらも要素は参照された時に初めて変換し，
+/// 変換したものはビューの中にキャッシュしておく．
+/// そのため大きな値の一部だけを参照する場合は
+/// 参照した部分のみの変換で済む．
+/// それ以外の型の値は対応する Python の組み込み型のオブジェクトになる．
+///
+/// 実際には static メンバ関数しか持たないのでクラスではない．
+//////////////////////////////////////////////////////////////////////
+class PyJsonView
+{
+public:
+
+  using ElemType = JsonValue;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  /// @return 初期化が成功したら true を返す．
+  static
+  bool
+  init(
+    PyObject* m ///< [in] 親のモジュールを表す PyObject
+  );
+
+  /// @brief JsonValue を表すビューを作る．
+  /// @return 生成した PyObject を返す．
+  ///
+  /// オブジェクト型と配列型以外の場合は Python の組み込み型の
+  /// オブジェクトを返す．
+  /// 返り値は新しい参照が返される．
+  static
+  PyObject*
+  ToPyObject(
+    const ElemType& val ///< [in] 元の値
+  );
+
+  /// @brief PyObject が JsonObjectView か JsonArrayView タイプか調べる．
+  static
+  bool
+  Check(
+    PyObject* obj ///< [in] 対象の PyObject
+  );
+
+  /// @brief ビューを表す PyObject から JsonValue を取り出す．
+  /// @return JsonValue を返す．
+  ///
+  /// Check(obj) == true であると仮定している．
+  static
+  const ElemType&
+  _get_ref(
+    PyObject* obj ///< [in] 変換元の PyObject
+  );
+
+};
+
+END_NAMESPACE_YM
+
+#endif // PYJSONVIEW_H
@@ -18,6 +18,11 @@ BEGIN_NAMESPACE_YM
 /// @brief バイナリデコーダー
 ///
 /// istream のフィルタとして働く
+///
+/// 細かい読み出しが多いので istream::read() を用いずに
+/// ストリームバッファから直接読み出す．
+/// そのため sentry による tie() のフラッシュや gcount() の更新は行われない．
+/// 読み出しに失敗した場合は failbit を立てるので例外が送出される．
 /// @sa BinEnc
 //////////////////////////////////////////////////////////////////////
 class BinDec
@@ -47,9 +52,12 @@ public:
   std::uint8_t
   read_8()
   {
-    std::uint8_t buff[1];
-    raw_read(buff, 1);
-    return buff[0];
+    auto c = mS.rdbuf()->sbumpc();
+    if ( c == std::char_traits<char>::eof() ) {
+      // 例外を送出する．
+      mS.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    }
+    return static_cast<std::uint8_t>(c);
   }
 
   /// @brief 2バイトの読み出し
@@ -132,15 +140,14 @@ public:
   read_string()
   {
     auto l = read_64();
+    // 途中で例外が送出されても領域が解放されるように std::string に読み込む．
+    std::string ans(l, '\0');
     if ( l > 0 ) {
-      std::uint8_t* buff = new std::uint8_t[l + 1];
-      raw_read(buff, l);
-      buff[l] = '\0';
-      std::string ans(reinterpret_cast<char*>(buff));
-      delete [] buff;
-      return ans;
+      raw_read(reinterpret_cast<std::uint8_t*>(ans.data()), l);
     }
-    return std::string{};
+    // 以前の実装と同様に最初の '\0' までを結果とする．
+    ans.resize(std::char_traits<char>::length(ans.c_str()));
+    return ans;
   }
 
   /// @brief ブロックの読み出し
@@ -161,11 +168,10 @@ public:
   )
   {
     auto l = signature.size();
-    std::uint8_t* buff = new std::uint8_t[l + 1];
-    raw_read(buff, l);
-    buff[l] = '\0';
-    std::string tmp{reinterpret_cast<char*>(buff)};
-    delete [] buff;
+    std::string tmp(l, '\0');
+    if ( l > 0 ) {
+      raw_read(reinterpret_cast<std::uint8_t*>(tmp.data()), l);
+    }
     return tmp == signature;
   }
 
@@ -176,13 +182,20 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief read_XXX() の下請け関数
+  ///
+  /// 細かい読み出しが多いので istream::read() の sentry を作らずに
+  /// ストリームバッファから直接読み出す．
+  /// 足りない場合は eofbit|failbit を立てて例外を送出する．
   void
   raw_read(
     std::uint8_t* buff, ///< [in] 読み出した値を格納する領域のアドレス
     SizeType n     ///< [in] 読み出すバイト数
   )
   {
-    mS.read(reinterpret_cast<char*>(buff), n);
+    auto m = mS.rdbuf()->sgetn(reinterpret_cast<char*>(buff), n);
+    if ( static_cast<SizeType>(m) != n ) {
+      mS.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    }
   }
 
 
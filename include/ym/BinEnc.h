@@ -18,6 +18,11 @@ BEGIN_NAMESPACE_YM
 /// @brief バイナリエンコーダー
 ///
 /// ostream (の派生クラス)に対するフィルタとして働く．
+///
+/// 細かい書き込みが多いので ostream::write() を用いずに
+/// ストリームバッファに直接書き込む．
+/// そのため sentry による tie() のフラッシュは行われない．
+/// 書き込みに失敗した場合は badbit を立てるので例外が送出される．
 /// @sa BinDec
 //////////////////////////////////////////////////////////////////////
 class BinEnc
@@ -48,7 +53,11 @@ public:
     std::uint8_t val ///< [in] 値
   )
   {
-    raw_write(&val, sizeof(std::uint8_t));
+    auto c = mS.rdbuf()->sputc(static_cast<char>(val));
+    if ( c == std::char_traits<char>::eof() ) {
+      // 例外を送出する．
+      mS.setstate(std::ios_base::badbit);
+    }
   }
 
   /// @brief 2バイトの書き込み
@@ -142,13 +151,20 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief write_XXX() の下請け関数
+  ///
+  /// 細かい書き込みが多いので ostream::write() の sentry を作らずに
+  /// ストリームバッファに直接書き込む．
+  /// 書き込めなかった場合は badbit を立てて例外を送出する．
   void
   raw_write(
     const std::uint8_t* buff, ///< [in] データを収めた領域のアドレス
     SizeType n           ///< [in] データサイズ
   )
   {
-    mS.write(reinterpret_cast<const char*>(buff), n);
+    auto m = mS.rdbuf()->sputn(reinterpret_cast<const char*>(buff), n);
+    if ( static_cast<SizeType>(m) != n ) {
+      mS.setstate(std::ios_base::badbit);
+    }
   }
 
 
@@ -0,0 +1,116 @@
+#ifndef YM_DECOMPISTREAM_H
+#define YM_DECOMPISTREAM_H
+
+/// @file ym/DecompIStream.h
+/// @brief DecompIStream のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym_config.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM
+
+class DecompStreamBuf;
+
+//////////////////////////////////////////////////////////////////////
+/// @class DecompIStream DecompIStream.h "ym/DecompIStream.h"
+/// @ingroup ym
+/// @brief 圧縮された入力を展開しながら読み出す istream
+///
+/// 入力の先頭のマジックナンバーで圧縮形式を判定して，
+/// gzip または zstd 形式の場合は展開しながら読み出す．
+/// それ以外の場合は入力をそのまま読み出す．
+/// 展開は読み出しに合わせて少しずつ行うので，
+/// 展開後の内容全体をメモリ上に保持することはない．
+///
+/// gzip 形式の展開には zlib を，zstd 形式の展開には libzstd を用いる．
+/// ビルド時にライブラリが見つからなかった形式の入力の場合には
+/// コンストラクタで std::invalid_argument 例外を送出する．
+/// 圧縮データが壊れていた場合も読み出し中に
+/// std::invalid_argument 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class DecompIStream :
+  public std::istream
+{
+public:
+
+  /// @brief 圧縮形式
+  enum class Format {
+    Plain, ///< 圧縮されていない
+    Gzip,  ///< gzip 形式
+    Zstd   ///< zstd 形式
+  };
+
+  /// @brief 入力ストリームを指定したコンストラクタ
+  ///
+  /// s はこのオブジェクトが存在する間有効でなければならない．
+  explicit
+  DecompIStream(
+    std::istream& s ///< [in] 入力元のストリーム
+  );
+
+  /// @brief ファイル名を指定したコンストラクタ
+  ///
+  /// ファイルが開けなかった場合には std::invalid_argument 例外を送出する．
+  explicit
+  DecompIStream(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ~DecompIStream();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力の圧縮形式を返す．
+  Format
+  format() const;
+
+  /// @brief 先頭の内容から圧縮形式を判定する．
+  static
+  Format
+  detect(
+    std::string_view head ///< [in] 入力の先頭部分
+  );
+
+  /// @brief 指定された圧縮形式を展開できる時 true を返す．
+  static
+  bool
+  is_supported(
+    Format format ///< [in] 圧縮形式
+  );
+
+  /// @brief メモリ上の圧縮データをまとめて展開する．
+  ///
+  /// 圧縮されていない場合はそのままコピーしたものを返す．
+  static
+  std::string
+  decompress(
+    std::string_view data ///< [in] 圧縮データ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル名を指定した場合の入力元
+  std::unique_ptr<std::ifstream> mFile;
+
+  // 展開を行うバッファ
+  std::unique_ptr<DecompStreamBuf> mBuf;
+
+};
+
+END_NAMESPACE_YM
+
+#endif // YM_DECOMPISTREAM_H
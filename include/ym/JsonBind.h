@@ -0,0 +1,603 @@
+#ifndef JSONBIND_H
+#define JSONBIND_H
+
+/// @file JsonBind.h
+/// @brief JsonBind のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonReader.h"
+#include "ym/JsonWriter.h"
+#include "ym/JsonValue.h"
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+/// @brief 構造体のメンバとオブジェクトのキーの対応
+template<class T, class M>
+struct JsonField
+{
+  /// @brief キー
+  const char* key;
+
+  /// @brief メンバへのポインタ
+  M T::* member;
+};
+
+/// @brief JsonField を作る．
+template<class T, class M>
+constexpr
+JsonField<T, M>
+json_field(
+  const char* key, ///< [in] キー
+  M T::* member    ///< [in] メンバへのポインタ
+)
+{
+  return JsonField<T, M>{key, member};
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonFields JsonBind.h "ym/JsonBind.h"
+/// @brief 構造体とオブジェクトの対応を定義するクラス
+///
+/// 構造体ごとに特殊化して json_field() のタプル list を定義する．
+/// @code
+/// template<>
+/// struct JsonFields<MyRecord>
+/// {
+///   static constexpr auto list = std::make_tuple(
+///     json_field("name", &MyRecord::name),
+///     json_field("value", &MyRecord::value)
+///   );
+/// };
+/// @endcode
+//////////////////////////////////////////////////////////////////////
+template<class T>
+struct JsonFields;
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonBind JsonBind.h "ym/JsonBind.h"
+/// @brief T 型の値を JSON として読み書きするクラス
+///
+/// read() は JsonReader のイベントから直接値を読み込み，
+/// write() は JsonWriter に直接出力するので，
+/// どちらも JsonValue(JsonObj) を作らない．
+///
+/// 以下の型に対して定義されている．
+/// - bool, 整数型, 浮動小数点型, std::string
+/// - std::vector<T>, std::optional<T>, std::unordered_map<std::string, T>
+/// - JsonFields<T> が定義された構造体
+/// - JsonValue
+/// 他の型は JsonBind を特殊化して read() と write() を定義すればよい．
+///
+/// 型が合わない場合は JsonReader::error() で位置情報付きの
+/// std::invalid_argument 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+template<class T, class Enable = void>
+struct JsonBind;
+
+/// @brief JsonReader から T 型の値を一つ読み込む．
+template<class T>
+void
+read_json(
+  JsonReader& reader, ///< [in] 読み込み元
+  T& value            ///< [out] 結果を格納する変数
+)
+{
+  auto ev = reader.next();
+  if ( ev == JsonEvent::End ) {
+    reader.error("unexpected end of input");
+  }
+  JsonBind<T>::read(reader, ev, value);
+}
+
+/// @brief JSON 文字列から T 型の値を読み込む．
+/// @return 結果の値を返す．
+template<class T>
+T
+parse_json(
+  std::string_view json_str ///< [in] JSON文字列
+)
+{
+  JsonReader reader{json_str};
+  T value{};
+  read_json(reader, value);
+  if ( reader.next() != JsonEvent::End ) {
+    reader.error("extra data after the value");
+  }
+  return value;
+}
+
+/// @brief T 型の値を JsonWriter に出力する．
+template<class T>
+void
+write_json(
+  JsonWriter& writer, ///< [in] 出力先
+  const T& value      ///< [in] 値
+)
+{
+  JsonBind<T>::write(writer, value);
+}
+
+/// @brief T 型の値を JSON 文字列に変換する．
+template<class T>
+std::string
+to_json(
+  const T& value,     ///< [in] 値
+  bool indent = false ///< [in] インデントフラグ
+)
+{
+  std::string buff;
+  {
+    JsonWriter writer{buff, indent};
+    write_json(writer, value);
+  }
+  return buff;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// JsonBind の特殊化
+//////////////////////////////////////////////////////////////////////
+
+/// @brief bool 用の JsonBind
+template<>
+struct JsonBind<bool>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    bool& value
+  )
+  {
+    if ( ev != JsonEvent::Bool ) {
+      reader.error("bool value is expected");
+    }
+    value = reader.bool_value();
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    bool value
+  )
+  {
+    writer.write_bool(value);
+  }
+};
+
+/// @brief 整数型用の JsonBind
+///
+/// 範囲外の値はエラーとなる．
+template<class T>
+struct JsonBind<T, std::enable_if_t<std::is_integral_v<T> &&
+				    !std::is_same_v<T, bool>>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    T& value
+  )
+  {
+    if ( ev != JsonEvent::Int ) {
+      reader.error("integer value is expected");
+    }
+    auto v = reader.int_value();
+    bool ok;
+    if constexpr ( std::is_signed_v<T> ) {
+      ok = std::numeric_limits<T>::min() <= v &&
+	v <= std::numeric_limits<T>::max();
+    }
+    else {
+      ok = 0 <= v &&
+	static_cast<std::uint64_t>(v) <= std::numeric_limits<T>::max();
+    }
+    if ( !ok ) {
+      reader.error("integer value is out of range");
+    }
+    value = static_cast<T>(v);
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    T value
+  )
+  {
+    if constexpr ( std::is_unsigned_v<T> && sizeof(T) >= sizeof(std::int64_t) ) {
+      if ( value > static_cast<T>(std::numeric_limits<std::int64_t>::max()) ) {
+	throw std::invalid_argument{"integer value is out of range"};
+      }
+    }
+    writer.write_int(static_cast<std::int64_t>(value));
+  }
+};
+
+/// @brief 浮動小数点型用の JsonBind
+///
+/// 整数値も受け付ける．
+/// 無限大と NaN は書き出せない(JsonWriter::write_float() を参照)．
+template<class T>
+struct JsonBind<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    T& value
+  )
+  {
+    if ( ev == JsonEvent::Float ) {
+      value = static_cast<T>(reader.float_value());
+    }
+    else if ( ev == JsonEvent::Int ) {
+      value = static_cast<T>(reader.int_value());
+    }
+    else {
+      reader.error("number is expected");
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    T value
+  )
+  {
+    writer.write_float(value);
+  }
+};
+
+/// @brief std::string 用の JsonBind
+template<>
+struct JsonBind<std::string>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    std::string& value
+  )
+  {
+    if ( ev != JsonEvent::String ) {
+      reader.error("string is expected");
+    }
+    value.assign(reader.string_value());
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const std::string& value
+  )
+  {
+    writer.write_string(value);
+  }
+};
+
+/// @brief std::vector 用の JsonBind
+///
+/// JSON の配列に対応する．
+template<class T>
+struct JsonBind<std::vector<T>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    std::vector<T>& value
+  )
+  {
+    if ( ev != JsonEvent::StartArray ) {
+      reader.error("array is expected");
+    }
+    value.clear();
+    for ( ; ; ) {
+      auto ev1 = reader.next();
+      if ( ev1 == JsonEvent::EndArray ) {
+	break;
+      }
+      value.emplace_back();
+      JsonBind<T>::read(reader, ev1, value.back());
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const std::vector<T>& value
+  )
+  {
+    writer.array_begin();
+    for ( auto& elem: value ) {
+      JsonBind<T>::write(writer, elem);
+    }
+    writer.array_end();
+  }
+};
+
+/// @brief std::optional 用の JsonBind
+///
+/// null と値を持たない状態が対応する．
+template<class T>
+struct JsonBind<std::optional<T>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    std::optional<T>& value
+  )
+  {
+    if ( ev == JsonEvent::Null ) {
+      value.reset();
+    }
+    else {
+      JsonBind<T>::read(reader, ev, value.emplace());
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const std::optional<T>& value
+  )
+  {
+    if ( value ) {
+      JsonBind<T>::write(writer, *value);
+    }
+    else {
+      writer.write_null();
+    }
+  }
+};
+
+/// @brief std::unordered_map 用の JsonBind
+///
+/// 任意のキーを持つ JSON のオブジェクトに対応する．
+template<class T>
+struct JsonBind<std::unordered_map<std::string, T>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    std::unordered_map<std::string, T>& value
+  )
+  {
+    if ( ev != JsonEvent::StartObject ) {
+      reader.error("object is expected");
+    }
+    value.clear();
+    for ( ; ; ) {
+      auto ev1 = reader.next();
+      if ( ev1 == JsonEvent::EndObject ) {
+	break;
+      }
+      auto& elem = value[std::string{reader.key()}];
+      JsonBind<T>::read(reader, reader.next(), elem);
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const std::unordered_map<std::string, T>& value
+  )
+  {
+    writer.object_begin();
+    for ( auto& p: value ) {
+      writer.write_key(p.first);
+      JsonBind<T>::write(writer, p.second);
+    }
+    writer.object_end();
+  }
+};
+
+/// @brief JsonFields が定義された構造体用の JsonBind
+///
+/// JsonFields<T>::list にないキーは読み飛ばす．
+/// 入力にないキーに対応するメンバは変更しない．
+/// 出力は list の順に行う．
+template<class T>
+struct JsonBind<T, std::void_t<decltype(JsonFields<T>::list)>>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    T& value
+  )
+  {
+    if ( ev != JsonEvent::StartObject ) {
+      reader.error("object is expected");
+    }
+    constexpr auto n = std::tuple_size_v<std::decay_t<decltype(JsonFields<T>::list)>>;
+    for ( ; ; ) {
+      auto ev1 = reader.next();
+      if ( ev1 == JsonEvent::EndObject ) {
+	break;
+      }
+      auto key = reader.key();
+      auto ev2 = reader.next();
+      if ( !read_fields(reader, key, ev2, value, std::make_index_sequence<n>{}) ) {
+	reader.skip();
+      }
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const T& value
+  )
+  {
+    writer.object_begin();
+    std::apply([&](const auto&... field) {
+      ( write_field(writer, value, field), ... );
+    }, JsonFields<T>::list);
+    writer.object_end();
+  }
+
+
+private:
+
+  // key に対応するメンバを読み込む．
+  // 対応するメンバがない場合は false を返す．
+  template<std::size_t... I>
+  static
+  bool
+  read_fields(
+    JsonReader& reader,
+    std::string_view key,
+    JsonEvent ev,
+    T& value,
+    std::index_sequence<I...>
+  )
+  {
+    return ( read_field(reader, key, ev, value,
+			std::get<I>(JsonFields<T>::list)) || ... );
+  }
+
+  // field のキーが key の時にメンバを読み込んで true を返す．
+  template<class M>
+  static
+  bool
+  read_field(
+    JsonReader& reader,
+    std::string_view key,
+    JsonEvent ev,
+    T& value,
+    const JsonField<T, M>& field
+  )
+  {
+    if ( key != field.key ) {
+      return false;
+    }
+    JsonBind<M>::read(reader, ev, value.*(field.member));
+    return true;
+  }
+
+  // メンバを出力する．
+  template<class M>
+  static
+  void
+  write_field(
+    JsonWriter& writer,
+    const T& value,
+    const JsonField<T, M>& field
+  )
+  {
+    writer.write_key(field.key);
+    JsonBind<M>::write(writer, value.*(field.member));
+  }
+
+};
+
+/// @brief JsonValue 用の JsonBind
+///
+/// 構造の決まっていない部分を保持するのに用いる．
+template<>
+struct JsonBind<JsonValue>
+{
+  static
+  void
+  read(
+    JsonReader& reader,
+    JsonEvent ev,
+    JsonValue& value
+  )
+  {
+    switch ( ev ) {
+    case JsonEvent::Null:
+      value = JsonValue::null();
+      break;
+
+    case JsonEvent::Bool:
+      value = JsonValue{reader.bool_value()};
+      break;
+
+    case JsonEvent::Int:
+      value = JsonValue{reader.int_value()};
+      break;
+
+    case JsonEvent::Float:
+      value = JsonValue{reader.float_value()};
+      break;
+
+    case JsonEvent::String:
+      value = JsonValue{std::string{reader.string_value()}};
+      break;
+
+    case JsonEvent::StartArray:
+      {
+	std::vector<JsonValue> array;
+	JsonBind<std::vector<JsonValue>>::read(reader, ev, array);
+	value = JsonValue{std::move(array)};
+      }
+      break;
+
+    case JsonEvent::StartObject:
+      {
+	// 入力中の順番を保つためにキーと値の対のリストで読み込む．
+	std::vector<std::pair<std::string, JsonValue>> item_list;
+	for ( ; ; ) {
+	  auto ev1 = reader.next();
+	  if ( ev1 == JsonEvent::EndObject ) {
+	    break;
+	  }
+	  item_list.emplace_back(std::string{reader.key()}, JsonValue{});
+	  read(reader, reader.next(), item_list.back().second);
+	}
+	value = JsonValue{std::move(item_list)};
+      }
+      break;
+
+    default:
+      reader.error("value is expected");
+    }
+  }
+
+  static
+  void
+  write(
+    JsonWriter& writer,
+    const JsonValue& value
+  )
+  {
+    writer.write_value(value);
+  }
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONBIND_H
@@ -0,0 +1,123 @@
+#ifndef JSONDEDUP_H
+#define JSONDEDUP_H
+
+/// @file JsonDedup.h
+/// @brief JsonDedup のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+class JsonObj;
+class JsonDocument;
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonDedup JsonDedup.h "ym/JsonDedup.h"
+/// @brief 同じ内容の部分木を共有する JsonValue を作るクラス
+///
+/// add() で渡された値と等しい値をこのオブジェクトが持つ
+/// 一つのアリーナ(JsonDocument)上に作る．
+/// その際に既に作られたものと同じ内容の文字列，配列，オブジェクトは
+/// 新たに作らずに共有する．
+/// ほとんど同じ内容の値を数多く保持する場合にメモリが節約でき，
+/// 共有された部分木どうしの比較はポインタの比較で済む．
+///
+/// オブジェクトの要素は元の値の順番を保つので，
+/// 要素の順番のみが異なるオブジェクトは共有されない．
+/// 作られた値はアリーナを参照するので，このオブジェクトを破棄しても
+/// 値が一つでも残っている限りアリーナの領域は解放されない．
+///
+/// 複数のスレッドから同時に add() を呼んではならない．
+//////////////////////////////////////////////////////////////////////
+class JsonDedup
+{
+public:
+
+  /// @brief コンストラクタ
+  JsonDedup();
+
+  /// @brief コピーコンストラクタは禁止
+  JsonDedup(
+    const JsonDedup& src
+  ) = delete;
+
+  /// @brief コピー代入演算子は禁止
+  JsonDedup&
+  operator=(
+    const JsonDedup& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~JsonDedup();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値を登録する．
+  /// @return value と等しく，部分木を共有する値を返す．
+  JsonValue
+  add(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief 作られたノード数を返す．
+  ///
+  /// 文字列，配列，オブジェクトの数の合計
+  SizeType
+  node_num() const
+  {
+    return mTable.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値をアリーナ上にコピーする．
+  /// @return 所有権を持たない値を返す．
+  JsonValue
+  copy(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief 二つの子供が同一かどうか調べる．
+  ///
+  /// ノードはポインタで比較する．
+  static
+  bool
+  is_same(
+    const JsonValue& left, ///< [in] オペランド1
+    const JsonValue& right ///< [in] オペランド2
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードを作るドキュメント
+  //
+  // このオブジェクトが参照回数を一つ持つ．
+  JsonDocument* mDoc;
+
+  // ハッシュ値をキーにして作られたノードを保持する表
+  std::unordered_multimap<SizeType, JsonObj*> mTable;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONDEDUP_H
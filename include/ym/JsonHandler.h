@@ -0,0 +1,123 @@
+#ifndef JSONHANDLER_H
+#define JSONHANDLER_H
+
+/// @file JsonHandler.h
+/// @brief JsonHandler のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonHandler JsonHandler.h "ym/JsonHandler.h"
+/// @brief JsonReader::parse() から呼ばれるイベントハンドラの基底クラス
+///
+/// 必要なイベントの関数のみをオーバーライドすればよい．
+/// デフォルトの実装は何もしない．
+/// 文字列の引数の内容は関数から戻るまでの間のみ有効
+//////////////////////////////////////////////////////////////////////
+class JsonHandler
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~JsonHandler() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief オブジェクトの開始
+  virtual
+  void
+  on_start_object()
+  {
+  }
+
+  /// @brief オブジェクトの終了
+  virtual
+  void
+  on_end_object()
+  {
+  }
+
+  /// @brief 配列の開始
+  virtual
+  void
+  on_start_array()
+  {
+  }
+
+  /// @brief 配列の終了
+  virtual
+  void
+  on_end_array()
+  {
+  }
+
+  /// @brief オブジェクトのキー
+  virtual
+  void
+  on_key(
+    std::string_view /*key*/ ///< [in] キー
+  )
+  {
+  }
+
+  /// @brief null
+  virtual
+  void
+  on_null()
+  {
+  }
+
+  /// @brief ブール値
+  virtual
+  void
+  on_bool(
+    bool /*value*/ ///< [in] 値
+  )
+  {
+  }
+
+  /// @brief 整数値
+  virtual
+  void
+  on_int(
+    std::int64_t /*value*/ ///< [in] 値
+  )
+  {
+  }
+
+  /// @brief 浮動小数点値
+  virtual
+  void
+  on_float(
+    double /*value*/ ///< [in] 値
+  )
+  {
+  }
+
+  /// @brief 文字列
+  virtual
+  void
+  on_string(
+    std::string_view /*value*/ ///< [in] 値
+  )
+  {
+  }
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONHANDLER_H
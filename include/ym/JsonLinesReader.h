@@ -0,0 +1,142 @@
+#ifndef JSONLINESREADER_H
+#define JSONLINESREADER_H
+
+/// @file JsonLinesReader.h
+/// @brief JsonLinesReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include <functional>
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+class MappedFile;
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonLinesReader JsonLinesReader.h "ym/JsonLinesReader.h"
+/// @brief JSON Lines (NDJSON) 形式の入力を読み込むクラス
+///
+/// 1行に一つの JSON の値が書かれた入力を読み込む．
+/// 空白のみの行は読み飛ばす．
+///
+/// 入力を改行の位置で一定の大きさのブロックに分割して，
+/// 複数のスレッドで並列に読み込む．
+/// 同じブロックの行の値は一つのアリーナ(JsonDocument)を共有するので，
+/// 一つでも値が残っている限りブロック全体の領域は解放されない．
+///
+/// 文法エラーの場合には入力全体での行番号を含む位置情報付きの
+/// メッセージを持つ std::invalid_argument 例外を送出する．
+/// 複数の行にエラーがある場合は最初の行のものとなる．
+//////////////////////////////////////////////////////////////////////
+class JsonLinesReader
+{
+public:
+
+  /// @brief 値を受け取る関数の型
+  ///
+  /// 引数は行番号(1から始まる)と値
+  using Callback = std::function<void(SizeType, const JsonValue&)>;
+
+  /// @brief 入力バッファを指定したコンストラクタ
+  ///
+  /// buff の内容はこのオブジェクトが存在する間は有効でなければならない．
+  explicit
+  JsonLinesReader(
+    std::string_view buff,  ///< [in] 入力バッファ
+    SizeType thread_num = 0 ///< [in] スレッド数
+                            ///<      0 の時はハードウェアのスレッド数
+  );
+
+  /// @brief ムーブコンストラクタ
+  JsonLinesReader(
+    JsonLinesReader&& src ///< [in] ムーブ元
+  );
+
+  /// @brief デストラクタ
+  ~JsonLinesReader();
+
+  /// @brief ファイルを読み込むオブジェクトを作る．
+  ///
+  /// ファイルが開けなかった場合には std::invalid_argument 例外を送出する．
+  /// gzip または zstd で圧縮されたファイルは展開した内容を保持する．
+  static
+  JsonLinesReader
+  open(
+    const std::string& filename, ///< [in] ファイル名
+    SizeType thread_num = 0      ///< [in] スレッド数
+                                 ///<      0 の時はハードウェアのスレッド数
+  );
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mThreadNum;
+  }
+
+  /// @brief 全ての値を入力順に読み込む．
+  std::vector<JsonValue>
+  read_all();
+
+  /// @brief 値を読み込むごとに callback を呼び出す．
+  ///
+  /// ordered が true の時は callback を呼び出し元のスレッドから
+  /// 入力順に呼び出す．
+  /// 読み込みはその間も先のブロックに進む．
+  ///
+  /// ordered が false の時は callback を各スレッドから読み込んだ順に
+  /// 呼び出す．この場合 callback は複数のスレッドから同時に
+  /// 呼び出されるので，callback 側で排他制御を行う必要がある．
+  ///
+  /// エラーがあった場合はそれより前の行の値を渡した後で例外を送出する．
+  /// ただし ordered が false の場合は後ろの行の値も渡されることがある．
+  void
+  read(
+    const Callback& callback, ///< [in] 値を受け取る関数
+    bool ordered = true       ///< [in] 入力順に呼び出す時 true
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを指定したコンストラクタ
+  JsonLinesReader(
+    std::unique_ptr<MappedFile>&& file, ///< [in] マップしたファイル
+    SizeType thread_num                 ///< [in] スレッド数
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイルを指定した場合の内容
+  std::unique_ptr<MappedFile> mFile;
+
+  // 入力
+  std::string_view mBuff;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONLINESREADER_H
@@ -0,0 +1,143 @@
+#ifndef JSONPOINTER_H
+#define JSONPOINTER_H
+
+/// @file JsonPointer.h
+/// @brief JsonPointer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonPointer JsonPointer.h "ym/JsonPointer.h"
+/// @brief JSON Pointer (RFC 6901) を表すクラス
+///
+/// "/cells/17/pins" のような経路をコンストラクタで解析しておき，
+/// 何度でも用いることができる．
+/// '~0' と '~1' はそれぞれ '~' と '/' を表す．
+///
+/// parse() と read() は入力を直接走査して，経路上にない値は
+/// 中身を解釈せずに読み飛ばす．
+/// 値を作るのは経路の指す値のみとなる．
+//////////////////////////////////////////////////////////////////////
+class JsonPointer
+{
+public:
+
+  /// @brief 配列の位置を表さない参照トークンの index() の値
+  static const SizeType NOT_INDEX = static_cast<SizeType>(-1);
+
+  /// @brief コンストラクタ
+  ///
+  /// 空文字列は全体を表す．
+  /// 空文字列以外で '/' で始まっていない場合と
+  /// '~' の後が '0' か '1' でない場合には
+  /// std::invalid_argument 例外を送出する．
+  explicit
+  JsonPointer(
+    std::string_view path = {} ///< [in] 経路を表す文字列
+  );
+
+  /// @brief デストラクタ
+  ~JsonPointer() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 経路を表す文字列を返す．
+  const std::string&
+  str() const
+  {
+    return mPath;
+  }
+
+  /// @brief 参照トークン数を返す．
+  SizeType
+  size() const
+  {
+    return mKeyList.size();
+  }
+
+  /// @brief 参照トークンを返す．
+  ///
+  /// エスケープは元に戻したものを返す．
+  const std::string&
+  key(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    return mKeyList.at(pos);
+  }
+
+  /// @brief 参照トークンを配列の位置として解釈した値を返す．
+  ///
+  /// 先頭に余分な '0' を持たない10進数でない場合は NOT_INDEX を返す．
+  SizeType
+  index(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    return mIndexList.at(pos);
+  }
+
+  /// @brief 値の中から経路の指す値を取り出す．
+  /// @return 経路の指す値が存在しない場合は null を返す．
+  ///
+  /// 遅延モードで読み込んだ値の場合は経路上の部分だけが読み込まれる．
+  JsonValue
+  get(
+    const JsonValue& value ///< [in] 根の値
+  ) const;
+
+  /// @brief JSON文字列から経路の指す値を取り出す．
+  /// @return 経路の指す値が存在しない場合は null を返す．
+  ///
+  /// 経路の指す値の後ろの部分は読まない．
+  /// 読んだ部分に文法エラーがあった場合は
+  /// std::invalid_argument 例外を送出する．
+  JsonValue
+  parse(
+    std::string_view json_str ///< [in] JSON文字列
+  ) const;
+
+  /// @brief ファイルから経路の指す値を取り出す．
+  /// @return 経路の指す値が存在しない場合は null を返す．
+  ///
+  /// ファイルはメモリ上にマップして直接走査する．
+  /// 圧縮されたファイルは展開してから走査する．
+  /// それ以外は parse() と同様
+  JsonValue
+  read(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 経路を表す文字列
+  std::string mPath;
+
+  // 参照トークンのリスト
+  std::vector<std::string> mKeyList;
+
+  // 参照トークンを配列の位置として解釈した値のリスト
+  std::vector<SizeType> mIndexList;
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONPOINTER_H
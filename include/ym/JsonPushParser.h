@@ -0,0 +1,201 @@
+#ifndef JSONPUSHPARSER_H
+#define JSONPUSHPARSER_H
+
+/// @file JsonPushParser.h
+/// @brief JsonPushParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+#include <functional>
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonPushParser JsonPushParser.h "ym/JsonPushParser.h"
+/// @brief 任意の大きさに分割された入力を順に受け取って読み込むクラス
+///
+/// feed() で渡された入力を走査して，トップレベルの値が完結するたびに
+/// その値を読み込んで callback に渡す．
+/// トップレベルの値は空白や改行で区切られて複数並んでいてもよいので，
+/// JSON Lines (NDJSON) 形式の入力も読み込むことができる．
+///
+/// 値の区切りを探す走査の状態は feed() の呼び出しをまたいで保持され，
+/// 同じ部分を二度走査することはない．
+/// 内部のバッファには読み込み途中の値の分だけを保持する．
+///
+/// 括弧で閉じられない数値などのトップレベルの値は後ろに区切りの文字が
+/// 来るか，finish() が呼ばれるまで完結しない．
+///
+/// 文法エラーの場合には入力全体での位置情報付きのメッセージを持つ
+/// std::invalid_argument 例外を送出する．
+/// エラーとなった値は読み捨てられるので，続けて feed() を呼ぶと
+/// 次の値から読み込みを再開する．
+//////////////////////////////////////////////////////////////////////
+class JsonPushParser
+{
+public:
+
+  /// @brief 値を受け取る関数の型
+  ///
+  /// 引数は値の先頭の行番号(1から始まる)と値
+  using Callback = std::function<void(SizeType, const JsonValue&)>;
+
+  /// @brief コンストラクタ
+  explicit
+  JsonPushParser(
+    const Callback& callback ///< [in] 値を受け取る関数
+  );
+
+  /// @brief デストラクタ
+  ~JsonPushParser();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力を追加する．
+  ///
+  /// 完結した値があればこの中で callback を呼び出す．
+  void
+  feed(
+    const char* data, ///< [in] 入力の先頭
+    SizeType size     ///< [in] 入力のサイズ
+  );
+
+  /// @brief 入力を追加する．
+  void
+  feed(
+    std::string_view data ///< [in] 入力
+  )
+  {
+    feed(data.data(), data.size());
+  }
+
+  /// @brief 入力の終わりを知らせる．
+  ///
+  /// 残っている値を読み込んで callback を呼び出す．
+  /// 値が完結していない場合には std::invalid_argument 例外を送出する．
+  /// 呼び出し後は新しい入力を受け付ける初期状態に戻る．
+  /// ただし例外が送出された場合は再度 finish() を呼ぶと
+  /// エラーとなった値の次から読み込みを続ける．
+  void
+  finish();
+
+  /// @brief 内部のバッファに保持している入力のサイズを返す．
+  SizeType
+  buffered_size() const
+  {
+    return mBuff.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 走査の状態
+  enum class State {
+    Blank,        ///< 値の間
+    Scalar,       ///< トップレベルの数値などの中
+    Container,    ///< 配列かオブジェクトの中
+    String,       ///< 文字列の中
+    LineComment,  ///< 行末までのコメントの中
+    BlockComment, ///< '/*' から '*/' までのコメントの中
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バッファを走査して完結した値を読み込む．
+  void
+  scan(
+    bool last ///< [in] 入力の終わりの時 true
+  );
+
+  /// @brief 値の始まりを記録する．
+  void
+  start_value(
+    SizeType pos,     ///< [in] 値の先頭の位置
+    State state       ///< [in] 次の状態
+  );
+
+  /// @brief 完結した値を読み込んで callback を呼び出す．
+  void
+  emit_value(
+    SizeType end ///< [in] 値の末尾の位置
+  );
+
+  /// @brief 行番号を pos の位置まで進める．
+  void
+  count_lines(
+    SizeType pos ///< [in] 位置
+  );
+
+  /// @brief 走査済みの部分をバッファから取り除く．
+  void
+  discard();
+
+  /// @brief 初期状態に戻す．
+  void
+  reset();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 値を受け取る関数
+  Callback mCallback;
+
+  // 入力のバッファ
+  std::string mBuff;
+
+  // バッファの先頭の入力全体でのオフセット
+  SizeType mBase{0};
+
+  // 次に走査する位置
+  SizeType mPos{0};
+
+  // 読み込み途中の値の先頭の位置
+  // 値の間では std::string::npos となる．
+  SizeType mStart{std::string::npos};
+
+  // 走査の状態
+  State mState{State::Blank};
+
+  // コメントを抜けた後の状態
+  State mCommentReturn{State::Blank};
+
+  // 括弧の深さ
+  SizeType mDepth{0};
+
+  // 文字列の終端文字
+  char mQuote{'"'};
+
+  // 行番号を数え終わった位置
+  SizeType mLinePos{0};
+
+  // mLinePos の位置の行番号
+  SizeType mLine{1};
+
+  // mLinePos の位置の行の先頭の入力全体でのオフセット
+  SizeType mTop{0};
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONPUSHPARSER_H
@@ -0,0 +1,220 @@
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+/// @file JsonReader.h
+/// @brief JsonReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+class JsonHandler;
+class JsonScanner;
+enum class JsonToken;
+
+/// @brief JsonReader::next() の返すイベント
+enum class JsonEvent {
+  StartObject, ///< オブジェクトの開始
+  EndObject,   ///< オブジェクトの終了
+  StartArray,  ///< 配列の開始
+  EndArray,    ///< 配列の終了
+  Key,         ///< オブジェクトのキー
+  Null,        ///< null
+  Bool,        ///< ブール値
+  Int,         ///< 整数値
+  Float,       ///< 浮動小数点値
+  String,      ///< 文字列
+  End          ///< 入力の終わり
+};
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonReader JsonReader.h "ym/JsonReader.h"
+/// @brief JSON をイベント列として読み込むクラス
+///
+/// next() で一つずつイベントを取り出すプル型の使い方と，
+/// parse() で JsonHandler の関数を呼び出すプッシュ(SAX)型の
+/// 使い方ができる．
+///
+/// JsonValue(JsonObj) を作らないので，使用するメモリ量は
+/// 入れ子の深さにのみ比例する．
+/// 文法エラーの場合には JsonValue::parse() と同じ位置情報付きの
+/// メッセージを持つ std::invalid_argument 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class JsonReader
+{
+public:
+
+  /// @brief 入力ストリームを指定したコンストラクタ
+  ///
+  /// 入力は一定サイズずつ読み込まれる．
+  JsonReader(
+    std::istream& s ///< [in] 入力ストリーム
+  );
+
+  /// @brief 入力バッファを指定したコンストラクタ
+  ///
+  /// buff の内容はこのオブジェクトが存在する間は有効でなければならない．
+  JsonReader(
+    std::string_view buff ///< [in] 入力バッファ
+  );
+
+  /// @brief デストラクタ
+  ~JsonReader();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 次のイベントを読み出す．
+  ///
+  /// 入力の終わりに達した後は JsonEvent::End を返し続ける．
+  JsonEvent
+  next();
+
+  /// @brief 直前の StartObject/StartArray に対応する終わりまで読み飛ばす．
+  ///
+  /// それ以外のイベントの直後では何もしない．
+  void
+  skip();
+
+  /// @brief 全てのイベントを handler に送る．
+  void
+  parse(
+    JsonHandler& handler ///< [in] イベントハンドラ
+  );
+
+  /// @brief 現在の入れ子の深さを返す．
+  ///
+  /// トップレベルは 0
+  SizeType
+  depth() const
+  {
+    return mStack.size();
+  }
+
+  /// @brief 直前の Key イベントのキーを返す．
+  ///
+  /// 内容は次の Key イベントまでの間有効
+  std::string_view
+  key() const
+  {
+    return mKey;
+  }
+
+  /// @brief 直前の String イベントの文字列を返す．
+  ///
+  /// 内容は次の next() までの間有効
+  std::string_view
+  string_value() const;
+
+  /// @brief 直前の Int イベントの値を返す．
+  std::int64_t
+  int_value() const
+  {
+    return mInt;
+  }
+
+  /// @brief 直前の Float イベントの値を返す．
+  double
+  float_value() const
+  {
+    return mFloat;
+  }
+
+  /// @brief 直前の Bool イベントの値を返す．
+  bool
+  bool_value() const
+  {
+    return mBool;
+  }
+
+  /// @brief 現在の位置を付けたエラーを送出する．
+  ///
+  /// std::invalid_argument 例外を送出する．
+  /// 読み込んだ値の型が期待と異なる場合などに読み込む側から用いる．
+  [[noreturn]]
+  void
+  error(
+    const std::string& msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値の先頭のトークンからイベントを作る．
+  JsonEvent
+  value_event(
+    JsonToken tk ///< [in] トークン
+  );
+
+  /// @brief オブジェクトのキーを読み込む．
+  JsonEvent
+  read_key(
+    JsonToken tk ///< [in] 先頭のトークン
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 入れ子の中の状態
+  enum State : std::uint8_t {
+    ObjFirst, ///< '{' の直後
+    ObjKey,   ///< ',' の直後のキー
+    ObjValue, ///< キーの直後の値
+    ObjNext,  ///< 値の直後の ',' か '}'
+    ArrFirst, ///< '[' の直後
+    ArrNext   ///< 値の直後の ',' か ']'
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 字句解析器
+  std::unique_ptr<JsonScanner> mScanner;
+
+  // 入れ子の状態のスタック
+  std::vector<State> mStack;
+
+  // トップレベルの値を読み始めたら true
+  bool mStarted{false};
+
+  // 入力の終わりに達したら true
+  bool mDone{false};
+
+  // 直前のイベント
+  JsonEvent mLastEvent{JsonEvent::End};
+
+  // 直前のキー
+  std::string mKey;
+
+  // 直前の整数値
+  std::int64_t mInt{0};
+
+  // 直前の浮動小数点値
+  double mFloat{0.0};
+
+  // 直前のブール値
+  bool mBool{false};
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONREADER_H
@@ -9,11 +9,21 @@
 /// All rights reserved.
 
 #include "ym/json.h"
+#include "ym/BinEnc.h"
+#include "ym/BinDec.h"
+#include <string_view>
+#include <iterator>
+#include <limits>
+#include <type_traits>
 
 
 BEGIN_NAMESPACE_YM_JSON
 
 class JsonObj;
+template<class Conv> class JsonRange;
+struct JsonElemConv;
+struct JsonKeyConv;
+struct JsonItemConv;
 
 //////////////////////////////////////////////////////////////////////
 /// @class JsonValue JsonValue.h "ym/JsonValue.h"
@@ -22,27 +32,65 @@ class JsonObj;
 /// 以下のタイプを持つ．
 /// - null
 /// - 文字列 (string)
-/// - 整数 (int)
+/// - 整数 (64ビット整数)
 /// - 浮動小数点数 (double)
 /// - ブール (bool)
 /// - 配列 (vector<JsonValue>)
-/// - オブジェクト (unordered_map<string, JsonValue>)
+/// - オブジェクト (キーと値の対のリスト)
 ///
-/// 実装としては実体は JsonObj (の派生クラス) が表す．
-/// JsonValue は JsonObj の shared_ptr<> のみを持つ．
-/// JsonValue の公開メソッドはすべて const なので
-/// 共有していても問題はない．
+/// オブジェクトはキーと値の対を挿入順に連続した配列で保持する．
+/// 要素数が 16 以下の場合は線形探索を行い，
+/// それを超える場合は最初の探索時にハッシュ表の索引を作る．
+/// items() や key_list() などでたどる順番は挿入順
+/// (パーサーが生成したものは入力中の順番)となる．
+/// unordered_map から作った場合はキーの順に並べられる．
+/// 順番を指定する場合はキーと値の対の vector から作る．
+///
+/// 実装としては 16 バイトのタグ付きの値で，
+/// null, ブール，整数，浮動小数点数は値そのものを保持する．
+/// 文字列，配列，オブジェクトの実体は JsonObj (の派生クラス) が表し，
+/// JsonValue はその参照カウント付きのポインタを持つ．
+/// set() などの書き換えを行うメソッドは共有している実体を
+/// 複製してから書き換える(copy-on-write)ので，
+/// 他の JsonValue から見える内容は変わらない．
+///
+/// パーサーが生成した値は一つのアリーナ(JsonDocument)上に置かれ，
+/// その要素の JsonValue はアリーナ全体の所有権を共有する．
+/// 所有権の共有は参照回数の不可分操作を伴うので，
+/// 読み出しだけを繰り返す場合は JsonValueRef を用いる．
+///
+/// read() と parse() の遅延モードでは配列とオブジェクトの中身を
+/// 読み飛ばしておき，operator[] などで参照された時に
+/// 必要な所まで読み込む．
+/// 大きな入力から一部の値だけを取り出す場合に用いる．
+/// 特定の位置の値だけが必要な場合は JsonPointer も使える．
 //////////////////////////////////////////////////////////////////////
 class JsonValue
 {
   friend class JsonObj;
+  friend class JsonDocument;
+  friend class JsonWriter;
+  friend class JsonBinEncoder;
+  friend class JsonDedup;
+  friend class JsonValueRef;
+  friend struct JsonElemConv;
+  friend struct JsonItemConv;
 
 public:
 
+  /// @brief 配列の要素をたどる範囲
+  using ElemRange = JsonRange<JsonElemConv>;
+
+  /// @brief オブジェクトのキーをたどる範囲
+  using KeyRange = JsonRange<JsonKeyConv>;
+
+  /// @brief オブジェクトのキーと値の対をたどる範囲
+  using ItemRange = JsonRange<JsonItemConv>;
+
   /// @brief 空のコンストラクタ
   ///
   /// null 型の値となる．
-  JsonValue();
+  JsonValue() = default;
 
   /// @brief 明示的に null 型のオブジェクトを作るクラスメソッド
   static
@@ -65,22 +113,43 @@ public:
   );
 
   /// @brief 整数型のコンストラクタ
+  ///
+  /// bool 以外の任意の整数型を受け付ける．
+  /// 符号なしの値が std::int64_t の範囲を超える場合は
+  /// std::invalid_argument 例外を送出する．
+  template<typename T,
+	   std::enable_if_t<std::is_integral_v<T> &&
+			    !std::is_same_v<T, bool>, int> = 0>
   explicit
   JsonValue(
-    int value ///< [in] 値
-  );
+    T value ///< [in] 値
+  ) : mType{Type::Int}
+  {
+    if constexpr ( std::is_unsigned_v<T> && sizeof(T) >= sizeof(std::int64_t) ) {
+      if ( value > static_cast<T>(std::numeric_limits<std::int64_t>::max()) ) {
+	throw std::invalid_argument{"integer value is out of range"};
+      }
+    }
+    mBody.mInt = static_cast<std::int64_t>(value);
+  }
 
   /// @brief 浮動小数点型のコンストラクタ
   explicit
   JsonValue(
     double value ///< [in] 値
-  );
+  ) : mType{Type::Float}
+  {
+    mBody.mFloat = value;
+  }
 
   /// @brief ブール型のコンストラクタ
   explicit
   JsonValue(
     bool value ///< [in] 値
-  );
+  ) : mType{Type::Bool}
+  {
+    mBody.mBool = value;
+  }
 
   /// @brief 配列型のコンストラクタ
   explicit
@@ -88,19 +157,111 @@ public:
     const std::vector<JsonValue>& value ///< [in] 値
   );
 
+  /// @brief 配列型のコンストラクタ(ムーブ版)
+  explicit
+  JsonValue(
+    std::vector<JsonValue>&& value ///< [in] 値
+  );
+
   /// @brief オブジェクト型のコンストラクタ
   explicit
   JsonValue(
     const std::unordered_map<std::string, JsonValue>& value ///< [in] 値
   );
 
+  /// @brief オブジェクト型のコンストラクタ(ムーブ版)
+  explicit
+  JsonValue(
+    std::unordered_map<std::string, JsonValue>&& value ///< [in] 値
+  );
+
+  /// @brief オブジェクト型のコンストラクタ(挿入順版)
+  ///
+  /// 要素は item_list の順に並べられる．
+  /// 重複したキーは最初のものが残る．
+  explicit
+  JsonValue(
+    const std::vector<std::pair<std::string, JsonValue>>& item_list ///< [in] キーと値の対のリスト
+  );
+
+  /// @brief オブジェクト型のコンストラクタ(挿入順のムーブ版)
+  explicit
+  JsonValue(
+    std::vector<std::pair<std::string, JsonValue>>&& item_list ///< [in] キーと値の対のリスト
+  );
+
   /// @brief 値を指定したコンストラクタ
+  ///
+  /// value の所有権はこのオブジェクトに移る．
   JsonValue(
     JsonObj* value ///< [in] 値
   );
 
+  /// @brief コピーコンストラクタ
+  JsonValue(
+    const JsonValue& src ///< [in] コピー元のオブジェクト
+  ) : mBody{src.mBody},
+      mType{src.mType},
+      mBorrowed{src.mBorrowed}
+  {
+    if ( _is_owner() ) {
+      _inc_ref();
+    }
+  }
+
+  /// @brief ムーブコンストラクタ
+  JsonValue(
+    JsonValue&& src ///< [in] ムーブ元のオブジェクト
+  ) noexcept : mBody{src.mBody},
+	       mType{src.mType},
+	       mBorrowed{src.mBorrowed}
+  {
+    src.mType = Type::Null;
+  }
+
+  /// @brief コピー代入演算子
+  JsonValue&
+  operator=(
+    const JsonValue& src ///< [in] コピー元のオブジェクト
+  )
+  {
+    if ( src._is_owner() ) {
+      src._inc_ref();
+    }
+    if ( _is_owner() ) {
+      _dec_ref();
+    }
+    mBody = src.mBody;
+    mType = src.mType;
+    mBorrowed = src.mBorrowed;
+    return *this;
+  }
+
+  /// @brief ムーブ代入演算子
+  JsonValue&
+  operator=(
+    JsonValue&& src ///< [in] ムーブ元のオブジェクト
+  ) noexcept
+  {
+    if ( this != &src ) {
+      if ( _is_owner() ) {
+	_dec_ref();
+      }
+      mBody = src.mBody;
+      mType = src.mType;
+      mBorrowed = src.mBorrowed;
+      src.mType = Type::Null;
+    }
+    return *this;
+  }
+
   /// @brief デストラクタ
-  ~JsonValue();
+  ~JsonValue()
+  {
+    if ( _is_owner() ) {
+      _dec_ref();
+    }
+  }
 
 
 public:
@@ -110,37 +271,61 @@ public:
 
   /// @brief null 型の時 true を返す．
   bool
-  is_null() const;
+  is_null() const
+  {
+    return mType == Type::Null;
+  }
 
   /// @brief 文字列型の時 true を返す．
   bool
-  is_string() const;
+  is_string() const
+  {
+    return mType == Type::String;
+  }
 
   /// @brief 数値型の時 true を返す．
   ///
   /// is_int() か is_float() の時 true となる．
   bool
-  is_number() const;
+  is_number() const
+  {
+    return is_int() || is_float();
+  }
 
   /// @brief 整数型の時 true を返す．
   bool
-  is_int() const;
+  is_int() const
+  {
+    return mType == Type::Int;
+  }
 
   /// @brief 浮動小数点型の時 true を返す．
   bool
-  is_float() const;
+  is_float() const
+  {
+    return mType == Type::Float;
+  }
 
   /// @brief ブール型の時 true を返す．
   bool
-  is_bool() const;
+  is_bool() const
+  {
+    return mType == Type::Bool;
+  }
 
   /// @brief オブジェクト型の時 true を返す．
   bool
-  is_object() const;
+  is_object() const
+  {
+    return mType == Type::Object;
+  }
 
   /// @brief 配列型の時 true を返す．
   bool
-  is_array() const;
+  is_array() const
+  {
+    return mType == Type::Array;
+  }
 
   /// @brief 要素数を得る．
   ///
@@ -169,6 +354,37 @@ public:
   std::vector<std::pair<std::string, JsonValue>>
   item_list() const;
 
+  /// @brief 配列の要素をたどる範囲を返す．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// for ( auto elem: value.elements() ) の形で用いる．
+  /// リストを作らずに要素を直接たどる．
+  /// 範囲は自身の内容を共有するので，一時的な値に対しても用いることができ，
+  /// その後で自身を書き換えても範囲の内容は変わらない．
+  ElemRange
+  elements() const;
+
+  /// @brief オブジェクトのキーをたどる範囲を返す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// key_list() と異なりキーをコピーしない．
+  /// キーは範囲が存在する間有効となる．
+  /// それ以外は elements() と同様
+  KeyRange
+  keys() const;
+
+  /// @brief オブジェクトのキーと値の対をたどる範囲を返す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// item_list() と異なりキーをコピーしない．
+  /// キーは範囲が存在する間有効となる．
+  /// それ以外は elements() と同様
+  ItemRange
+  items() const;
+
   /// @brief オブジェクトの要素を得る．
   ///
   /// - is_object() == false の時は std::invalid_argument 例外を送出する．
@@ -226,55 +442,227 @@ public:
   std::string
   get_string() const;
 
+  /// @brief 文字列をコピーせずに得る．
+  ///
+  /// - is_string() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// 結果は自身が破棄されるか別の値が代入されるまで有効
+  std::string_view
+  get_string_view() const;
+
   /// @brief 整数値を得る．
   ///
   /// - is_int() == false の時は std::invalid_argument 例外を送出する．
-  int
-  get_int() const;
+  std::int64_t
+  get_int() const
+  {
+    _check_int();
+    return mBody.mInt;
+  }
 
   /// @brief 浮動小数点値を得る．
   ///
   /// - is_float() == false の時は std::invalid_argument 例外を送出する．
   double
-  get_float() const;
+  get_float() const
+  {
+    _check_float();
+    return mBody.mFloat;
+  }
 
   /// @brief ブール値を得る．
   ///
   /// - is_bool() == false の時は std::invalid_argument 例外を送出する．
   bool
-  get_bool() const;
+  get_bool() const
+  {
+    _check_bool();
+    return mBody.mBool;
+  }
+
+  /// @brief オブジェクトの要素を設定する．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  /// - key に対応する値がない場合は末尾に追加する．
+  ///
+  /// 内容を他の値と共有している場合は，自身のノードのみを複製してから
+  /// 書き換える(copy-on-write)．要素の値は複製せずに共有するので，
+  /// 大きな値の一部を書き換えても他の部分は複製されない．
+  /// 深い位置の要素を書き換える場合は，取り出した要素を書き換えてから
+  /// 親に set() し直すことで根までの経路上のノードのみが複製される．
+  void
+  set(
+    const std::string& key, ///< [in] キー
+    const JsonValue& value  ///< [in] 値
+  );
+
+  /// @brief 配列の要素を設定する．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  /// - 配列のサイズ外のアクセスは std::out_of_range 例外を送出する．
+  ///
+  /// 共有している場合の振る舞いは set(key, value) と同じ．
+  void
+  set(
+    SizeType pos,          ///< [in] 位置番号 ( 0 <= pos < size() )
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief 配列の末尾に要素を追加する．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// 共有している場合の振る舞いは set(key, value) と同じ．
+  void
+  push_back(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief オブジェクトの要素を削除する．
+  /// @return 削除した時 true を返す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  /// - key に対応する値がない場合は何もせずに false を返す．
+  ///
+  /// 共有している場合の振る舞いは set(key, value) と同じ．
+  bool
+  erase(
+    const std::string& key ///< [in] キー
+  );
+
+  /// @brief 配列の要素を削除する．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  /// - 配列のサイズ外のアクセスは std::out_of_range 例外を送出する．
+  ///
+  /// 共有している場合の振る舞いは set(key, value) と同じ．
+  void
+  erase(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  );
 
   /// @brief 読み込む．
   /// @return 結果を格納したオブジェクトを返す．
+  ///
+  /// ファイルはメモリ上にマップして直接走査する．
+  /// 遅延モードの場合，ファイルは結果の値が存在する間マップされたままとなる．
+  ///
+  /// gzip または zstd で圧縮されたファイルは先頭のマジックナンバーで
+  /// 判定して展開しながら読み込む．
+  /// 遅延モードの場合は展開した内容を結果の値が存在する間保持する．
+  /// 詳細は DecompIStream を参照のこと．
+  /// また，読み飛ばした部分の文法エラーはその部分を参照した時に
+  /// std::invalid_argument 例外として送出される．
+  /// 根の値の後ろの余分な内容は根の全体を読み込んだ時に検出される．
+  ///
+  /// intern が true の場合，オブジェクトのキーは同じ内容のものが
+  /// 一つの領域を共有し，キーの探索はポインタの比較で行われる．
+  /// 同じキーが繰り返し現れる場合にメモリが節約できる．
+  /// 遅延モードでは JsonLazy の展開とキーの探索が並行に行われる可能性が
+  /// あるので指定できない．
+  /// lazy と intern がともに true の時は std::invalid_argument 例外を送出する．
   static
   JsonValue
   read(
-    const std::string& filename ///< [in] ファイル名
+    const std::string& filename, ///< [in] ファイル名
+    bool lazy = false,           ///< [in] 遅延モードの時 true
+    bool intern = false          ///< [in] キーを共有する時 true
   );
 
   /// @brief JSON文字列をパースする．
   /// @return 結果を格納したオブジェクトを返す．
+  ///
+  /// json_str の内容をコピーせずに直接走査する．
+  /// 遅延モードの場合は内容をコピーして保持する．
+  /// 読み飛ばした部分の文法エラーはその部分を参照した時に
+  /// std::invalid_argument 例外として送出される．
+  /// intern の意味は read() と同じ．
   static
   JsonValue
   parse(
-    const std::string& json_str ///< [in] JSON文字列
+    std::string_view json_str, ///< [in] JSON文字列
+    bool lazy = false,         ///< [in] 遅延モードの時 true
+    bool intern = false        ///< [in] キーを共有する時 true
+  );
+
+  /// @brief 複数のスレッドで読み込む．
+  /// @return 結果を格納したオブジェクトを返す．
+  ///
+  /// 根が大きな配列の場合に要素を複数のスレッドで並列に読み込む．
+  /// それ以外の場合は read() と同じ．
+  /// 圧縮されたファイルは展開した内容全体をメモリ上に置いてから読み込む．
+  static
+  JsonValue
+  read_parallel(
+    const std::string& filename, ///< [in] ファイル名
+    SizeType thread_num = 0,     ///< [in] スレッド数
+                                 ///<      0 の時はハードウェアのスレッド数
+    bool intern = false          ///< [in] キーを共有する時 true
+  );
+
+  /// @brief 複数のスレッドで JSON文字列をパースする．
+  /// @return 結果を格納したオブジェクトを返す．
+  ///
+  /// 根が大きな配列の場合に要素を複数のスレッドで並列に読み込む．
+  /// それ以外の場合は parse() と同じ．
+  static
+  JsonValue
+  parse_parallel(
+    std::string_view json_str, ///< [in] JSON文字列
+    SizeType thread_num = 0,   ///< [in] スレッド数
+                               ///<      0 の時はハードウェアのスレッド数
+    bool intern = false        ///< [in] キーを共有する時 true
   );
 
   /// @brief 内容を JSON 文字列に変換する．
+  ///
+  /// 無限大か NaN の浮動小数点値を含む場合は
+  /// std::invalid_argument 例外を送出する．
   std::string
   to_json(
     bool indent = false ///< [in] インデントフラグ
   ) const;
 
   /// @brief 内容を書き出す．
+  ///
+  /// 文字列を作らずに直接 s に出力する．
+  /// 例外は to_json() と同じ．
   void
   write(
     std::ostream& s,    ///< [in] 出力ストリーム
     bool indent = false ///< [in] インデントフラグ
-  ) const
-  {
-    s << to_json(indent);
-  }
+  ) const;
+
+  /// @brief バイナリ形式で書き出す．
+  ///
+  /// オブジェクトのキーは全体で一つの辞書を共有する．
+  /// restore() で読み戻した値は operator== で等しくなる．
+  void
+  dump(
+    BinEnc& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief dump() で書き出した内容を読み込む．
+  /// @return 結果を格納したオブジェクトを返す．
+  ///
+  /// オブジェクトのキーは read() の intern を指定した場合と同様に
+  /// 共有される．
+  /// 形式が正しくない場合は std::invalid_argument 例外を送出する．
+  /// 入力が途中で終わった場合は BinDec が送出する例外
+  /// (std::ios_base::failure)となる．
+  static
+  JsonValue
+  restore(
+    BinDec& s ///< [in] 入力元のストリーム
+  );
+
+  /// @brief 構造に基づくハッシュ値を返す．
+  ///
+  /// operator== で等しい値は同じハッシュ値を持つ．
+  /// オブジェクトの要素の順番は影響しない．
+  /// 配列やオブジェクトの値は各ノードで一度だけ計算して保持する．
+  SizeType
+  hash() const;
 
   /// @brief 等価比較演算子
   bool
@@ -297,6 +685,88 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 値の種類
+  ///
+  /// String 以降は JsonObj を指す．
+  enum class Type : std::uint8_t {
+    Null,
+    Bool,
+    Int,
+    Float,
+    String,
+    Array,
+    Object
+  };
+
+  /// @brief JsonObj を指しているとき true を返す．
+  bool
+  _is_obj() const
+  {
+    return mType >= Type::String;
+  }
+
+  /// @brief 参照カウントを操作する必要があるとき true を返す．
+  bool
+  _is_owner() const
+  {
+    return _is_obj() && !mBorrowed;
+  }
+
+  /// @brief JsonObj の参照回数を増やす．
+  void
+  _inc_ref() const;
+
+  /// @brief JsonObj の参照回数を減らす．
+  void
+  _dec_ref() const;
+
+  /// @brief 書き換えのために JsonObj を他と共有しない形にする．
+  /// @return 書き換え可能な JsonObj を返す．
+  ///
+  /// 共有している場合はヒープ上に複製を作って自身をそれに置き換える．
+  JsonObj*
+  _unshare();
+
+  /// @brief JsonObj を指す値を作る．
+  ///
+  /// borrowed が true の時は参照カウントを操作しない．
+  static
+  JsonValue
+  _from_obj(
+    JsonObj* obj,  ///< [in] 実体
+    bool borrowed  ///< [in] 所有権を持たない時 true にするフラグ
+  );
+
+  /// @brief 所有権を持つ形にして返す．
+  ///
+  /// アリーナ上の要素は所有権を持たないので，
+  /// アリーナ(JsonDocument)の所有権を共有させる．
+  JsonValue
+  _own() const
+  {
+    JsonValue ans{*this};
+    if ( ans.mBorrowed ) {
+      ans.mBorrowed = false;
+      ans._inc_ref();
+    }
+    return ans;
+  }
+
+  /// @brief 所有権を持たない形にして返す．
+  ///
+  /// 参照回数は操作しない．
+  /// 結果は自身の実体が存在する間のみ有効となる．
+  JsonValue
+  _borrow() const
+  {
+    JsonValue ans;
+    ans.mBody = mBody;
+    ans.mType = mType;
+    // mBorrowed は JsonObj を指す場合のみ意味を持つ．
+    ans.mBorrowed = _is_obj();
+    return ans;
+  }
+
   /// @brief 文字列型かたどうかチェックする．
   void
   _check_string() const
@@ -366,8 +836,21 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 値の実体
-  std::shared_ptr<JsonObj> mPtr;
+  // 値の本体
+  union Body {
+    JsonObj* mObj;
+    std::int64_t mInt;
+    double mFloat;
+    bool mBool;
+  } mBody{};
+
+  // 値の種類
+  Type mType{Type::Null};
+
+  // 参照カウントを操作しない時 true にするフラグ
+  //
+  // アリーナ上のコンテナに格納された要素を表す．
+  bool mBorrowed{false};
 
 };
 
@@ -385,6 +868,254 @@ operator<<(
   const JsonValue& json_obj ///< [in] 体操のオブジェクト
 );
 
+/// @brief 配列の要素を取り出すクラス
+struct JsonElemConv
+{
+  /// @brief 内部の要素の型
+  using ElemType = JsonValue;
+
+  /// @brief 取り出す値の型
+  using ValueType = JsonValue;
+
+  /// @brief 値を取り出す．
+  static
+  ValueType
+  get(
+    const ElemType& elem ///< [in] 要素
+  )
+  {
+    return elem._own();
+  }
+};
+
+/// @brief オブジェクトのキーを取り出すクラス
+struct JsonKeyConv
+{
+  /// @brief 内部の要素の型
+  using ElemType = std::pair<std::string_view, JsonValue>;
+
+  /// @brief 取り出す値の型
+  using ValueType = std::string_view;
+
+  /// @brief 値を取り出す．
+  static
+  ValueType
+  get(
+    const ElemType& elem ///< [in] 要素
+  )
+  {
+    return elem.first;
+  }
+};
+
+/// @brief オブジェクトのキーと値の対を取り出すクラス
+struct JsonItemConv
+{
+  /// @brief 内部の要素の型
+  using ElemType = std::pair<std::string_view, JsonValue>;
+
+  /// @brief 取り出す値の型
+  using ValueType = std::pair<std::string_view, JsonValue>;
+
+  /// @brief 値を取り出す．
+  static
+  ValueType
+  get(
+    const ElemType& elem ///< [in] 要素
+  )
+  {
+    return ValueType{elem.first, elem.second._own()};
+  }
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonIter JsonValue.h "ym/JsonValue.h"
+/// @brief JsonRange の反復子
+///
+/// 内部の要素の配列を指すポインタを持ち，
+/// 参照時に Conv::get() で値を取り出す．
+//////////////////////////////////////////////////////////////////////
+template<class Conv>
+class JsonIter
+{
+public:
+
+  using ElemType = typename Conv::ElemType;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = typename Conv::ValueType;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = value_type;
+
+  /// @brief コンストラクタ
+  explicit
+  JsonIter(
+    const ElemType* ptr = nullptr ///< [in] 要素を指すポインタ
+  ) : mPtr{ptr}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~JsonIter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値を取り出す．
+  value_type
+  operator*() const
+  {
+    return Conv::get(*mPtr);
+  }
+
+  /// @brief 次の要素に進める．
+  JsonIter&
+  operator++()
+  {
+    ++ mPtr;
+    return *this;
+  }
+
+  /// @brief 次の要素に進める(後置)．
+  JsonIter
+  operator++(int)
+  {
+    auto tmp = *this;
+    ++ mPtr;
+    return tmp;
+  }
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(
+    const JsonIter& right ///< [in] オペランド
+  ) const
+  {
+    return mPtr == right.mPtr;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const JsonIter& right ///< [in] オペランド
+  ) const
+  {
+    return !operator==(right);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素を指すポインタ
+  const ElemType* mPtr;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonRange JsonValue.h "ym/JsonValue.h"
+/// @brief JsonValue の要素をたどる範囲を表すクラス
+///
+/// JsonValue::elements(), keys(), items() が返す．
+/// 元の値を共有して保持するので，範囲が存在する間は要素は有効となる．
+//////////////////////////////////////////////////////////////////////
+template<class Conv>
+class JsonRange
+{
+public:
+
+  using ElemType = typename Conv::ElemType;
+  using iterator = JsonIter<Conv>;
+
+  /// @brief コンストラクタ
+  JsonRange(
+    const JsonValue& holder, ///< [in] 要素を持つ値
+    const ElemType* begin,   ///< [in] 先頭の要素
+    SizeType n               ///< [in] 要素数
+  ) : mHolder{holder},
+      mBegin{begin},
+      mEnd{begin + n}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~JsonRange() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭の反復子を返す．
+  iterator
+  begin() const
+  {
+    return iterator{mBegin};
+  }
+
+  /// @brief 末尾の反復子を返す．
+  iterator
+  end() const
+  {
+    return iterator{mEnd};
+  }
+
+  /// @brief 要素数を返す．
+  SizeType
+  size() const
+  {
+    return mEnd - mBegin;
+  }
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mBegin == mEnd;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素を持つ値
+  JsonValue mHolder;
+
+  // 先頭の要素
+  const ElemType* mBegin;
+
+  // 末尾の次の要素
+  const ElemType* mEnd;
+
+};
+
 END_NAMESPACE_YM_JSON
 
+BEGIN_NAMESPACE_STD
+
+/// @brief JsonValue をキーとするハッシュ表のためのハッシュ関数
+template<>
+struct hash<YM_NAMESPACE::JSON_NSNAME::JsonValue>
+{
+  SizeType
+  operator()(
+    const YM_NAMESPACE::JSON_NSNAME::JsonValue& value
+  ) const
+  {
+    return value.hash();
+  }
+};
+
+END_NAMESPACE_STD
+
 #endif // JSONVALUE_H
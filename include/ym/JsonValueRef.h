@@ -0,0 +1,373 @@
+#ifndef JSONVALUEREF_H
+#define JSONVALUEREF_H
+
+/// @file JsonValueRef.h
+/// @brief JsonValueRef のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+struct JsonElemRefConv;
+struct JsonItemRefConv;
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonValueRef JsonValueRef.h "ym/JsonValueRef.h"
+/// @brief JsonValue の内容を所有権を持たずに参照するクラス
+///
+/// JsonValue の読み出し用のメソッドと同じものを持つが，
+/// 要素を取り出しても参照回数を操作しない．
+/// そのため読み出しだけを繰り返す場合に不可分操作の負荷がかからない．
+///
+/// 参照先の実体は元の JsonValue が保持するので，
+/// 元の JsonValue が破棄されるか書き換えられるまでの間のみ有効となる．
+/// 有効範囲を超えて保持する場合は value() で JsonValue にする．
+//////////////////////////////////////////////////////////////////////
+class JsonValueRef
+{
+public:
+
+  /// @brief 配列の要素をたどる範囲
+  using ElemRange = JsonRange<JsonElemRefConv>;
+
+  /// @brief オブジェクトのキーをたどる範囲
+  using KeyRange = JsonRange<JsonKeyConv>;
+
+  /// @brief オブジェクトのキーと値の対をたどる範囲
+  using ItemRange = JsonRange<JsonItemRefConv>;
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// null 型の値を参照する．
+  JsonValueRef() = default;
+
+  /// @brief JsonValue を参照するコンストラクタ
+  ///
+  /// value が破棄されるまでの間のみ有効となるので明示的に作る．
+  explicit
+  JsonValueRef(
+    const JsonValue& value ///< [in] 参照する値
+  ) : mValue{value._borrow()}
+  {
+  }
+
+  /// @brief 一時オブジェクトは参照できない．
+  JsonValueRef(
+    JsonValue&& value ///< [in] 参照する値
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~JsonValueRef() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief null 型の時 true を返す．
+  bool
+  is_null() const
+  {
+    return mValue.is_null();
+  }
+
+  /// @brief 文字列型の時 true を返す．
+  bool
+  is_string() const
+  {
+    return mValue.is_string();
+  }
+
+  /// @brief 数値型の時 true を返す．
+  bool
+  is_number() const
+  {
+    return mValue.is_number();
+  }
+
+  /// @brief 整数型の時 true を返す．
+  bool
+  is_int() const
+  {
+    return mValue.is_int();
+  }
+
+  /// @brief 浮動小数点型の時 true を返す．
+  bool
+  is_float() const
+  {
+    return mValue.is_float();
+  }
+
+  /// @brief ブール型の時 true を返す．
+  bool
+  is_bool() const
+  {
+    return mValue.is_bool();
+  }
+
+  /// @brief オブジェクト型の時 true を返す．
+  bool
+  is_object() const
+  {
+    return mValue.is_object();
+  }
+
+  /// @brief 配列型の時 true を返す．
+  bool
+  is_array() const
+  {
+    return mValue.is_array();
+  }
+
+  /// @brief 要素数を得る．
+  ///
+  /// - is_object() == false and is_array() == false
+  ///   の時は std::invalid_argument 例外を送出する．
+  SizeType
+  size() const
+  {
+    return mValue.size();
+  }
+
+  /// @brief オブジェクトがキーを持つか調べる．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  bool
+  has_key(
+    const std::string& key ///< [in] キー
+  ) const
+  {
+    return mValue.has_key(key);
+  }
+
+  /// @brief 配列の要素をたどる範囲を返す．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// 要素は JsonValueRef として取り出される．
+  ElemRange
+  elements() const;
+
+  /// @brief オブジェクトのキーをたどる範囲を返す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  KeyRange
+  keys() const;
+
+  /// @brief オブジェクトのキーと値の対をたどる範囲を返す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  ///
+  /// 値は JsonValueRef として取り出される．
+  ItemRange
+  items() const;
+
+  /// @brief オブジェクトの要素を得る．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  /// - key に対応する値がない場合は std::invalid_argument 例外を送出する．
+  JsonValueRef
+  operator[](
+    const std::string& key ///< [in] キー
+  ) const
+  {
+    return at(key);
+  }
+
+  /// @brief operator[] の別名
+  JsonValueRef
+  at(
+    const std::string& key ///< [in] キー
+  ) const;
+
+  /// @brief キーに対応する要素を取り出す．
+  ///
+  /// - is_object() == false の時は std::invalid_argument 例外を送出する．
+  /// - key に対応する値がない場合には null を返す．
+  JsonValueRef
+  get(
+    const std::string& key ///< [in] キー
+  ) const;
+
+  /// @brief 配列の要素を得る．
+  ///
+  /// - is_array() == false の時は std::invalid_argument 例外を送出する．
+  /// - 配列のサイズ外のアクセスは std::out_of_range 例外を送出する．
+  JsonValueRef
+  operator[](
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    return at(pos);
+  }
+
+  /// @brief operator[] の別名
+  JsonValueRef
+  at(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const;
+
+  /// @brief 文字列を得る．
+  ///
+  /// - is_string() == false の時は std::invalid_argument 例外を送出する．
+  std::string
+  get_string() const
+  {
+    return mValue.get_string();
+  }
+
+  /// @brief 文字列をコピーせずに得る．
+  ///
+  /// - is_string() == false の時は std::invalid_argument 例外を送出する．
+  std::string_view
+  get_string_view() const
+  {
+    return mValue.get_string_view();
+  }
+
+  /// @brief 整数値を得る．
+  ///
+  /// - is_int() == false の時は std::invalid_argument 例外を送出する．
+  std::int64_t
+  get_int() const
+  {
+    return mValue.get_int();
+  }
+
+  /// @brief 浮動小数点値を得る．
+  ///
+  /// - is_float() == false の時は std::invalid_argument 例外を送出する．
+  double
+  get_float() const
+  {
+    return mValue.get_float();
+  }
+
+  /// @brief ブール値を得る．
+  ///
+  /// - is_bool() == false の時は std::invalid_argument 例外を送出する．
+  bool
+  get_bool() const
+  {
+    return mValue.get_bool();
+  }
+
+  /// @brief 所有権を持つ JsonValue を返す．
+  JsonValue
+  value() const
+  {
+    return mValue._own();
+  }
+
+  /// @brief 内容を JSON 文字列に変換する．
+  std::string
+  to_json(
+    bool indent = false ///< [in] インデントする時 true
+  ) const
+  {
+    return mValue.to_json(indent);
+  }
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(
+    const JsonValueRef& right ///< [in] オペランド
+  ) const
+  {
+    return mValue == right.mValue;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const JsonValueRef& right ///< [in] オペランド
+  ) const
+  {
+    return !operator==(right);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 所有権を持たない値を参照するオブジェクトを作る．
+  ///
+  /// value は JsonObj::get_value() の結果のように
+  /// 実体を他の JsonValue が保持しているものでなければならない．
+  static
+  JsonValueRef
+  _from_borrowed(
+    const JsonValue& value ///< [in] 参照する値
+  )
+  {
+    JsonValueRef ref;
+    ref.mValue = value._borrow();
+    return ref;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 参照する値
+  //
+  // 常に所有権を持たない形で保持する．
+  JsonValue mValue;
+
+};
+
+/// @brief 配列の要素を JsonValueRef として取り出すクラス
+struct JsonElemRefConv
+{
+  /// @brief 内部の要素の型
+  using ElemType = JsonValue;
+
+  /// @brief 取り出す値の型
+  using ValueType = JsonValueRef;
+
+  /// @brief 値を取り出す．
+  static
+  ValueType
+  get(
+    const ElemType& elem ///< [in] 要素
+  )
+  {
+    return JsonValueRef{elem};
+  }
+};
+
+/// @brief オブジェクトのキーと値の対を JsonValueRef として取り出すクラス
+struct JsonItemRefConv
+{
+  /// @brief 内部の要素の型
+  using ElemType = std::pair<std::string_view, JsonValue>;
+
+  /// @brief 取り出す値の型
+  using ValueType = std::pair<std::string_view, JsonValueRef>;
+
+  /// @brief 値を取り出す．
+  static
+  ValueType
+  get(
+    const ElemType& elem ///< [in] 要素
+  )
+  {
+    return ValueType{elem.first, JsonValueRef{elem.second}};
+  }
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONVALUEREF_H
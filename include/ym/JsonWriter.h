@@ -0,0 +1,230 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+/// @file JsonWriter.h
+/// @brief JsonWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/json.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_JSON
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonWriter JsonWriter.h "ym/JsonWriter.h"
+/// @brief JSON 形式の出力を行うクラス
+///
+/// 字句を直接出力バッファに書き込む．
+/// 出力先が ostream の場合は一定量たまるごとに書き出す．
+/// JsonValue の内容をまとめて出力することも，
+/// object_begin(), write_key(), write_int() などを用いて
+/// JsonValue を作らずに逐次出力することもできる．
+///
+/// インデントモードの出力は JsonValue::to_json(true) と同じ形式になる．
+/// インデントモードではトップレベルの値の後に改行を出力する．
+///
+/// 構造に合わない呼び出しを行った場合には
+/// std::invalid_argument 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class JsonWriter
+{
+public:
+
+  /// @brief 出力ストリームを指定したコンストラクタ
+  JsonWriter(
+    std::ostream& s,    ///< [in] 出力ストリーム
+    bool indent = false ///< [in] インデントフラグ
+  );
+
+  /// @brief 出力先の文字列を指定したコンストラクタ
+  ///
+  /// 出力は buff の末尾に追加される．
+  JsonWriter(
+    std::string& buff,  ///< [in] 出力先の文字列
+    bool indent = false ///< [in] インデントフラグ
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// 残っている内容を書き出す．
+  ~JsonWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief オブジェクトの開始
+  void
+  object_begin();
+
+  /// @brief オブジェクトの終了
+  void
+  object_end();
+
+  /// @brief 配列の開始
+  void
+  array_begin();
+
+  /// @brief 配列の終了
+  void
+  array_end();
+
+  /// @brief オブジェクトのキーを出力する．
+  ///
+  /// 直後に値を出力しなければならない．
+  void
+  write_key(
+    std::string_view key ///< [in] キー
+  );
+
+  /// @brief null を出力する．
+  void
+  write_null();
+
+  /// @brief ブール値を出力する．
+  void
+  write_bool(
+    bool value ///< [in] 値
+  );
+
+  /// @brief 整数値を出力する．
+  void
+  write_int(
+    std::int64_t value ///< [in] 値
+  );
+
+  /// @brief 浮動小数点値を出力する．
+  ///
+  /// 読み戻すと同じ値になる最短の表記で出力する．
+  /// 整数と区別するために小数点か指数部を必ず含める．
+  /// 無限大と NaN は JSON で表せないので std::invalid_argument 例外を送出する．
+  void
+  write_float(
+    double value ///< [in] 値
+  );
+
+  /// @brief 文字列を出力する．
+  void
+  write_string(
+    std::string_view value ///< [in] 値
+  );
+
+  /// @brief JsonValue の内容を出力する．
+  void
+  write_value(
+    const JsonValue& value ///< [in] 値
+  );
+
+  /// @brief バッファの内容を書き出す．
+  ///
+  /// 出力先が文字列の場合は何もしない．
+  void
+  flush();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値を出力する前の処理を行う．
+  void
+  value_begin();
+
+  /// @brief 値を出力した後の処理を行う．
+  void
+  value_end();
+
+  /// @brief 要素の区切りとインデントを出力する．
+  void
+  write_sep();
+
+  /// @brief インデントを出力する．
+  void
+  write_tab(
+    SizeType n ///< [in] 段数
+  );
+
+  /// @brief 文字列をクオートして出力する．
+  ///
+  /// 常に double-quote を用い，double-quote，バックスラッシュと
+  /// 制御文字はエスケープする．
+  void
+  write_quoted(
+    std::string_view str ///< [in] 文字列
+  );
+
+  /// @brief 出力ストリームに書き出す必要があれば書き出す．
+  void
+  check_flush()
+  {
+    if ( mS != nullptr && mOut->size() >= FLUSH_SIZE ) {
+      flush();
+    }
+  }
+
+  /// @brief エラーを送出する．
+  [[noreturn]]
+  void
+  error(
+    const char* msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 入れ子の状態
+  struct Frame
+  {
+    // オブジェクトの時 true
+    bool mIsObject;
+
+    // 最初の要素の時 true
+    bool mFirst;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力ストリームに書き出すバッファサイズ
+  static const SizeType FLUSH_SIZE = 64 * 1024;
+
+  // 出力ストリーム
+  //
+  // 文字列に出力する場合は nullptr
+  std::ostream* mS{nullptr};
+
+  // 出力ストリーム用のバッファ
+  std::string mBuff;
+
+  // 出力先
+  //
+  // mBuff か出力先の文字列を指す．
+  std::string* mOut;
+
+  // インデントフラグ
+  bool mIndent;
+
+  // 入れ子の状態のスタック
+  std::vector<Frame> mStack;
+
+  // 直前にキーを出力した時 true
+  bool mAfterKey{false};
+
+};
+
+END_NAMESPACE_YM_JSON
+
+#endif // JSONWRITER_H
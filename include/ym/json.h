@@ -27,12 +27,28 @@ END_NAMESPACE_YM
 BEGIN_NAMESPACE_YM_JSON
 
 class JsonValue;
+class JsonValueRef;
+class JsonWriter;
+class JsonReader;
+class JsonHandler;
+class JsonPointer;
+class JsonLinesReader;
+class JsonDedup;
+class JsonPushParser;
 
 END_NAMESPACE_YM_JSON
 
 BEGIN_NAMESPACE_YM
 
 using JSON_NSNAME::JsonValue;
+using JSON_NSNAME::JsonValueRef;
+using JSON_NSNAME::JsonWriter;
+using JSON_NSNAME::JsonReader;
+using JSON_NSNAME::JsonHandler;
+using JSON_NSNAME::JsonPointer;
+using JSON_NSNAME::JsonLinesReader;
+using JSON_NSNAME::JsonDedup;
+using JSON_NSNAME::JsonPushParser;
 
 END_NAMESPACE_YM
 
@@ -7,12 +7,14 @@
 /// All rights reserved.
 
 #include "pym/PyJsonValue.h"
+#include "pym/PyJsonView.h"
 #include "pym/PyString.h"
 #include "pym/PyInt.h"
 #include "pym/PyFloat.h"
 #include "pym/PyDict.h"
 #include "pym/PyList.h"
 #include "ym/JsonValue.h"
+#include "ym/JsonValueRef.h"
 #include "pym/PyModule.h"
 
 
@@ -47,6 +49,257 @@ static const char* EMSG_NOT_BOOL = "not a bool type";
 static const char* EMSG_NOT_OBJ_ARRAY = "neither an object nor an array type";
 static const char* EMSG_OUT_OF_RANGE = "index is out-of-range";
 
+// GIL を解放して func を実行する．
+//
+// 他のスレッドが Python のコードを実行できるように
+// 時間のかかる読み込みや書き出しはこの中で行う．
+// func の中で Python の API を呼んではいけない．
+// std::invalid_argument 例外が送出された場合は ValueError を設定して
+// false を返す．
+template<class Func>
+bool
+call_without_gil(
+  Func func
+)
+{
+  std::string err_msg;
+  bool ok = true;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    func();
+  }
+  catch ( std::invalid_argument err ) {
+    err_msg = err.what();
+    ok = false;
+  }
+  Py_END_ALLOW_THREADS
+  if ( !ok ) {
+    std::ostringstream buf;
+    buf << "invalid argument" << ": " << err_msg;
+    PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+  }
+  return ok;
+}
+
+// JsonValue を Python の組み込み型のオブジェクトに変換するクラス
+//
+// 要素は JsonValueRef でたどるので参照回数の操作は行わない．
+// オブジェクトのキーは同じ内容のものが一つの str オブジェクトを共有する．
+class ToPython
+{
+public:
+
+  // デストラクタ
+  ~ToPython()
+  {
+    for ( auto& p: mKeyDict ) {
+      Py_DECREF(p.second);
+    }
+  }
+
+  // val を変換する．
+  // エラーの場合は例外を設定して nullptr を返す．
+  static
+  PyObject*
+  convert(
+    const JsonValue& val
+  )
+  {
+    // 結果は循環参照を含まないので，大量のオブジェクトを作る間に
+    // 循環参照の検出が何度も走らないように止めておく．
+#if PY_VERSION_HEX >= 0x030A0000
+    auto gc_enabled = PyGC_Disable();
+#endif
+    PyObject* ans = nullptr;
+    try {
+      ToPython conv;
+      ans = conv(JsonValueRef{val});
+    }
+    catch ( std::invalid_argument err ) {
+      std::ostringstream buf;
+      buf << "invalid argument" << ": " << err.what();
+      PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+    }
+#if PY_VERSION_HEX >= 0x030A0000
+    if ( gc_enabled ) {
+      PyGC_Enable();
+    }
+#endif
+    return ans;
+  }
+
+  // 変換する．
+  // エラーの場合は nullptr を返す．
+  PyObject*
+  operator()(
+    JsonValueRef val
+  )
+  {
+    if ( val.is_null() ) {
+      Py_RETURN_NONE;
+    }
+    if ( val.is_bool() ) {
+      return PyBool_FromLong(val.get_bool());
+    }
+    if ( val.is_int() ) {
+      return PyLong_FromLongLong(val.get_int());
+    }
+    if ( val.is_float() ) {
+      return PyFloat_FromDouble(val.get_float());
+    }
+    if ( val.is_string() ) {
+      return str_obj(val.get_string_view());
+    }
+    if ( Py_EnterRecursiveCall(" while converting JsonValue") ) {
+      return nullptr;
+    }
+    auto ans = val.is_array() ? list_obj(val) : dict_obj(val);
+    Py_LeaveRecursiveCall();
+    return ans;
+  }
+
+  // 文字列を str オブジェクトに変換する．
+  static
+  PyObject*
+  str_obj(
+    std::string_view str
+  )
+  {
+    // 対になっていないサロゲートは json モジュールと同様にそのまま通す．
+    return PyUnicode_DecodeUTF8(str.data(), str.size(), "surrogatepass");
+  }
+
+
+private:
+
+  // 配列を list オブジェクトに変換する．
+  PyObject*
+  list_obj(
+    JsonValueRef val
+  )
+  {
+    auto ans = PyList_New(val.size());
+    if ( ans == nullptr ) {
+      return nullptr;
+    }
+    SizeType i = 0;
+    for ( auto elem: val.elements() ) {
+      auto elem_obj = operator()(elem);
+      if ( elem_obj == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      PyList_SET_ITEM(ans, i, elem_obj);
+      ++ i;
+    }
+    return ans;
+  }
+
+  // オブジェクトを dict オブジェクトに変換する．
+  PyObject*
+  dict_obj(
+    JsonValueRef val
+  )
+  {
+    auto ans = PyDict_New();
+    if ( ans == nullptr ) {
+      return nullptr;
+    }
+    for ( auto item: val.items() ) {
+      auto key_obj = key(item.first);
+      auto value_obj = key_obj != nullptr ? operator()(item.second) : nullptr;
+      if ( value_obj == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      auto stat = PyDict_SetItem(ans, key_obj, value_obj);
+      Py_DECREF(value_obj);
+      if ( stat < 0 ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+    }
+    return ans;
+  }
+
+  // キーを表す str オブジェクトを返す．
+  //
+  // 返り値は借用参照
+  PyObject*
+  key(
+    std::string_view key
+  )
+  {
+    auto p = mKeyDict.find(key);
+    if ( p != mKeyDict.end() ) {
+      return p->second;
+    }
+    auto obj = str_obj(key);
+    if ( obj != nullptr ) {
+      mKeyDict.emplace(key, obj);
+    }
+    return obj;
+  }
+
+  // キーの辞書
+  // キーの文字列の実体は変換元の JsonValue が保持している．
+  std::unordered_map<std::string_view, PyObject*> mKeyDict;
+
+};
+
+// 組み込みの dict, list, tuple を JsonValue に変換する．
+//
+// 中間のオブジェクトを作らずに直接要素をたどる．
+// 変換できなかった場合は false を返す．
+bool
+from_python_container(
+  PyObject* obj,
+  JsonValue& val
+)
+{
+  if ( Py_EnterRecursiveCall(" while converting to JsonValue") ) {
+    PyErr_Clear();
+    return false;
+  }
+  bool ok = true;
+  if ( PyDict_Check(obj) ) {
+    // "辞書型"
+    // dict の順番を保つためにキーと値の対のリストで作る．
+    std::vector<std::pair<std::string, JsonValue>> val1;
+    val1.reserve(PyDict_GET_SIZE(obj));
+    Py_ssize_t pos = 0;
+    PyObject* key_obj;
+    PyObject* value_obj;
+    while ( ok && PyDict_Next(obj, &pos, &key_obj, &value_obj) ) {
+      Py_ssize_t size;
+      auto key = PyUnicode_Check(key_obj) ? PyUnicode_AsUTF8AndSize(key_obj, &size) : nullptr;
+      JsonValue value;
+      ok = key != nullptr && PyJsonValue::FromPyObject(value_obj, value);
+      if ( ok ) {
+        val1.emplace_back(std::string(key, size), std::move(value));
+      }
+    }
+    if ( ok ) {
+      val = JsonValue(std::move(val1));
+    }
+  }
+  else {
+    // "シーケンス(リスト)型"
+    auto n = PySequence_Fast_GET_SIZE(obj);
+    auto item_array = PySequence_Fast_ITEMS(obj);
+    std::vector<JsonValue> val1(n);
+    for ( Py_ssize_t i = 0; ok && i < n; ++ i ) {
+      ok = PyJsonValue::FromPyObject(item_array[i], val1[i]);
+    }
+    if ( ok ) {
+      val = JsonValue(std::move(val1));
+    }
+  }
+  Py_LeaveRecursiveCall();
+  PyErr_Clear();
+  return ok;
+}
+
 // 終了関数
 void
 dealloc_func(
@@ -65,15 +318,11 @@ repr_func(
 )
 {
   auto& val = PyJsonValue::_get_ref(self);
-  try {
-    return PyString::ToPyObject(val.to_json());
-  }
-  catch ( std::invalid_argument err ) {
-    std::ostringstream buf;
-    buf << "invalid argument" << ": " << err.what();
-    PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+  std::string json_str;
+  if ( !call_without_gil([&]() { json_str = val.to_json(); }) ) {
     return nullptr;
   }
+  return PyString::ToPyObject(json_str);
 }
 
 Py_ssize_t
@@ -110,16 +359,13 @@ sq_item(
       PyErr_SetString(PyExc_TypeError, EMSG_NOT_ARRAY);
       return nullptr;
     }
-    try {
-      auto index1 = ( index >= 0 ) ? index : val.size() + index;
-      return PyJsonValue::ToPyObject(val.at(index1));
-    }
-    catch ( std::invalid_argument err ) {
-      std::ostringstream buf;
-      buf << "invalid argument" << ": " << err.what();
-      PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+    auto index1 = ( index >= 0 ) ? index : val.size() + index;
+    if ( index1 >= val.size() ) {
+      // for 文での反復を終わらせるために IndexError とする．
+      PyErr_SetString(PyExc_IndexError, EMSG_OUT_OF_RANGE);
       return nullptr;
     }
+    return PyJsonValue::ToPyObject(val.at(index1));
   }
   catch ( std::invalid_argument err ) {
     std::ostringstream buf;
@@ -388,7 +634,7 @@ get_int(
     return nullptr;
   }
   auto ans = val.get_int();
-  return PyInt::ToPyObject(ans);
+  return PyLong_FromLongLong(ans);
 }
 
 // get float value
@@ -453,13 +699,15 @@ write(
     indent = static_cast<bool>(indent_tmp);
   }
   auto& val = PyJsonValue::_get_ref(self);
-  std::ofstream s;
+  std::ofstream s{filename};
   if ( !s ) {
     std::ostringstream buff;
     buff << filename << ": Could not open.";
     PyErr_SetString(PyExc_ValueError, buff.str().c_str());
     return nullptr;
-    val.write(s, indent);
+  }
+  if ( !call_without_gil([&]() { val.write(s, indent); }) ) {
+    return nullptr;
   }
   Py_RETURN_NONE;
 }
@@ -486,16 +734,11 @@ parse(
   if ( json_str_tmp != nullptr ) {
     json_str = std::string(json_str_tmp);
   }
-  try {
-    auto val = JsonValue::parse(json_str);
-    return PyJsonValue::ToPyObject(val);
-  }
-  catch ( std::invalid_argument err ) {
-    std::ostringstream buf;
-    buf << "invalid argument" << ": " << err.what();
-    PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+  JsonValue val;
+  if ( !call_without_gil([&]() { val = JsonValue::parse(json_str); }) ) {
     return nullptr;
   }
+  return PyJsonValue::ToPyObject(val);
 }
 
 // read JSON data from file
@@ -520,16 +763,33 @@ read(
   if ( filename_tmp != nullptr ) {
     filename = std::string(filename_tmp);
   }
-  try {
-    auto val = JsonValue::read(filename);
-    return PyJsonValue::ToPyObject(val);
-  }
-  catch ( std::invalid_argument err ) {
-    std::ostringstream buf;
-    buf << "invalid argument" << ": " << err.what();
-    PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+  JsonValue val;
+  if ( !call_without_gil([&]() { val = JsonValue::read(filename); }) ) {
     return nullptr;
   }
+  return PyJsonValue::ToPyObject(val);
+}
+
+// convert to Python object
+PyObject*
+to_python(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  auto& val = PyJsonValue::_get_ref(self);
+  return ToPython::convert(val);
+}
+
+// make lazy view
+PyObject*
+view(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  auto& val = PyJsonValue::_get_ref(self);
+  return PyJsonView::ToPyObject(val);
 }
 
 // メソッド定義
@@ -602,6 +862,14 @@ PyMethodDef methods[] = {
    reinterpret_cast<PyCFunction>(read),
    METH_VARARGS | METH_KEYWORDS | METH_STATIC,
    PyDoc_STR("read JSON data from file")},
+  {"to_python",
+   to_python,
+   METH_NOARGS,
+   PyDoc_STR("convert to Python object")},
+  {"view",
+   view,
+   METH_NOARGS,
+   PyDoc_STR("make lazy Mapping/Sequence view")},
   // end-marker
   {nullptr, nullptr, 0, nullptr}
 };
@@ -641,15 +909,20 @@ get_item_list(
     return nullptr;
   }
   try {
-    auto item_list = val.item_list();
-    auto n = item_list.size();
-    auto ans = PyList_New(n);
-    for ( SizeType i = 0; i < n; ++ i ) {
-      auto& p = item_list[i];
-      auto key = p.first;
-      auto value = p.second;
-      auto value_obj = PyJsonValue::ToPyObject(value);
-      auto item_obj = Py_BuildValue("sO", key.c_str(), value_obj);
+    // キーはコピーせずに直接 str オブジェクトにする．
+    auto items = val.items();
+    auto ans = PyList_New(items.size());
+    SizeType i = 0;
+    for ( auto p = items.begin(); p != items.end(); ++ p, ++ i ) {
+      auto item = *p;
+      auto key_obj = ToPython::str_obj(item.first);
+      if ( key_obj == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      auto item_obj = PyTuple_New(2);
+      PyTuple_SET_ITEM(item_obj, 0, key_obj);
+      PyTuple_SET_ITEM(item_obj, 1, PyJsonValue::ToPyObject(item.second));
       PyList_SET_ITEM(ans, i, item_obj);
     }
     return ans;
@@ -759,7 +1032,7 @@ PyJsonValue::Deconv::operator()(
   ElemType& val  ///< [out] 結果を格納する変数
 )
 {
-  if ( obj == nullptr ) {
+  if ( obj == nullptr || obj == Py_None ) {
     // "null オブジェクト"
     val = JsonValue::null();
     return true;
@@ -778,25 +1051,43 @@ PyJsonValue::Deconv::operator()(
     val = PyJsonValue::_get_ref(obj);
     return true;
   }
+  if ( PyJsonView::Check(obj) ) {
+    val = PyJsonView::_get_ref(obj);
+    return true;
+  }
 
-  {
-    std::string val1;
-    if ( PyString::FromPyObject(obj, val1) ) {
-      // "文字列型"
-      val = JsonValue(val1);
-      return true;
+  if ( PyUnicode_Check(obj) ) {
+    // "文字列型"
+    Py_ssize_t size;
+    auto str = PyUnicode_AsUTF8AndSize(obj, &size);
+    if ( str == nullptr ) {
+      PyErr_Clear();
+      return false;
     }
+    val = JsonValue(std::string(str, size));
+    return true;
   }
 
-  {
-    int val1;
-    if ( PyInt::FromPyObject(obj, val1) ) {
+  if ( PyLong_Check(obj) ) {
+    int overflow;
+    auto val1 = PyLong_AsLongLongAndOverflow(obj, &overflow);
+    if ( overflow == 0 ) {
       // "整数型"
-      val = JsonValue(val1);
+      val = JsonValue(static_cast<std::int64_t>(val1));
       return true;
     }
   }
 
+  if ( PyFloat_Check(obj) ) {
+    // "浮動小数点型"
+    val = JsonValue(PyFloat_AS_DOUBLE(obj));
+    return true;
+  }
+
+  if ( PyDict_Check(obj) || PyList_Check(obj) || PyTuple_Check(obj) ) {
+    return from_python_container(obj, val);
+  }
+
   {
     double val1;
     if ( PyFloat::FromPyObject(obj, val1) ) {
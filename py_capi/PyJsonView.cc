@@ -0,0 +1,853 @@
+
+/// @file PyJsonView.cc
+/// @brief PyJsonView の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2026 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "pym/PyJsonView.h"
+#include "pym/PyJsonValue.h"
+#include "pym/PyString.h"
+#include "pym/PyModule.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+using KeyRange = JsonValue::KeyRange;
+
+// オブジェクト型のビューの定義
+//
+// mVal のコンストラクタは起動されないので明示的に起動する必要がある．
+// メモリを開放するときにも明示的にデストラクタを起動する必要がある．
+struct ObjectView_Object
+{
+  PyObject_HEAD
+  JsonValue mVal;
+  // 変換済みの要素を保持する辞書
+  // 最初に要素を参照した時に作る．
+  PyObject* mCache;
+};
+
+// 配列型のビューの定義
+struct ArrayView_Object
+{
+  PyObject_HEAD
+  JsonValue mVal;
+  // 変換済みの要素を保持する配列
+  // 最初に要素を参照した時に要素数分の領域を確保する．
+  // 未変換の要素は nullptr となる．
+  std::vector<PyObject*> mCache;
+};
+
+// オブジェクト型のビューのキーの反復子の定義
+struct KeyIter_Object
+{
+  PyObject_HEAD
+  KeyRange mRange;
+  KeyRange::iterator mCur;
+};
+
+// Python 用のタイプ定義
+PyTypeObject ObjectView_Type = {
+  PyVarObject_HEAD_INIT(nullptr, 0)
+  // 残りは PyJsonView::init() 中で初期化する．
+};
+
+PyTypeObject ArrayView_Type = {
+  PyVarObject_HEAD_INIT(nullptr, 0)
+  // 残りは PyJsonView::init() 中で初期化する．
+};
+
+PyTypeObject KeyIter_Type = {
+  PyVarObject_HEAD_INIT(nullptr, 0)
+  // 残りは PyJsonView::init() 中で初期化する．
+};
+
+// collections.abc の KeysView, ValuesView, ItemsView
+PyObject* KeysView_Class = nullptr;
+PyObject* ValuesView_Class = nullptr;
+PyObject* ItemsView_Class = nullptr;
+
+// 文字列を str オブジェクトに変換する．
+PyObject*
+str_obj(
+  std::string_view str
+)
+{
+  // 対になっていないサロゲートは to_python() と同様にそのまま通す．
+  return PyUnicode_DecodeUTF8(str.data(), str.size(), "surrogatepass");
+}
+
+// 等価比較の結果を返す．
+PyObject*
+compare_result(
+  bool eq,
+  int op
+)
+{
+  return PyBool_FromLong(op == Py_EQ ? eq : !eq);
+}
+
+// repr 関数
+PyObject*
+repr_func(
+  PyObject* self
+)
+{
+  auto& val = PyJsonView::_get_ref(self);
+  return PyString::ToPyObject(val.to_json());
+}
+
+// 元の JsonValue を返す．
+PyObject*
+value(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  auto& val = PyJsonView::_get_ref(self);
+  return PyJsonValue::ToPyObject(val);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// JsonObjectView
+//////////////////////////////////////////////////////////////////////
+
+// 終了関数
+void
+object_dealloc(
+  PyObject* self
+)
+{
+  auto obj = reinterpret_cast<ObjectView_Object*>(self);
+  Py_XDECREF(obj->mCache);
+  obj->mVal.~JsonValue();
+  Py_TYPE(self)->tp_free(self);
+}
+
+// キーに対応する要素を返す．
+//
+// 返り値は新しい参照
+// キーがない場合は KeyError を設定して nullptr を返す．
+PyObject*
+object_lookup(
+  PyObject* self,
+  PyObject* key
+)
+{
+  auto obj = reinterpret_cast<ObjectView_Object*>(self);
+  if ( obj->mCache != nullptr ) {
+    auto item = PyDict_GetItemWithError(obj->mCache, key);
+    if ( item != nullptr ) {
+      Py_INCREF(item);
+      return item;
+    }
+    if ( PyErr_Occurred() ) {
+      return nullptr;
+    }
+  }
+  if ( !PyUnicode_Check(key) ) {
+    PyErr_SetObject(PyExc_KeyError, key);
+    return nullptr;
+  }
+  Py_ssize_t size;
+  auto str = PyUnicode_AsUTF8AndSize(key, &size);
+  if ( str == nullptr ) {
+    return nullptr;
+  }
+  std::string key_str{str, static_cast<SizeType>(size)};
+  if ( !obj->mVal.has_key(key_str) ) {
+    PyErr_SetObject(PyExc_KeyError, key);
+    return nullptr;
+  }
+  auto item = PyJsonView::ToPyObject(obj->mVal.at(key_str));
+  if ( item == nullptr ) {
+    return nullptr;
+  }
+  if ( obj->mCache == nullptr ) {
+    obj->mCache = PyDict_New();
+  }
+  if ( obj->mCache == nullptr || PyDict_SetItem(obj->mCache, key, item) < 0 ) {
+    Py_DECREF(item);
+    return nullptr;
+  }
+  return item;
+}
+
+Py_ssize_t
+object_length(
+  PyObject* self
+)
+{
+  auto& val = PyJsonView::_get_ref(self);
+  return val.size();
+}
+
+int
+object_contains(
+  PyObject* self,
+  PyObject* key
+)
+{
+  auto obj = reinterpret_cast<ObjectView_Object*>(self);
+  if ( obj->mCache != nullptr ) {
+    auto stat = PyDict_Contains(obj->mCache, key);
+    if ( stat != 0 ) {
+      return stat;
+    }
+  }
+  if ( !PyUnicode_Check(key) ) {
+    return 0;
+  }
+  Py_ssize_t size;
+  auto str = PyUnicode_AsUTF8AndSize(key, &size);
+  if ( str == nullptr ) {
+    return -1;
+  }
+  return obj->mVal.has_key(std::string{str, static_cast<SizeType>(size)});
+}
+
+// キーの反復子を返す．
+PyObject*
+object_iter(
+  PyObject* self
+)
+{
+  auto& val = PyJsonView::_get_ref(self);
+  auto type = &KeyIter_Type;
+  auto obj = type->tp_alloc(type, 0);
+  if ( obj == nullptr ) {
+    return nullptr;
+  }
+  auto iter_obj = reinterpret_cast<KeyIter_Object*>(obj);
+  new (&iter_obj->mRange) KeyRange(val.keys());
+  new (&iter_obj->mCur) KeyRange::iterator(iter_obj->mRange.begin());
+  return obj;
+}
+
+// richcompare 関数
+PyObject*
+object_richcompare(
+  PyObject* self,
+  PyObject* other,
+  int op
+)
+{
+  if ( op != Py_EQ && op != Py_NE ) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  auto& val = PyJsonView::_get_ref(self);
+  if ( PyJsonView::Check(other) ) {
+    return compare_result(val == PyJsonView::_get_ref(other), op);
+  }
+  if ( PyJsonValue::Check(other) ) {
+    return compare_result(val == PyJsonValue::_get_ref(other), op);
+  }
+  if ( !PyDict_Check(other) ) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  // dict とは Python の値として比較する．
+  if ( static_cast<Py_ssize_t>(val.size()) != PyDict_GET_SIZE(other) ) {
+    return compare_result(false, op);
+  }
+  Py_ssize_t pos = 0;
+  PyObject* key;
+  PyObject* other_item;
+  while ( PyDict_Next(other, &pos, &key, &other_item) ) {
+    auto stat = object_contains(self, key);
+    if ( stat < 0 ) {
+      return nullptr;
+    }
+    if ( stat == 0 ) {
+      return compare_result(false, op);
+    }
+    auto item = object_lookup(self, key);
+    if ( item == nullptr ) {
+      return nullptr;
+    }
+    Py_INCREF(other_item);
+    stat = PyObject_RichCompareBool(item, other_item, Py_EQ);
+    Py_DECREF(other_item);
+    Py_DECREF(item);
+    if ( stat < 0 ) {
+      return nullptr;
+    }
+    if ( stat == 0 ) {
+      return compare_result(false, op);
+    }
+  }
+  return compare_result(true, op);
+}
+
+// get key's value
+PyObject*
+object_get(
+  PyObject* self,
+  PyObject* args
+)
+{
+  PyObject* key = nullptr;
+  PyObject* default_obj = Py_None;
+  if ( !PyArg_ParseTuple(args, "O|O", &key, &default_obj) ) {
+    return nullptr;
+  }
+  auto item = object_lookup(self, key);
+  if ( item == nullptr && PyErr_ExceptionMatches(PyExc_KeyError) ) {
+    PyErr_Clear();
+    Py_INCREF(default_obj);
+    return default_obj;
+  }
+  return item;
+}
+
+// collections.abc の View クラスを作る．
+PyObject*
+abc_view(
+  PyObject* view_class,
+  PyObject* self
+)
+{
+  return PyObject_CallFunctionObjArgs(view_class, self, nullptr);
+}
+
+// get keys view
+PyObject*
+object_keys(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  return abc_view(KeysView_Class, self);
+}
+
+// get values view
+PyObject*
+object_values(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  return abc_view(ValuesView_Class, self);
+}
+
+// get items view
+PyObject*
+object_items(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  return abc_view(ItemsView_Class, self);
+}
+
+// Sequence オブジェクト構造体
+// in 演算子のためだけに用いる．
+PySequenceMethods object_sequence = {
+  .sq_contains = object_contains
+};
+
+// Mapping オブジェクト構造体
+PyMappingMethods object_mapping = {
+  .mp_length = object_length,
+  .mp_subscript = object_lookup
+};
+
+// メソッド定義
+PyMethodDef object_methods[] = {
+  {"get",
+   object_get,
+   METH_VARARGS,
+   PyDoc_STR("get key's value (or default if not found)")},
+  {"keys",
+   object_keys,
+   METH_NOARGS,
+   PyDoc_STR("get keys view")},
+  {"values",
+   object_values,
+   METH_NOARGS,
+   PyDoc_STR("get values view")},
+  {"items",
+   object_items,
+   METH_NOARGS,
+   PyDoc_STR("get items view")},
+  {"value",
+   value,
+   METH_NOARGS,
+   PyDoc_STR("get the original JsonValue")},
+  // end-marker
+  {nullptr, nullptr, 0, nullptr}
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// キーの反復子
+//////////////////////////////////////////////////////////////////////
+
+// 終了関数
+void
+key_iter_dealloc(
+  PyObject* self
+)
+{
+  auto obj = reinterpret_cast<KeyIter_Object*>(self);
+  obj->mRange.~KeyRange();
+  Py_TYPE(self)->tp_free(self);
+}
+
+// 次のキーを返す．
+PyObject*
+key_iter_next(
+  PyObject* self
+)
+{
+  auto obj = reinterpret_cast<KeyIter_Object*>(self);
+  if ( obj->mCur == obj->mRange.end() ) {
+    return nullptr;
+  }
+  auto key = *obj->mCur;
+  ++ obj->mCur;
+  return str_obj(key);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// JsonArrayView
+//////////////////////////////////////////////////////////////////////
+
+// 終了関数
+void
+array_dealloc(
+  PyObject* self
+)
+{
+  auto obj = reinterpret_cast<ArrayView_Object*>(self);
+  for ( auto item: obj->mCache ) {
+    Py_XDECREF(item);
+  }
+  obj->mCache.~vector();
+  obj->mVal.~JsonValue();
+  Py_TYPE(self)->tp_free(self);
+}
+
+Py_ssize_t
+array_length(
+  PyObject* self
+)
+{
+  auto& val = PyJsonView::_get_ref(self);
+  return val.size();
+}
+
+// 要素を返す．
+//
+// 返り値は新しい参照
+PyObject*
+array_item(
+  PyObject* self,
+  Py_ssize_t index
+)
+{
+  auto obj = reinterpret_cast<ArrayView_Object*>(self);
+  auto n = obj->mVal.size();
+  if ( index < 0 || index >= static_cast<Py_ssize_t>(n) ) {
+    PyErr_SetString(PyExc_IndexError, "index out of range");
+    return nullptr;
+  }
+  if ( obj->mCache.empty() ) {
+    obj->mCache.resize(n, nullptr);
+  }
+  auto item = obj->mCache[index];
+  if ( item == nullptr ) {
+    item = PyJsonView::ToPyObject(obj->mVal.at(index));
+    if ( item == nullptr ) {
+      return nullptr;
+    }
+    obj->mCache[index] = item;
+  }
+  Py_INCREF(item);
+  return item;
+}
+
+// 添字または slice で要素を返す．
+PyObject*
+array_subscript(
+  PyObject* self,
+  PyObject* key
+)
+{
+  auto n = array_length(self);
+  if ( PyIndex_Check(key) ) {
+    auto index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if ( index == -1 && PyErr_Occurred() ) {
+      return nullptr;
+    }
+    if ( index < 0 ) {
+      index += n;
+    }
+    return array_item(self, index);
+  }
+  if ( PySlice_Check(key) ) {
+    // slice の場合は要素のリストを返す．
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    Py_ssize_t step;
+    if ( PySlice_Unpack(key, &start, &stop, &step) < 0 ) {
+      return nullptr;
+    }
+    auto len = PySlice_AdjustIndices(n, &start, &stop, step);
+    auto ans = PyList_New(len);
+    if ( ans == nullptr ) {
+      return nullptr;
+    }
+    for ( Py_ssize_t i = 0; i < len; ++ i ) {
+      auto item = array_item(self, start + i * step);
+      if ( item == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      PyList_SET_ITEM(ans, i, item);
+    }
+    return ans;
+  }
+  PyErr_SetString(PyExc_TypeError, "indices must be integers or slices");
+  return nullptr;
+}
+
+// value と等しい要素を探す．
+//
+// 見つかったらその位置を，見つからなかったら -1 を返す．
+// エラーの場合は -2 を返す．
+Py_ssize_t
+array_find(
+  PyObject* self,
+  PyObject* value,
+  Py_ssize_t start = 0
+)
+{
+  auto n = array_length(self);
+  for ( Py_ssize_t i = start; i < n; ++ i ) {
+    auto item = array_item(self, i);
+    if ( item == nullptr ) {
+      return -2;
+    }
+    auto stat = PyObject_RichCompareBool(item, value, Py_EQ);
+    Py_DECREF(item);
+    if ( stat < 0 ) {
+      return -2;
+    }
+    if ( stat > 0 ) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int
+array_contains(
+  PyObject* self,
+  PyObject* value
+)
+{
+  auto pos = array_find(self, value);
+  if ( pos == -2 ) {
+    return -1;
+  }
+  return pos >= 0;
+}
+
+// richcompare 関数
+PyObject*
+array_richcompare(
+  PyObject* self,
+  PyObject* other,
+  int op
+)
+{
+  if ( op != Py_EQ && op != Py_NE ) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  auto& val = PyJsonView::_get_ref(self);
+  if ( PyJsonView::Check(other) ) {
+    return compare_result(val == PyJsonView::_get_ref(other), op);
+  }
+  if ( PyJsonValue::Check(other) ) {
+    return compare_result(val == PyJsonValue::_get_ref(other), op);
+  }
+  if ( !PyList_Check(other) ) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  // list とは Python の値として比較する．
+  auto n = array_length(self);
+  if ( n != PyList_GET_SIZE(other) ) {
+    return compare_result(false, op);
+  }
+  for ( Py_ssize_t i = 0; i < n && i < PyList_GET_SIZE(other); ++ i ) {
+    auto item = array_item(self, i);
+    if ( item == nullptr ) {
+      return nullptr;
+    }
+    auto other_item = PyList_GET_ITEM(other, i);
+    Py_INCREF(other_item);
+    auto stat = PyObject_RichCompareBool(item, other_item, Py_EQ);
+    Py_DECREF(other_item);
+    Py_DECREF(item);
+    if ( stat < 0 ) {
+      return nullptr;
+    }
+    if ( stat == 0 ) {
+      return compare_result(false, op);
+    }
+  }
+  return compare_result(true, op);
+}
+
+// return the first index of value
+PyObject*
+array_index(
+  PyObject* self,
+  PyObject* value
+)
+{
+  auto pos = array_find(self, value);
+  if ( pos == -2 ) {
+    return nullptr;
+  }
+  if ( pos == -1 ) {
+    PyErr_SetString(PyExc_ValueError, "value is not in JsonArrayView");
+    return nullptr;
+  }
+  return PyLong_FromSsize_t(pos);
+}
+
+// return number of occurrences of value
+PyObject*
+array_count(
+  PyObject* self,
+  PyObject* value
+)
+{
+  Py_ssize_t count = 0;
+  for ( Py_ssize_t pos = 0; ; ++ pos ) {
+    pos = array_find(self, value, pos);
+    if ( pos == -2 ) {
+      return nullptr;
+    }
+    if ( pos == -1 ) {
+      break;
+    }
+    ++ count;
+  }
+  return PyLong_FromSsize_t(count);
+}
+
+// Sequence オブジェクト構造体
+PySequenceMethods array_sequence = {
+  .sq_length = array_length,
+  .sq_item = array_item,
+  .sq_contains = array_contains
+};
+
+// Mapping オブジェクト構造体
+// 負の添字と slice のために用いる．
+PyMappingMethods array_mapping = {
+  .mp_length = array_length,
+  .mp_subscript = array_subscript
+};
+
+// メソッド定義
+PyMethodDef array_methods[] = {
+  {"index",
+   array_index,
+   METH_O,
+   PyDoc_STR("return the first index of value")},
+  {"count",
+   array_count,
+   METH_O,
+   PyDoc_STR("return number of occurrences of value")},
+  {"value",
+   value,
+   METH_NOARGS,
+   PyDoc_STR("get the original JsonValue")},
+  // end-marker
+  {nullptr, nullptr, 0, nullptr}
+};
+
+// collections.abc のクラスを取り出す．
+PyObject*
+abc_class(
+  PyObject* abc_module,
+  const char* name
+)
+{
+  return PyObject_GetAttrString(abc_module, name);
+}
+
+// collections.abc のクラスの仮想サブクラスとして登録する．
+bool
+abc_register(
+  PyObject* abc_module,
+  const char* name,
+  PyTypeObject* type
+)
+{
+  auto abc = abc_class(abc_module, name);
+  if ( abc == nullptr ) {
+    return false;
+  }
+  auto ans = PyObject_CallMethod(abc, "register", "O", type);
+  Py_DECREF(abc);
+  if ( ans == nullptr ) {
+    return false;
+  }
+  Py_DECREF(ans);
+  return true;
+}
+
+END_NONAMESPACE
+
+
+// @brief JsonObjectView, JsonArrayView オブジェクトを使用可能にする．
+bool
+PyJsonView::init(
+  PyObject* m
+)
+{
+  ObjectView_Type.tp_name = "JsonObjectView";
+  ObjectView_Type.tp_basicsize = sizeof(ObjectView_Object);
+  ObjectView_Type.tp_itemsize = 0;
+  ObjectView_Type.tp_dealloc = object_dealloc;
+  ObjectView_Type.tp_repr = repr_func;
+  ObjectView_Type.tp_as_sequence = &object_sequence;
+  ObjectView_Type.tp_as_mapping = &object_mapping;
+  ObjectView_Type.tp_hash = PyObject_HashNotImplemented;
+  ObjectView_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+#if PY_VERSION_HEX >= 0x030A0000
+  ObjectView_Type.tp_flags |= Py_TPFLAGS_MAPPING;
+#endif
+  ObjectView_Type.tp_doc = PyDoc_STR("lazy Mapping view of JsonValue");
+  ObjectView_Type.tp_richcompare = object_richcompare;
+  ObjectView_Type.tp_iter = object_iter;
+  ObjectView_Type.tp_methods = object_methods;
+
+  ArrayView_Type.tp_name = "JsonArrayView";
+  ArrayView_Type.tp_basicsize = sizeof(ArrayView_Object);
+  ArrayView_Type.tp_itemsize = 0;
+  ArrayView_Type.tp_dealloc = array_dealloc;
+  ArrayView_Type.tp_repr = repr_func;
+  ArrayView_Type.tp_as_sequence = &array_sequence;
+  ArrayView_Type.tp_as_mapping = &array_mapping;
+  ArrayView_Type.tp_hash = PyObject_HashNotImplemented;
+  ArrayView_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+#if PY_VERSION_HEX >= 0x030A0000
+  ArrayView_Type.tp_flags |= Py_TPFLAGS_SEQUENCE;
+#endif
+  ArrayView_Type.tp_doc = PyDoc_STR("lazy Sequence view of JsonValue");
+  ArrayView_Type.tp_richcompare = array_richcompare;
+  ArrayView_Type.tp_methods = array_methods;
+
+  KeyIter_Type.tp_name = "JsonObjectView.KeyIterator";
+  KeyIter_Type.tp_basicsize = sizeof(KeyIter_Object);
+  KeyIter_Type.tp_itemsize = 0;
+  KeyIter_Type.tp_dealloc = key_iter_dealloc;
+  KeyIter_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+  KeyIter_Type.tp_iter = PyObject_SelfIter;
+  KeyIter_Type.tp_iternext = key_iter_next;
+
+  if ( !PyModule::reg_type(m, "JsonObjectView", &ObjectView_Type) ) {
+    return false;
+  }
+  if ( !PyModule::reg_type(m, "JsonArrayView", &ArrayView_Type) ) {
+    return false;
+  }
+  if ( PyType_Ready(&KeyIter_Type) < 0 ) {
+    return false;
+  }
+
+  // collections.abc.Mapping, Sequence として振る舞うように登録する．
+  auto abc_module = PyImport_ImportModule("collections.abc");
+  if ( abc_module == nullptr ) {
+    return false;
+  }
+  bool ok = abc_register(abc_module, "Mapping", &ObjectView_Type) &&
+    abc_register(abc_module, "Sequence", &ArrayView_Type);
+  if ( ok ) {
+    KeysView_Class = abc_class(abc_module, "KeysView");
+    ValuesView_Class = abc_class(abc_module, "ValuesView");
+    ItemsView_Class = abc_class(abc_module, "ItemsView");
+    ok = KeysView_Class != nullptr &&
+      ValuesView_Class != nullptr &&
+      ItemsView_Class != nullptr;
+  }
+  Py_DECREF(abc_module);
+  return ok;
+}
+
+// @brief JsonValue を表すビューを作る．
+PyObject*
+PyJsonView::ToPyObject(
+  const ElemType& val
+)
+{
+  if ( val.is_null() ) {
+    Py_RETURN_NONE;
+  }
+  if ( val.is_bool() ) {
+    return PyBool_FromLong(val.get_bool());
+  }
+  if ( val.is_int() ) {
+    return PyLong_FromLongLong(val.get_int());
+  }
+  if ( val.is_float() ) {
+    return PyFloat_FromDouble(val.get_float());
+  }
+  if ( val.is_string() ) {
+    return str_obj(val.get_string_view());
+  }
+  if ( val.is_object() ) {
+    auto type = &ObjectView_Type;
+    auto obj = type->tp_alloc(type, 0);
+    if ( obj == nullptr ) {
+      return nullptr;
+    }
+    auto view_obj = reinterpret_cast<ObjectView_Object*>(obj);
+    new (&view_obj->mVal) JsonValue(val);
+    view_obj->mCache = nullptr;
+    return obj;
+  }
+  auto type = &ArrayView_Type;
+  auto obj = type->tp_alloc(type, 0);
+  if ( obj == nullptr ) {
+    return nullptr;
+  }
+  auto view_obj = reinterpret_cast<ArrayView_Object*>(obj);
+  new (&view_obj->mVal) JsonValue(val);
+  new (&view_obj->mCache) std::vector<PyObject*>();
+  return obj;
+}
+
+// @brief PyObject が JsonObjectView か JsonArrayView タイプか調べる．
+bool
+PyJsonView::Check(
+  PyObject* obj
+)
+{
+  return Py_IS_TYPE(obj, &ObjectView_Type) || Py_IS_TYPE(obj, &ArrayView_Type);
+}
+
+// @brief ビューを表す PyObject から JsonValue を取り出す．
+const JsonValue&
+PyJsonView::_get_ref(
+  PyObject* obj
+)
+{
+  if ( Py_IS_TYPE(obj, &ObjectView_Type) ) {
+    return reinterpret_cast<ObjectView_Object*>(obj)->mVal;
+  }
+  return reinterpret_cast<ArrayView_Object*>(obj)->mVal;
+}
+
+END_NAMESPACE_YM
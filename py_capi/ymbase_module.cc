@@ -11,6 +11,7 @@
 
 #include "pym/PyMt19937.h"
 #include "pym/PyJsonValue.h"
+#include "pym/PyJsonView.h"
 #include "pym/PyModule.h"
 
 
@@ -49,6 +50,9 @@ PyInit_ymbase()
   if ( !PyJsonValue::init(m) ) {
     goto error;
   }
+  if ( !PyJsonView::init(m) ) {
+    goto error;
+  }
 
   return m;
 
@@ -7,6 +7,9 @@
 :copyright: Copyright (C) 2025 Yusuke Matsunaga, All rights reserved.
 """
 
+import collections.abc
+import json
+import threading
 import pytest
 from ymbase import JsonValue
 
@@ -177,7 +180,7 @@ def test_string_dq():
     assert js_obj.get_string() == value
 
     js_str = str(js_obj)
-    assert js_str == "'" + value + "'"
+    assert js_str == '"\\"abcde\\""'
 
     js_obj2 = JsonValue.parse(js_str)
     assert js_obj2 == js_obj
@@ -255,6 +258,15 @@ def test_integer():
     js_obj3 = JsonValue(value)
     assert js_obj == js_obj3
 
+def test_int64():
+    value = 1234567890123456789
+    js_obj = JsonValue(value)
+
+    assert js_obj.is_int()
+    assert js_obj.get_int() == value
+    assert str(js_obj) == f'{value}'
+    assert JsonValue.parse(f'[{-value}]')[0].get_int() == -value
+
 def test_float():
     value = 1.2345
     js_obj = JsonValue(value)
@@ -385,3 +397,125 @@ def test_object1():
 
 def test_object2():
     js_obj = JsonValue({"key1": "value1"})
+
+def test_to_python():
+    json_str = ('{"a": [1, 2.5, "x", true, false, null],'
+                ' "b": {"c": {}, "d": []},'
+                ' "e": [{"k": 1, "v": "\\u3042"}, {"k": 2, "v": "\\ud83d\\ude00"}]}')
+    js_obj = JsonValue.parse(json_str)
+    py_obj = js_obj.to_python()
+    assert py_obj == json.loads(json_str)
+    assert type(py_obj["a"][0]) is int
+    assert type(py_obj["a"][1]) is float
+    assert py_obj["a"][5] is None
+
+    # 同じ形のオブジェクトが並んだ大きな配列
+    json_str2 = json.dumps([{"id": i, "x": i * 0.5, "tag": f"t{i}"}
+                            for i in range(100)])
+    assert JsonValue.parse(json_str2).to_python() == json.loads(json_str2)
+
+    assert JsonValue(3).to_python() == 3
+    assert JsonValue("abc").to_python() == "abc"
+    assert JsonValue().to_python() is None
+
+def test_from_python():
+    py_obj = {"a": [1, 2.5, "x", True, False, None],
+              "b": {"c": {}, "d": ()},
+              "e": [{"k": 1, "v": "あ"}]}
+    js_obj = JsonValue(py_obj)
+    assert js_obj == JsonValue.parse(json.dumps(py_obj))
+    assert js_obj.to_python() == json.loads(json.dumps(py_obj))
+
+    # dict の順番を保つ．
+    py_obj2 = {"b": 1, "a": 2, "c": {"z": 3, "y": 4}}
+    js_obj2 = JsonValue(py_obj2)
+    assert str(js_obj2) == json.dumps(py_obj2, separators=(",", ":"))
+    assert list(js_obj2.to_python()) == ["b", "a", "c"]
+    assert list(js_obj2.to_python()["c"]) == ["z", "y"]
+
+    with pytest.raises(Exception) as e:
+        JsonValue({1: "a"})
+    assert e.type == ValueError
+
+    # 循環参照
+    cyc = []
+    cyc.append(cyc)
+    with pytest.raises(Exception) as e:
+        JsonValue(cyc)
+    assert e.type == ValueError
+
+def test_item_list():
+    js_obj = JsonValue.parse('{"a": 1, "b": [2]}')
+    item_list = js_obj.item_list
+    assert item_list == [("a", JsonValue(1)), ("b", JsonValue([2]))]
+
+def test_read_write(tmp_path):
+    js_obj = JsonValue.parse('{"a": [1, 2, {"b": "c"}]}')
+    filename = str(tmp_path / "test.json")
+    js_obj.write(filename, indent=True)
+    assert JsonValue.read(filename) == js_obj
+
+    with pytest.raises(Exception) as e:
+        JsonValue.read(str(tmp_path / "no_such_file.json"))
+    assert e.type == ValueError
+
+def test_threads():
+    # 読み込み中は GIL を解放するので複数のスレッドから呼び出せる．
+    json_str = json.dumps([{"id": i, "name": f"n{i}"} for i in range(10000)])
+    result = [None] * 4
+    def work(i):
+        result[i] = JsonValue.parse(json_str)
+    threads = [threading.Thread(target=work, args=(i,)) for i in range(4)]
+    for th in threads:
+        th.start()
+    for th in threads:
+        th.join()
+    for js_obj in result:
+        assert len(js_obj) == 10000
+        assert js_obj[9999]["name"].get_string() == "n9999"
+
+def test_view():
+    json_str = '{"a": [1, 2.5, "x", true, null, {"b": "c"}], "d": {"e": 1}, "f": "あ"}'
+    js_obj = JsonValue.parse(json_str)
+    view = js_obj.view()
+    assert isinstance(view, collections.abc.Mapping)
+    assert len(view) == 3
+    assert "a" in view
+    assert "z" not in view
+    assert 1 not in view
+    assert list(view) == ["a", "d", "f"]
+    assert view["f"] == "あ"
+    assert view.get("z") is None
+    assert view.get("z", 3) == 3
+    with pytest.raises(KeyError):
+        view["z"]
+
+    # 同じキーは同じオブジェクトを返す．
+    assert view["d"] is view["d"]
+    assert view["d"]["e"] == 1
+
+    arr = view["a"]
+    assert isinstance(arr, collections.abc.Sequence)
+    assert len(arr) == 6
+    assert list(arr) == [1, 2.5, "x", True, None, {"b": "c"}]
+    assert arr[-1] is arr[5]
+    assert arr[1:4] == [2.5, "x", True]
+    assert arr[::-2] == [{"b": "c"}, True, 2.5]
+    assert 2.5 in arr
+    assert "y" not in arr
+    assert arr.index("x") == 2
+    assert arr.count(None) == 1
+    assert list(reversed(arr))[0] == {"b": "c"}
+    with pytest.raises(IndexError):
+        arr[6]
+
+    assert sorted(view.keys()) == ["a", "d", "f"]
+    assert ("f", "あ") in view.items()
+    assert dict(view)["f"] == "あ"
+    assert view == json.loads(json_str)
+    assert view.value() == js_obj
+    assert JsonValue(view) == js_obj
+    assert JsonValue(3).view() == 3
+
+    # JsonValue の要素も最後まで反復できる．
+    assert len([x for x in JsonValue.parse("[1, 2, 3]")]) == 3
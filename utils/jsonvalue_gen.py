@@ -22,6 +22,274 @@ class JsonValueArg(ObjConvArg):
                          cvardefault=None,
                          pyclassname='PyJsonValue')
 
+# GIL を解放して関数を実行するテンプレート関数
+CALL_WITHOUT_GIL_CODE = '''
+// GIL を解放して func を実行する．
+//
+// 他のスレッドが Python のコードを実行できるように
+// 時間のかかる読み込みや書き出しはこの中で行う．
+// func の中で Python の API を呼んではいけない．
+// std::invalid_argument 例外が送出された場合は ValueError を設定して
+// false を返す．
+template<class Func>
+bool
+call_without_gil(
+  Func func
+)
+{
+  std::string err_msg;
+  bool ok = true;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    func();
+  }
+  catch ( std::invalid_argument err ) {
+    err_msg = err.what();
+    ok = false;
+  }
+  Py_END_ALLOW_THREADS
+  if ( !ok ) {
+    std::ostringstream buf;
+    buf << "invalid argument" << ": " << err_msg;
+    PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+  }
+  return ok;
+}
+'''
+
+# JsonValue を Python の組み込み型に変換するクラス
+TO_PYTHON_CODE = '''
+// JsonValue を Python の組み込み型のオブジェクトに変換するクラス
+//
+// 要素は JsonValueRef でたどるので参照回数の操作は行わない．
+// オブジェクトのキーは同じ内容のものが一つの str オブジェクトを共有する．
+class ToPython
+{
+public:
+
+  // デストラクタ
+  ~ToPython()
+  {
+    for ( auto& p: mKeyDict ) {
+      Py_DECREF(p.second);
+    }
+  }
+
+  // val を変換する．
+  // エラーの場合は例外を設定して nullptr を返す．
+  static
+  PyObject*
+  convert(
+    const JsonValue& val
+  )
+  {
+    // 結果は循環参照を含まないので，大量のオブジェクトを作る間に
+    // 循環参照の検出が何度も走らないように止めておく．
+#if PY_VERSION_HEX >= 0x030A0000
+    auto gc_enabled = PyGC_Disable();
+#endif
+    PyObject* ans = nullptr;
+    try {
+      ToPython conv;
+      ans = conv(JsonValueRef{val});
+    }
+    catch ( std::invalid_argument err ) {
+      std::ostringstream buf;
+      buf << "invalid argument" << ": " << err.what();
+      PyErr_SetString(PyExc_ValueError, buf.str().c_str());
+    }
+#if PY_VERSION_HEX >= 0x030A0000
+    if ( gc_enabled ) {
+      PyGC_Enable();
+    }
+#endif
+    return ans;
+  }
+
+  // 変換する．
+  // エラーの場合は nullptr を返す．
+  PyObject*
+  operator()(
+    JsonValueRef val
+  )
+  {
+    if ( val.is_null() ) {
+      Py_RETURN_NONE;
+    }
+    if ( val.is_bool() ) {
+      return PyBool_FromLong(val.get_bool());
+    }
+    if ( val.is_int() ) {
+      return PyLong_FromLongLong(val.get_int());
+    }
+    if ( val.is_float() ) {
+      return PyFloat_FromDouble(val.get_float());
+    }
+    if ( val.is_string() ) {
+      return str_obj(val.get_string_view());
+    }
+    if ( Py_EnterRecursiveCall(" while converting JsonValue") ) {
+      return nullptr;
+    }
+    auto ans = val.is_array() ? list_obj(val) : dict_obj(val);
+    Py_LeaveRecursiveCall();
+    return ans;
+  }
+
+  // 文字列を str オブジェクトに変換する．
+  static
+  PyObject*
+  str_obj(
+    std::string_view str
+  )
+  {
+    // 対になっていないサロゲートは json モジュールと同様にそのまま通す．
+    return PyUnicode_DecodeUTF8(str.data(), str.size(), "surrogatepass");
+  }
+
+
+private:
+
+  // 配列を list オブジェクトに変換する．
+  PyObject*
+  list_obj(
+    JsonValueRef val
+  )
+  {
+    auto ans = PyList_New(val.size());
+    if ( ans == nullptr ) {
+      return nullptr;
+    }
+    SizeType i = 0;
+    for ( auto elem: val.elements() ) {
+      auto elem_obj = operator()(elem);
+      if ( elem_obj == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      PyList_SET_ITEM(ans, i, elem_obj);
+      ++ i;
+    }
+    return ans;
+  }
+
+  // オブジェクトを dict オブジェクトに変換する．
+  PyObject*
+  dict_obj(
+    JsonValueRef val
+  )
+  {
+    auto ans = PyDict_New();
+    if ( ans == nullptr ) {
+      return nullptr;
+    }
+    for ( auto item: val.items() ) {
+      auto key_obj = key(item.first);
+      auto value_obj = key_obj != nullptr ? operator()(item.second) : nullptr;
+      if ( value_obj == nullptr ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+      auto stat = PyDict_SetItem(ans, key_obj, value_obj);
+      Py_DECREF(value_obj);
+      if ( stat < 0 ) {
+        Py_DECREF(ans);
+        return nullptr;
+      }
+    }
+    return ans;
+  }
+
+  // キーを表す str オブジェクトを返す．
+  //
+  // 返り値は借用参照
+  PyObject*
+  key(
+    std::string_view key
+  )
+  {
+    auto p = mKeyDict.find(key);
+    if ( p != mKeyDict.end() ) {
+      return p->second;
+    }
+    auto obj = str_obj(key);
+    if ( obj != nullptr ) {
+      mKeyDict.emplace(key, obj);
+    }
+    return obj;
+  }
+
+  // キーの辞書
+  // キーの文字列の実体は変換元の JsonValue が保持している．
+  std::unordered_map<std::string_view, PyObject*> mKeyDict;
+
+};
+'''
+
+# 組み込みの dict, list, tuple を JsonValue に変換する関数
+FROM_PYTHON_CODE = '''
+// 組み込みの dict, list, tuple を JsonValue に変換する．
+//
+// 中間のオブジェクトを作らずに直接要素をたどる．
+// 変換できなかった場合は false を返す．
+bool
+from_python_container(
+  PyObject* obj,
+  JsonValue& val
+)
+{
+  if ( Py_EnterRecursiveCall(" while converting to JsonValue") ) {
+    PyErr_Clear();
+    return false;
+  }
+  bool ok = true;
+  if ( PyDict_Check(obj) ) {
+    // "辞書型"
+    // dict の順番を保つためにキーと値の対のリストで作る．
+    std::vector<std::pair<std::string, JsonValue>> val1;
+    val1.reserve(PyDict_GET_SIZE(obj));
+    Py_ssize_t pos = 0;
+    PyObject* key_obj;
+    PyObject* value_obj;
+    while ( ok && PyDict_Next(obj, &pos, &key_obj, &value_obj) ) {
+      Py_ssize_t size;
+      auto key = PyUnicode_Check(key_obj) ? PyUnicode_AsUTF8AndSize(key_obj, &size) : nullptr;
+      JsonValue value;
+      ok = key != nullptr && PyJsonValue::FromPyObject(value_obj, value);
+      if ( ok ) {
+        val1.emplace_back(std::string(key, size), std::move(value));
+      }
+    }
+    if ( ok ) {
+      val = JsonValue(std::move(val1));
+    }
+  }
+  else {
+    // "シーケンス(リスト)型"
+    auto n = PySequence_Fast_GET_SIZE(obj);
+    auto item_array = PySequence_Fast_ITEMS(obj);
+    std::vector<JsonValue> val1(n);
+    for ( Py_ssize_t i = 0; ok && i < n; ++ i ) {
+      ok = PyJsonValue::FromPyObject(item_array[i], val1[i]);
+    }
+    if ( ok ) {
+      val = JsonValue(std::move(val1));
+    }
+  }
+  Py_LeaveRecursiveCall();
+  PyErr_Clear();
+  return ok;
+}
+'''
+
+def gen_raw_code(writer, code):
+    """C++ のコードをそのまま出力する．"""
+    for line in code.splitlines():
+        if line == '':
+            writer.gen_CRLF()
+        else:
+            writer.write_line(line)
+
 def gen_preamble(writer):
     writer.gen_CRLF()
     writer.gen_comment('エラーメッセージを表す定数')
@@ -33,9 +301,16 @@ def gen_preamble(writer):
     writer.write_line('static const char* EMSG_NOT_BOOL = "not a bool type";')
     writer.write_line('static const char* EMSG_NOT_OBJ_ARRAY = "neither an object nor an array type";')
     writer.write_line('static const char* EMSG_OUT_OF_RANGE = "index is out-of-range";')
+    gen_raw_code(writer, CALL_WITHOUT_GIL_CODE)
+    gen_raw_code(writer, TO_PYTHON_CODE)
+    gen_raw_code(writer, FROM_PYTHON_CODE)
 
 def repr_func(writer):
-    writer.gen_return_py_string('val.to_json()')
+    writer.gen_vardecl(typename='std::string',
+                       varname='json_str')
+    with writer.gen_if_block('!call_without_gil([&]() { json_str = val.to_json(); })'):
+        writer.gen_return('nullptr')
+    writer.gen_return_py_string('json_str')
 
 def gen_null(writer):
     writer.gen_return_pyobject('PyJsonValue', 'JsonValue::null()')
@@ -84,7 +359,7 @@ def gen_get_int(writer):
     with writer.gen_if_block('!val.is_int()'):
         writer.gen_type_error('EMSG_NOT_INT')
     writer.gen_auto_assign('ans', 'val.get_int()')
-    writer.gen_return_py_int('ans')
+    writer.gen_return('PyLong_FromLongLong(ans)')
 
 def gen_get_float(writer):
     with writer.gen_if_block('!val.is_float()'):
@@ -99,27 +374,35 @@ def gen_get_bool(writer):
     writer.gen_return_py_bool('ans')
 
 def gen_write(writer):
-    writer.gen_vardecl(typename='std::ofstream',
-                       varname='s')
+    writer.write_line('std::ofstream s{filename};')
     with writer.gen_if_block('!s'):
         writer.gen_vardecl(typename='std::ostringstream',
                            varname='buff')
         writer.write_line('buff << filename << ": Could not open.";')
         writer.gen_value_error('buff.str().c_str()')
-        writer.write_line('val.write(s, indent);')
+    with writer.gen_if_block('!call_without_gil([&]() { val.write(s, indent); })'):
+        writer.gen_return('nullptr')
     writer.gen_return_py_none()
 
 def gen_parse(writer):
-    with writer.gen_try_block():
-        writer.gen_auto_assign('val', 'JsonValue::parse(json_str)')
-        writer.gen_return_pyobject('PyJsonValue', 'val')
-    writer.gen_catch_invalid_argument()
+    writer.gen_vardecl(typename='JsonValue',
+                       varname='val')
+    with writer.gen_if_block('!call_without_gil([&]() { val = JsonValue::parse(json_str); })'):
+        writer.gen_return('nullptr')
+    writer.gen_return_pyobject('PyJsonValue', 'val')
 
 def gen_read(writer):
-    with writer.gen_try_block():
-        writer.gen_auto_assign('val', 'JsonValue::read(filename)')
-        writer.gen_return_pyobject('PyJsonValue', 'val')
-    writer.gen_catch_invalid_argument()
+    writer.gen_vardecl(typename='JsonValue',
+                       varname='val')
+    with writer.gen_if_block('!call_without_gil([&]() { val = JsonValue::read(filename); })'):
+        writer.gen_return('nullptr')
+    writer.gen_return_pyobject('PyJsonValue', 'val')
+
+def gen_to_python(writer):
+    writer.gen_return('ToPython::convert(val)')
+
+def gen_view(writer):
+    writer.gen_return('PyJsonView::ToPyObject(val)')
 
 def gen_sq_length(writer):
     with writer.gen_if_block('!val.is_object() && !val.is_array()'):
@@ -130,10 +413,12 @@ def gen_sq_length(writer):
 def gen_sq_item(writer):
     with writer.gen_if_block('!val.is_array()'):
         writer.gen_type_error('EMSG_NOT_ARRAY')
-    with writer.gen_try_block():
-        writer.gen_auto_assign('index1', '( index >= 0 ) ? index : val.size() + index')
-        writer.gen_return_pyobject('PyJsonValue', 'val.at(index1)')
-    writer.gen_catch_invalid_argument()
+    writer.gen_auto_assign('index1', '( index >= 0 ) ? index : val.size() + index')
+    with writer.gen_if_block('index1 >= val.size()'):
+        writer.gen_comment('for 文での反復を終わらせるために IndexError とする．')
+        writer.write_line('PyErr_SetString(PyExc_IndexError, EMSG_OUT_OF_RANGE);')
+        writer.gen_return('nullptr')
+    writer.gen_return_pyobject('PyJsonValue', 'val.at(index1)')
 
 def gen_mp_subscript(writer):
     with writer.gen_if_block('PyString::Check(key)'):
@@ -165,17 +450,21 @@ def item_list_gen(writer):
     with writer.gen_if_block('!val.is_object()'):
         writer.gen_type_error('EMSG_NOT_OBJ')
     with writer.gen_try_block():
-        writer.gen_auto_assign('item_list', 'val.item_list()')
-        writer.gen_auto_assign('n', 'item_list.size()')
-        writer.gen_auto_assign('ans', 'PyList_New(n)')
-        with writer.gen_for_block('SizeType i = 0',
-                                'i < n',
-                                '++ i'):
-            writer.gen_assign('auto& p', 'item_list[i]')
-            writer.gen_auto_assign('key', 'p.first')
-            writer.gen_auto_assign('value', 'p.second')
-            writer.gen_auto_assign('value_obj', 'PyJsonValue::ToPyObject(value)')
-            writer.gen_auto_assign('item_obj', 'Py_BuildValue("sO", key.c_str(), value_obj)')
+        writer.gen_comment('キーはコピーせずに直接 str オブジェクトにする．')
+        writer.gen_auto_assign('items', 'val.items()')
+        writer.gen_auto_assign('ans', 'PyList_New(items.size())')
+        writer.gen_assign('SizeType i', '0')
+        with writer.gen_for_block('auto p = items.begin()',
+                                  'p != items.end()',
+                                  '++ p, ++ i'):
+            writer.gen_auto_assign('item', '*p')
+            writer.gen_auto_assign('key_obj', 'ToPython::str_obj(item.first)')
+            with writer.gen_if_block('key_obj == nullptr'):
+                writer.write_line('Py_DECREF(ans);')
+                writer.gen_return('nullptr')
+            writer.gen_auto_assign('item_obj', 'PyTuple_New(2)')
+            writer.write_line('PyTuple_SET_ITEM(item_obj, 0, key_obj);')
+            writer.write_line('PyTuple_SET_ITEM(item_obj, 1, PyJsonValue::ToPyObject(item.second));')
             writer.write_line('PyList_SET_ITEM(ans, i, item_obj);')
         writer.gen_return('ans')
     writer.gen_catch_invalid_argument()
@@ -193,12 +482,14 @@ class JsonValueGen(PyObjGen):
                          header_include_files=['ym_config.h',
                                                'ym/JsonValue.h'],
                          source_include_files=['pym/PyJsonValue.h',
+                                               'pym/PyJsonView.h',
                                                'pym/PyString.h',
                                                'pym/PyInt.h',
                                                'pym/PyFloat.h',
                                                'pym/PyDict.h',
                                                'pym/PyList.h',
-                                               'ym/JsonValue.h'])
+                                               'ym/JsonValue.h',
+                                               'ym/JsonValueRef.h'])
 
         self.add_preamble(gen_preamble)
 
@@ -281,7 +572,13 @@ class JsonValueGen(PyObjGen):
                                arg_list=[StringArg(name='filename',
                                                    cvarname='filename')],
                                func_body=gen_read,
-               doc_str='read JSON data from file')
+                               doc_str='read JSON data from file')
+        self.add_method('to_python',
+                        func_body=gen_to_python,
+                        doc_str='convert to Python object')
+        self.add_method('view',
+                        func_body=gen_view,
+                        doc_str='make lazy Mapping/Sequence view')
 
         self.add_sequence(sq_length=gen_sq_length,
                           sq_item=gen_sq_item)
@@ -308,20 +605,51 @@ class JsonValueGen(PyObjGen):
 
         def deconv_gen(writer):
             # PyObject* の特殊な値の場合の処理
-            val_map_list = [('nullptr', 'JsonValue::null()', '"null オブジェクト"'),
-                            ('Py_True', 'JsonValue(true)', '"true オブジェクト"'),
-                            ('Py_False', 'JsonValue(false)', '"false オブジェクト"')]
-            for obj_val, val, comment in val_map_list:
-                with writer.gen_if_block(f'obj == {obj_val}'):
+            val_map_list = [('obj == nullptr || obj == Py_None',
+                             'JsonValue::null()', '"null オブジェクト"'),
+                            ('obj == Py_True', 'JsonValue(true)', '"true オブジェクト"'),
+                            ('obj == Py_False', 'JsonValue(false)', '"false オブジェクト"')]
+            for cond, val, comment in val_map_list:
+                with writer.gen_if_block(cond):
                     writer.gen_comment(comment)
                     writer.gen_assign('val', val)
                     writer.gen_return('true')
             # PyJsonValue の変換
             self.gen_raw_conv(writer)
+            # ビューは元の JsonValue を取り出す．
+            with writer.gen_if_block('PyJsonView::Check(obj)'):
+                writer.gen_assign('val', 'PyJsonView::_get_ref(obj)')
+                writer.gen_return('true')
+            # 文字列は UTF-8 の内容を直接取り出す．
+            with writer.gen_if_block('PyUnicode_Check(obj)'):
+                writer.gen_comment('"文字列型"')
+                writer.gen_vardecl(typename='Py_ssize_t',
+                                   varname='size')
+                writer.gen_auto_assign('str', 'PyUnicode_AsUTF8AndSize(obj, &size)')
+                with writer.gen_if_block('str == nullptr'):
+                    writer.write_line('PyErr_Clear();')
+                    writer.gen_return('false')
+                writer.gen_assign('val', 'JsonValue(std::string(str, size))')
+                writer.gen_return('true')
+            # 整数は64ビットで変換する．
+            with writer.gen_if_block('PyLong_Check(obj)'):
+                writer.gen_vardecl(typename='int',
+                                   varname='overflow')
+                writer.gen_auto_assign('val1',
+                                       'PyLong_AsLongLongAndOverflow(obj, &overflow)')
+                with writer.gen_if_block('overflow == 0'):
+                    writer.gen_comment('"整数型"')
+                    writer.gen_assign('val', 'JsonValue(static_cast<std::int64_t>(val1))')
+                    writer.gen_return('true')
+            with writer.gen_if_block('PyFloat_Check(obj)'):
+                writer.gen_comment('"浮動小数点型"')
+                writer.gen_assign('val', 'JsonValue(PyFloat_AS_DOUBLE(obj))')
+                writer.gen_return('true')
+            # 組み込みの dict, list, tuple は中間のオブジェクトを作らない．
+            with writer.gen_if_block('PyDict_Check(obj) || PyList_Check(obj) || PyTuple_Check(obj)'):
+                writer.gen_return('from_python_container(obj, val)')
             # PyObject* の拡張型に対する処理
-            pytype_list = [('PyString', 'std::string', '"文字列型"'),
-                           ('PyInt', 'int', '"整数型"'),
-                           ('PyFloat', 'double', '"浮動小数点型"'),
+            pytype_list = [('PyFloat', 'double', '"浮動小数点型"'),
                            ('PyDict<JsonValue, PyJsonValue>',
                             'std::unordered_map<std::string, JsonValue>',
                             '"辞書型"'),
@@ -0,0 +1,36 @@
+#! /usr/bin/env python3
+
+"""JsonViewGen の定義ファイル
+
+:file: jsonview_gen.py
+:author: Yusuke Matsunaga (松永 裕介)
+:copyright: Copyright (C) 2026 Yusuke Matsunaga, All rights reserved.
+"""
+
+from mk_py_capi import PyObjGen
+
+
+class JsonViewGen(PyObjGen):
+    """JsonObjectView, JsonArrayView をモジュールに登録するためのクラス
+
+    PyJsonView.h, PyJsonView.cc は Mapping/Sequence のスロットや
+    反復子の型を持つので手で書いている．
+    そのためファイルは生成せず，モジュールの初期化関数から
+    PyJsonView::init() を呼ぶためだけに用いる．
+    """
+
+    def __init__(self):
+        super().__init__(classname='JsonView',
+                         namespace='YM',
+                         pyname='JsonView',
+                         header_include_files=['ym_config.h',
+                                               'ym/JsonValue.h'],
+                         source_include_files=['pym/PyJsonView.h'])
+
+    def make_header(self, *args, **kwargs):
+        """ヘッダファイルは手書きなので生成しない．"""
+        pass
+
+    def make_source(self, *args, **kwargs):
+        """ソースファイルは手書きなので生成しない．"""
+        pass
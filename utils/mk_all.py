@@ -46,7 +46,10 @@ mt19937_gen = Mt19937Gen()
 from jsonvalue_gen import JsonValueGen
 jsonvalue_gen = JsonValueGen()
 
-gen_list = [mt19937_gen, jsonvalue_gen]
+from jsonview_gen import JsonViewGen
+jsonview_gen = JsonViewGen()
+
+gen_list = [mt19937_gen, jsonvalue_gen, jsonview_gen]
 
 from mk_py_capi import ModuleGen
 module_gen = ModuleGen(modulename='ymbase',